@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "console.h"
 #include "CommandManager.h"
 #include <FECore/log.h>
+#include <FECore/FEProfiler.h>
 #include "console.h"
 #include "breakpoint.h"
 #include <FEBioLib/febio.h>
@@ -176,9 +177,18 @@ int FEBioApp::RunModel()
 	// solve the model with the task and control file
 	if (nret == 0)
 	{
+		if (m_ops.bprofile) FEProfiler::Enable(true);
+
 		bool bret = febio::SolveModel(fem, m_ops.sztask, m_ops.szctrl);
 
 		nret = (bret ? 0 : 1);
+
+		// write the profiler report
+		if (m_ops.bprofile)
+		{
+			FEProfiler::Enable(false);
+			WriteProfile();
+		}
 	}
 
 	// reset the current model pointer
@@ -187,6 +197,20 @@ int FEBioApp::RunModel()
 	return nret;
 }
 
+//-----------------------------------------------------------------------------
+// write the profiler report as a JSON file and as a folded stack file for flame graphs
+void FEBioApp::WriteProfile()
+{
+	const char* szbase = (m_ops.szprof[0] ? m_ops.szprof : "febio_profile");
+
+	char szfile[CMDOPTIONS::MAXFILE + 16];
+	sprintf(szfile, "%s.json", szbase);
+	if (FEProfiler::WriteJSON(szfile) == false) fprintf(stderr, "Failed writing profile %s\n", szfile);
+
+	sprintf(szfile, "%s.folded", szbase);
+	if (FEProfiler::WriteFlameGraph(szfile) == false) fprintf(stderr, "Failed writing profile %s\n", szfile);
+}
+
 //-----------------------------------------------------------------------------
 // apply configuration changes to model
 void FEBioApp::ApplyConfig(FEBioModel& fem)
@@ -227,12 +251,14 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 	ops.bsplash = true;
 	ops.bsilent = false;
 	ops.binteractive = true;
+	ops.bprofile = false;
 
 	// these flags indicate whether the corresponding file name
 	// was defined on the command line. Otherwise, a default name will be generated.
 	bool blog = false;
 	bool bplt = false;
 	bool bdmp = false;
+	bool bprof = false;
 	bool brun = true;
 
 	// initialize file names
@@ -243,6 +269,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 	ops.sztask[0] = 0;
 	ops.szctrl[0] = 0;
 	ops.szimp[0] = 0;
+	ops.szprof[0] = 0;
 
 	// set initial configuration file name
 	if (ops.szcnf[0] == 0)
@@ -394,6 +421,16 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		{
 			strcpy(ops.szimp, argv[++i]);
 		}
+		else if (strcmp(sz, "-profile") == 0)
+		{
+			ops.bprofile = true;
+			if ((i < nargs - 1) && (argv[i + 1][0] != '-'))
+			{
+				// assume this is the base name of the profiler output
+				strcpy(ops.szprof, argv[++i]);
+				bprof = true;
+			}
+		}
 		else if (sz[0] == '-')
 		{
 			fprintf(stderr, "FATAL ERROR: Invalid command line option.\n");
@@ -458,6 +495,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		if (!blog) sprintf(ops.szlog, "%s.log", szlogbase);
 		if (!bplt) sprintf(ops.szplt, "%s.xplt", szbase);
 		if (!bdmp) sprintf(ops.szdmp, "%s.dmp", szbase);
+		if (!bprof) sprintf(ops.szprof, "%s_profile", szlogbase);
 	}
 	else if (ops.szctrl[0])
 	{
@@ -469,6 +507,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		if (!blog) sprintf(ops.szlog, "%s.log", szbase);
 		if (!bplt) sprintf(ops.szplt, "%s.xplt", szbase);
 		if (!bdmp) sprintf(ops.szdmp, "%s.dmp", szbase);
+		if (!bprof) sprintf(ops.szprof, "%s_profile", szbase);
 	}
 
 	return brun;
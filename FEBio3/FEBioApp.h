@@ -68,6 +68,9 @@ protected:
 	// apply configuration changes to model
 	void ApplyConfig(FEBioModel& fem);
 
+	// write the profiler report
+	void WriteProfile();
+
 public:
 	static FEBioApp* GetInstance();
 
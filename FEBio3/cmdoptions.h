@@ -38,6 +38,7 @@ struct CMDOPTIONS
 	bool	bsplash;			//!< show splash screen or not
 	bool	bsilent;			//!< run FEBio in silent mode (no output to screen)
 	bool	binteractive;		//!< start FEBio interactively
+	bool	bprofile;			//!< run the profiler
 
 	int		dumpLevel;		//!< requested restart level
 
@@ -49,6 +50,7 @@ struct CMDOPTIONS
 	char	sztask[MAXFILE];	//!< task name
 	char	szctrl[MAXFILE];	//!< control file for tasks
 	char	szimp[MAXFILE];		//!< import file
+	char	szprof[MAXFILE];	//!< base name of profiler output files
 
 	CMDOPTIONS()
 	{
@@ -61,6 +63,7 @@ struct CMDOPTIONS
 		bsplash = true;
 		bsilent = false;
 		binteractive = false;
+		bprofile = false;
 		dumpLevel = 0;
 
 		szfile[0] = 0;
@@ -71,5 +74,6 @@ struct CMDOPTIONS
 		sztask[0] = 0;
 		szctrl[0] = 0;
 		szimp[0] = 0;
+		szprof[0] = 0;
 	}
 };
@@ -39,7 +39,7 @@ SOFTWARE.*/
 class FEPlotDisplacement : public FEPlotNodeData
 {
 public:
-    FEPlotDisplacement(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){}
+    FEPlotDisplacement(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){ SetThreadSafe(true); }
     bool Save(FEMesh& m, FEDataStream& a);
 };
 
@@ -63,14 +63,15 @@ size_t FEBIOLIB_API GetPeakMemory();	// in memory.cpp
 
 FEBioModel::FEPlotVariable::FEPlotVariable()
 {
-
+	m_nenc = 0;
 }
 
-FEBioModel::FEPlotVariable::FEPlotVariable(const std::string& varName, const std::vector<int>& itemList, const std::string& domainName)
+FEBioModel::FEPlotVariable::FEPlotVariable(const std::string& varName, const std::vector<int>& itemList, const std::string& domainName, int nenc)
 {
 	m_var = varName;
 	m_item = itemList;
 	m_domName = domainName;
+	m_nenc = nenc;
 }
 
 FEBioModel::FEPlotVariable::FEPlotVariable(const FEBioModel::FEPlotVariable& v)
@@ -78,6 +79,7 @@ FEBioModel::FEPlotVariable::FEPlotVariable(const FEBioModel::FEPlotVariable& v)
 	m_var = v.m_var;
 	m_item = v.m_item;
 	m_domName = v.m_domName;
+	m_nenc = v.m_nenc;
 }
 
 void FEBioModel::FEPlotVariable::operator = (const FEBioModel::FEPlotVariable& v)
@@ -85,6 +87,7 @@ void FEBioModel::FEPlotVariable::operator = (const FEBioModel::FEPlotVariable& v
 	m_var = v.m_var;
 	m_item = v.m_item;
 	m_domName = v.m_domName;
+	m_nenc = v.m_nenc;
 }
 
 void FEBioModel::FEPlotVariable::Serialize(DumpStream& ar)
@@ -139,6 +142,8 @@ FEBioModel::FEBioModel()
 	m_ntotalReforms = 0;
 
 	m_pltCompression = 0;
+	m_pltCodec = 0;
+	m_pltIndex = false;
 	m_pltAppendOnRestart = true;
 
 	// Add the output callback
@@ -354,6 +359,8 @@ bool FEBioModel::Input(const char* szfile)
 
 		// set compression
 		m_pltCompression = fim.m_nplot_compression;
+		m_pltCodec = fim.m_nplot_codec;
+		m_pltIndex = fim.m_bplot_index;
 
 		// define the plot file variables
 		FEModel& fem = *GetFEModel();
@@ -373,7 +380,7 @@ bool FEBioModel::Input(const char* szfile)
 				DomainListFromMaterial(lmat, item);
 			}
 
-			FEPlotVariable pltvar(var.m_szvar, item, var.m_szdom);
+			FEPlotVariable pltvar(var.m_szvar, item, var.m_szdom, var.m_nenc);
 			m_pltData.push_back(pltvar);
 		}
 	}
@@ -444,6 +451,12 @@ void FEBioModel::WriteLog(unsigned int nwhen)
 			feLog("\n L I N E A R   S O L V E R   S T A T S\n\n");
 			feLog("\tTotal calls to linear solver ........ : %d\n\n", nsolves);
 			feLog("\tAvg iterations per solve ............ : %lg\n\n", avgiters);
+			if (stats.factorizations > 0)
+			{
+				double pct = (100.0*stats.symbolic_reuse) / stats.factorizations;
+				feLog("\tTotal factorizations ................ : %d\n\n", stats.factorizations);
+				feLog("\tReused symbolic factorizations ...... : %d (%lg%%)\n\n", stats.symbolic_reuse, pct);
+			}
 		}
 
 		// add to stats
@@ -524,7 +537,12 @@ void FEBioModel::Write(unsigned int nwhen)
 
 						// store initial time step (i.e. time step zero)
 						double time = GetTime().currentTime;
-						if (bout) m_plot->Write(*this, (float) time);
+						if (bout && (m_plot->Write(*this, (float) time) == false))
+						{
+							feLogError("Failed writing to PLOT database.");
+							delete m_plot;
+							m_plot = 0;
+						}
 					}
 				}
 			}
@@ -612,7 +630,12 @@ void FEBioModel::Write(unsigned int nwhen)
 					}
 
 					double time = GetTime().currentTime;
-					if (m_plot) m_plot->Write(*this, (float)time);
+					if (m_plot && (m_plot->Write(*this, (float)time) == false))
+					{
+						feLogError("Failed writing to PLOT database.");
+						delete m_plot;
+						m_plot = 0;
+					}
 				}
 			}
 		}
@@ -994,11 +1017,12 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 		ar << m_sfile << m_splot << m_slog << m_sdump;
 
 		// plot file
-		int npltfmt = 2;
+		int npltfmt = 5;
 		ar << npltfmt;
 
-		ar << m_pltCompression;
+		ar << m_pltCompression << m_pltCodec << m_pltIndex;
 		ar << m_pltData;
+		for (FEPlotVariable& vi : m_pltData) ar << vi.m_nenc;
 
 		// data records
 		SerializeDataStore(ar);
@@ -1022,13 +1046,19 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 			m_sdump = sdmp;
 		}
 
-		// get the plot file format (should be 2)
+		// get the plot file format (should be 2, 3, 4, or 5)
 		int npltfmt = 0;
 		ar >> npltfmt;
-		assert(npltfmt == 2);
+		assert((npltfmt >= 2) && (npltfmt <= 5));
 
 		ar >> m_pltCompression;
+		if (npltfmt >= 3) ar >> m_pltCodec;
+		if (npltfmt >= 4) ar >> m_pltIndex;
 		ar >> m_pltData;
+		if (npltfmt >= 5)
+		{
+			for (FEPlotVariable& vi : m_pltData) ar >> vi.m_nenc;
+		}
 
 		// remove the plot file (if any)
 		if (m_plot) { delete m_plot; m_plot = 0; }
@@ -1050,12 +1080,14 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 		{
 			// create a new plot file
 			pplt->SetCompression(m_pltCompression);
+			pplt->SetBlockCompression(m_pltCodec);
+			pplt->SetIndex(m_pltIndex);
 
 			// add plot variables
 			for (FEPlotVariable& vi : m_pltData)
 			{
 				// add the plot output variable
-				if (pplt->AddVariable(vi.m_var.c_str(), vi.m_item, vi.m_domName.c_str()) == false)
+				if (pplt->AddVariable(vi.m_var.c_str(), vi.m_item, vi.m_domName.c_str(), vi.m_nenc) == false)
 				{
 					feLog("FATAL ERROR: Output variable \"%s\" is not defined\n", vi.m_var.c_str());
 					throw "FATAL ERROR";
@@ -1142,12 +1174,14 @@ bool FEBioModel::Init()
 
 			// set compression
 			pplt->SetCompression(m_pltCompression);
+			pplt->SetBlockCompression(m_pltCodec);
+			pplt->SetIndex(m_pltIndex);
 
 			// add plot variables
 			for (FEPlotVariable& vi : m_pltData)
 			{
 				// add the plot output variable
-				if (pplt->AddVariable(vi.m_var.c_str(), vi.m_item, vi.m_domName.c_str()) == false)
+				if (pplt->AddVariable(vi.m_var.c_str(), vi.m_item, vi.m_domName.c_str(), vi.m_nenc) == false)
 				{
 					feLog("FATAL ERROR: Output variable \"%s\" is not defined\n", vi.m_var.c_str());
 					return false;
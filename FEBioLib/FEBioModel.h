@@ -55,7 +55,7 @@ class FEBIOLIB_API FEBioModel : public FEMechModel
 	{
 	public:
 		FEPlotVariable();
-		FEPlotVariable(const std::string& varName, const std::vector<int>& itemList, const std::string& domainName);
+		FEPlotVariable(const std::string& varName, const std::vector<int>& itemList, const std::string& domainName, int nenc = 0);
 		FEPlotVariable(const FEPlotVariable& v);
 		void operator = (const FEPlotVariable& v);
 
@@ -65,6 +65,7 @@ class FEBIOLIB_API FEBioModel : public FEMechModel
 		std::string			m_var;
 		std::vector<int>	m_item;
 		std::string			m_domName;
+		int					m_nenc;		// data encoding
 	};
 
 public:
@@ -225,6 +226,8 @@ protected: // file names
 protected:
 	vector<FEPlotVariable>	m_pltData;
 	int						m_pltCompression;
+	int						m_pltCodec;
+	bool					m_pltIndex;
 	bool					m_pltAppendOnRestart;
 
 private:
@@ -40,7 +40,7 @@ SOFTWARE.*/
 class FEPlotNodeVelocity : public FEPlotNodeData
 {
 public:
-	FEPlotNodeVelocity(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){}
+	FEPlotNodeVelocity(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){ SetThreadSafe(true); }
 	bool Save(FEMesh& m, FEDataStream& a);
 };
 
@@ -50,7 +50,7 @@ public:
 class FEPlotNodeAcceleration : public FEPlotNodeData
 {
 public:
-	FEPlotNodeAcceleration(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){}
+	FEPlotNodeAcceleration(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){ SetThreadSafe(true); }
 	bool Save(FEMesh& m, FEDataStream& a);
 };
 
@@ -59,7 +59,7 @@ public:
 class FEPlotNodeReactionForces : public FEPlotNodeData
 {
 public:
-	FEPlotNodeReactionForces(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){}
+	FEPlotNodeReactionForces(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){ SetThreadSafe(true); }
 	bool Save(FEMesh& m, FEDataStream& a);
 };
 
@@ -73,7 +73,7 @@ public:
 class FEPlotContactGap : public FEPlotSurfaceData
 {
 public:
-    FEPlotContactGap(FEModel* pfem) : FEPlotSurfaceData(pfem, PLT_FLOAT, FMT_ITEM){}
+    FEPlotContactGap(FEModel* pfem) : FEPlotSurfaceData(pfem, PLT_FLOAT, FMT_ITEM){ SetThreadSafe(true); }
     bool Save(FESurface& surf, FEDataStream& a);
 };
 
@@ -93,7 +93,7 @@ public:
 class FEPlotContactPressure : public FEPlotSurfaceData
 {
 public:
-    FEPlotContactPressure(FEModel* pfem) : FEPlotSurfaceData(pfem, PLT_FLOAT, FMT_ITEM){}
+    FEPlotContactPressure(FEModel* pfem) : FEPlotSurfaceData(pfem, PLT_FLOAT, FMT_ITEM){ SetThreadSafe(true); }
     bool Save(FESurface& surf, FEDataStream& a);
 };
 
@@ -290,7 +290,7 @@ public:
 class FEPlotElementStress : public FEPlotDomainData
 {
 public:
-	FEPlotElementStress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM){}
+	FEPlotElementStress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM){ SetThreadSafe(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
 };
 
@@ -488,7 +488,7 @@ public:
 class FEPlotRelativeVolume : public FEPlotDomainData
 {
 public:
-	FEPlotRelativeVolume(FEModel* pfem) : FEPlotDomainData(pfem, PLT_FLOAT, FMT_ITEM){}
+	FEPlotRelativeVolume(FEModel* pfem) : FEPlotDomainData(pfem, PLT_FLOAT, FMT_ITEM){ SetThreadSafe(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
 };
 
@@ -774,7 +774,7 @@ public:
 class FEPlotNodalStresses : public FEPlotDomainData
 {
 public:
-	FEPlotNodalStresses(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_MULT){}
+	FEPlotNodalStresses(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_MULT){ SetThreadSafe(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
 };
 
@@ -783,7 +783,7 @@ public:
 class FEPlotLagrangeStrain : public FEPlotDomainData
 {
 public:
-	FEPlotLagrangeStrain(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM){}
+	FEPlotLagrangeStrain(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM){ SetThreadSafe(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
 };
 
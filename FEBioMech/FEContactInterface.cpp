@@ -33,11 +33,13 @@ SOFTWARE.*/
 #include "FECore/FEModel.h"
 #include "FECore/FESolver.h"
 #include "FECore/FEAnalysis.h"
+#include "FECore/log.h"
 
 BEGIN_FECORE_CLASS(FEContactInterface, FESurfacePairConstraint)
 	ADD_PARAMETER(m_laugon, "laugon"        );
     ADD_PARAMETER(m_psf   , "penalty_sf"    );
     ADD_PARAMETER(m_psfmax, "max_penalty_sf");
+	ADD_PARAMETER(m_blogSearch, "log_search");
 END_FECORE_CLASS();
 
 //////////////////////////////////////////////////////////////////////
@@ -49,6 +51,7 @@ FEContactInterface::FEContactInterface(FEModel* pfem) : FESurfacePairConstraint(
 	m_laugon = 0;	// penalty method by default
     m_psf = 1.0;    // default scale factor is 1
     m_psfmax = 0;   // default max scale factor is not set
+	m_blogSearch = false;
 }
 
 FEContactInterface::~FEContactInterface()
@@ -174,3 +177,19 @@ double FEContactInterface::GetPenaltyScaleFactor()
     if ((m_psfmax > 0) && (psf > m_psfmax)) psf = m_psfmax;
     return psf;
 }
+
+//-----------------------------------------------------------------------------
+// This is called on every update, so it only writes to the log when log_search
+// is set, and only when the broad phase of the contact search pruned any points, 
+// i.e. when a search radius was set that is small enough.
+void FEContactInterface::ReportContactSearch(FEContactSurface& ss, FEContactSurface& ms)
+{
+	int nprojected = ss.ProjectedPoints() + ms.ProjectedPoints();
+	int npruned = ss.PrunedPoints() + ms.PrunedPoints();
+	if (m_blogSearch && (npruned > 0))
+	{
+		feLog(" contact interface # %d : %d points projected, %d pruned\n", GetID(), nprojected, npruned);
+	}
+	ss.ResetContactSearchCounters();
+	ms.ResetContactSearchCounters();
+}
@@ -75,11 +75,15 @@ protected:
 
     //! cale the penalty factor during Lagrange augmentation
     double GetPenaltyScaleFactor();
+
+	//! write the number of projected and pruned points of the contact search to the log
+	void ReportContactSearch(FEContactSurface& ss, FEContactSurface& ms);
     
 public:
 	int		m_laugon;	//!< contact enforcement method
     double  m_psf;      //!< penalty scale factor during Lagrange augmentation
     double  m_psfmax;   //!< max allowable penalty scale factor during laugon
+	bool	m_blogSearch;	//!< write the contact search statistics to the log
 
 	DECLARE_FECORE_CLASS();
 };
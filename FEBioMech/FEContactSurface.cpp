@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FEContactSurface.h"
 #include "FECore/FEModel.h"
 #include "FEBioMech/FEElasticMaterial.h"
+#include <FECore/FESurfaceBVH.h>
 #include <assert.h>
 
 //-----------------------------------------------------------------------------
@@ -39,6 +40,10 @@ FEContactSurface::FEContactSurface(FEModel* pfem) : FESurface(pfem), m_pfem(pfem
 	m_dofX = -1;
 	m_dofY = -1;
 	m_dofZ = -1;
+
+	m_pcs = nullptr;
+	m_nprojected = 0;
+	m_npruned = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -73,6 +78,136 @@ void FEContactSurface::SetSibling(FEContactSurface* ps) { m_pSibling = ps; }
 //-----------------------------------------------------------------------------
 void FEContactSurface::SetContactInterface(FEContactInterface* ps) { m_pContactInterface = ps; }
 
+//-----------------------------------------------------------------------------
+// This is the broad phase of the contact search. A facet's integration points only
+// need to be projected if the swept bounding box of the facet over the time step,
+// grown by the search radius, overlaps a facet of the other surface. Those boxes are 
+// compared using the bounding volume hierarchy of the other surface.
+// When a facet is pruned, the clearance is remembered. The facet stays pruned without 
+// searching again as long as it and the other surface moved less than the clearance.
+//
+// The projection accepts points up to tol outside a facet (in natural coordinates), 
+// and such points can lie outside the facet's node box. For linear facets this distance
+// is bounded: for a triangle, x(r,s) is linear and the extended facet is the triangle
+// with corners (-tol,-tol), (1+2tol,-tol), (-tol,1+2tol), which are at most 3*tol*h 
+// from the nodes (h = diagonal of the node box). For a quad, each coordinate of x(r,s) 
+// is bilinear so its extremes are at the corners (+-(1+tol), +-(1+tol)), which are at 
+// most tol*(1+tol)*h from the nodes in each direction. So, it suffices to grow the 
+// search radius by 3*tol*(1+tol)*h. Higher-order facets can bulge out of their node 
+// boxes, so when either surface has those, all facets are searched.
+void FEContactSurface::UpdateContactCandidates(FESurface& ms, double R, double tol)
+{
+	int NF = Elements();
+	int NN = Nodes();
+	int NM = ms.Nodes();
+
+	// see if all facets are linear
+	bool blinear = true;
+	for (int i = 0; i < NF; ++i) if (Element(i).Nodes() > 4) { blinear = false; break; }
+	for (int i = 0; i < ms.Elements(); ++i) if (ms.Element(i).Nodes() > 4) { blinear = false; break; }
+
+	// without a search radius every point has to be projected
+	if ((R <= 0.0) || (blinear == false))
+	{
+		m_cand.clear();
+		for (int i = 0; i < NF; ++i) m_nprojected += Element(i).GaussPoints();
+		return;
+	}
+
+	FESurfaceBVH& bvh = *ms.GetBVH();
+	bvh.Update();
+
+	// grow the search radius by the projection tolerance (see above)
+	double hmax = 0.0;
+	for (int i = 0; i < bvh.Facets(); ++i)
+	{
+		double h = (bvh.FacetMax(i) - bvh.FacetMin(i)).norm();
+		if (h > hmax) hmax = h;
+	}
+	R += 3.0*tol*(1.0 + tol)*hmax;
+
+	// see how far the nodes moved since the clearances were reset
+	bool breset = ((m_pcs != &ms) || ((int)m_cand.size() != NF) || ((int)m_rc.size() != NN) || ((int)m_rcs.size() != NM));
+	double dmax = 0.0, dsec = 0.0;
+	if (breset == false)
+	{
+		for (int i = 0; i < NN; ++i)
+		{
+			m_dc[i] = (Node(i).m_rt - m_rc[i]).norm();
+			if (m_dc[i] > dmax) dmax = m_dc[i];
+		}
+		for (int i = 0; i < NM; ++i)
+		{
+			double d = (ms.Node(i).m_rt - m_rcs[i]).norm();
+			if (d > dsec) dsec = d;
+		}
+
+		// when the surfaces moved more than the search radius, 
+		// most of the clearances will be useless anyway
+		if (dmax + dsec > R) breset = true;
+	}
+
+	if (breset)
+	{
+		m_pcs = &ms;
+		m_cand.assign(NF, 1);
+		m_clear.assign(NF, -1.0);
+		m_rc.resize(NN);
+		m_rcs.resize(NM);
+		m_dc.assign(NN, 0.0);
+		for (int i = 0; i < NN; ++i) m_rc[i] = Node(i).m_rt;
+		for (int i = 0; i < NM; ++i) m_rcs[i] = ms.Node(i).m_rt;
+		dsec = 0.0;
+	}
+
+	int nprojected = 0, npruned = 0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:nprojected, npruned)
+	for (int i = 0; i < NF; ++i)
+	{
+		FESurfaceElement& el = Element(i);
+		int ne = el.Nodes();
+
+		// max displacement of the facet's nodes since the reset
+		double dface = 0.0;
+		for (int j = 0; j < ne; ++j) if (m_dc[el.m_lnode[j]] > dface) dface = m_dc[el.m_lnode[j]];
+
+		// The distance between the two surfaces can only have decreased by the 
+		// displacements since the clearance was calculated, and each of those 
+		// is bounded by the displacements since the reset at both times.
+		bool bcand = true;
+		if (m_clear[i] > dface + dsec) bcand = false;
+		else
+		{
+			// swept box of the facet from the start of the time step
+			vec3d r0 = Node(el.m_lnode[0]).m_rt, r1 = r0;
+			for (int j = 0; j < ne; ++j)
+			{
+				FENode& node = Node(el.m_lnode[j]);
+				box_add(r0, r1, node.m_rp, node.m_rp);
+				box_add(r0, r1, node.m_rt, node.m_rt);
+			}
+			r0 -= vec3d(R, R, R);
+			r1 += vec3d(R, R, R);
+
+			// If the grown box does not touch the other surface, 
+			// all of the facet's points are further than R away from it.
+			double d = bvh.BoxDistance(r0, r1, R);
+			if (d > 0.0)
+			{
+				bcand = false;
+				m_clear[i] = d - dface - dsec;
+			}
+			else m_clear[i] = -1.0;
+		}
+
+		m_cand[i] = (bcand ? 1 : 0);
+		if (bcand) nprojected += el.GaussPoints(); else npruned += el.GaussPoints();
+	}
+
+	m_nprojected += nprojected;
+	m_npruned += npruned;
+}
+
 //-----------------------------------------------------------------------------
 void FEContactSurface::GetVectorGap(int nface, vec3d& pg) {}
 
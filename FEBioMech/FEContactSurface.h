@@ -106,6 +106,21 @@ public:
 
 	FEModel* GetFEModel() { return m_pfem; }
 
+public:
+	//! Update the contact search data for projecting this surface onto the surface ms.
+	//! Facets that cannot come within the search radius R of ms are excluded from
+	//! the contact search. A radius of zero means that all facets are searched.
+	//! The tolerance is the projection tolerance (in natural coordinates) of the search.
+	void UpdateContactCandidates(FESurface& ms, double R, double tol);
+
+	//! See if the integration points of a facet need to be projected onto the other surface
+	bool IsContactCandidate(int nface) const { return (m_cand.empty() || (m_cand[nface] != 0)); }
+
+	//! number of integration points that were projected and pruned since the last reset
+	int ProjectedPoints() const { return m_nprojected; }
+	int PrunedPoints() const { return m_npruned; }
+	void ResetContactSearchCounters() { m_nprojected = m_npruned = 0; }
+
 protected:
 	FEContactSurface* m_pSibling;
     FEContactInterface* m_pContactInterface;
@@ -114,4 +129,15 @@ protected:
 	int	m_dofX;
 	int	m_dofY;
 	int	m_dofZ;
+
+private:
+	// contact search data (see UpdateContactCandidates)
+	vector<char>	m_cand;		//!< facets that are candidates for contact
+	vector<double>	m_clear;	//!< lower bound of the clearance of each facet when it was pruned
+	vector<vec3d>	m_rc;		//!< nodal positions at the time the clearances were reset
+	vector<vec3d>	m_rcs;		//!< same for the nodes of the other surface
+	vector<double>	m_dc;		//!< nodal displacements since the reset
+	FESurface*		m_pcs;		//!< the other surface
+	int				m_nprojected;	//!< number of points that were projected
+	int				m_npruned;		//!< number of points that were pruned
 };
@@ -44,6 +44,8 @@ FEContinuousFiberDistribution::FEContinuousFiberDistribution(FEModel* pfem) : FE
 	m_pFmat = 0;
 	m_pFDD = 0;
 	m_pFint = 0;
+
+	m_bconstR = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -55,6 +57,23 @@ bool FEContinuousFiberDistribution::Init()
     // initialize base class
 	if (FEElasticMaterial::Init() == false) return false;
 
+	// If the integration scheme has a table of integration points and the fiber density does
+	// not change over time, the fiber weights only need to be evaluated once for each point. 
+	// If they are also the same at all points, they are evaluated once for the material.
+	m_wR.clear();
+	m_bconstR = false;
+	int nint = m_pFint->IntegrationPoints();
+	if ((nint > 0) && m_pFDD->IsTimeInvariant())
+	{
+		m_bconstR = true;
+		if (m_pFDD->IsUniform() && HasUniformLocalCS())
+		{
+			FEMaterialPoint mp;
+			m_wR.resize(nint);
+			EvaluateFiberWeights(mp, &m_wR[0]);
+		}
+	}
+
 	return true;
 }
 
@@ -64,6 +83,75 @@ void FEContinuousFiberDistribution::Serialize(DumpStream& ar)
 {	
 	FEElasticMaterial::Serialize(ar);
 	if (ar.IsShallow()) return;
+	ar & m_bconstR & m_wR;
+}
+
+//-----------------------------------------------------------------------------
+// returns a pointer to a new material point object
+FEMaterialPoint* FEContinuousFiberDistribution::CreateMaterialPointData()
+{
+	FEMaterialPoint* mp = FEElasticMaterial::CreateMaterialPointData();
+
+	// add the fiber data at the end of the list
+	FEMaterialPoint* pt = mp;
+	while (pt->Next()) pt = pt->Next();
+	pt->SetNext(new FEFiberMaterialPoint);
+
+	return mp;
+}
+
+//-----------------------------------------------------------------------------
+// The fiber weights are the integration weights multiplied by the fiber density, and divided
+// by the integrated fiber density. Returns null if the scheme has no integration table.
+const double* FEContinuousFiberDistribution::FiberWeights(FEMaterialPoint& mp)
+{
+	if (m_pFint->IntegrationPoints() == 0) return nullptr;
+
+	// see if the weights are the same for all points
+	if (m_wR.empty() == false) return &m_wR[0];
+
+	FEFiberMaterialPoint* fp = mp.ExtractData<FEFiberMaterialPoint>();
+	if (fp == nullptr) return nullptr;
+
+	if ((fp->m_bvalid == false) || (m_bconstR == false))
+	{
+		fp->m_wR.resize(m_pFint->IntegrationPoints());
+		EvaluateFiberWeights(mp, &fp->m_wR[0]);
+		fp->m_bvalid = true;
+	}
+
+	return &fp->m_wR[0];
+}
+
+//-----------------------------------------------------------------------------
+void FEContinuousFiberDistribution::EvaluateFiberWeights(FEMaterialPoint& mp, double* wR)
+{
+	// get the local coordinate systems
+	mat3d Qt = GetLocalCS(mp).transpose();
+
+	int nint = m_pFint->IntegrationPoints();
+	const double* nx = m_pFint->FiberX();
+	const double* ny = m_pFint->FiberY();
+	const double* nz = m_pFint->FiberZ();
+	const double* wn = m_pFint->Weights();
+
+	double IFD = 0.0;
+	for (int i = 0; i < nint; ++i)
+	{
+		// get the global fiber direction
+		vec3d N(nx[i], ny[i], nz[i]);
+
+		// convert to local coordinates
+		vec3d n0 = Qt*N;
+
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		wR[i] = m_pFDD->FiberDensity(mp, n0)*wn[i];
+
+		// integrate the fiber distribution (as in IntegratedFiberDensity)
+		IFD += m_pFDD->FiberDensity(mp, N)*wn[i];
+	}
+
+	for (int i = 0; i < nint; ++i) wR[i] /= IFD;
 }
 
 //-----------------------------------------------------------------------------
@@ -75,6 +163,13 @@ mat3ds FEContinuousFiberDistribution::Stress(FEMaterialPoint& mp)
 	// calculate stress
 	mat3ds s; s.zero();
 
+	// use the integration table if the scheme has one
+	const double* wR = FiberWeights(mp);
+	if (wR)
+	{
+		return m_pFmat->FiberStressSum(pt, m_pFint->IntegrationPoints(), m_pFint->FiberX(), m_pFint->FiberY(), m_pFint->FiberZ(), wR);
+	}
+
 	// get the local coordinate systems
 	mat3d Qt = GetLocalCS(mp).transpose();
 
@@ -115,6 +210,13 @@ tens4ds FEContinuousFiberDistribution::Tangent(FEMaterialPoint& mp)
 {
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 
+	// use the integration table if the scheme has one
+	const double* wR = FiberWeights(mp);
+	if (wR)
+	{
+		return m_pFmat->FiberTangentSum(mp, m_pFint->IntegrationPoints(), m_pFint->FiberX(), m_pFint->FiberY(), m_pFint->FiberZ(), wR);
+	}
+
 	// get the local coordinate systems
 	mat3d Qt = GetLocalCS(mp).transpose();
 
@@ -159,6 +261,13 @@ double FEContinuousFiberDistribution::StrainEnergyDensity(FEMaterialPoint& mp)
 { 
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 
+	// use the integration table if the scheme has one
+	const double* wR = FiberWeights(mp);
+	if (wR)
+	{
+		return m_pFmat->FiberStrainEnergyDensitySum(mp, m_pFint->IntegrationPoints(), m_pFint->FiberX(), m_pFint->FiberY(), m_pFint->FiberZ(), wR);
+	}
+
 	// get the local coordinate systems
 	mat3d Qt = GetLocalCS(mp).transpose();
 
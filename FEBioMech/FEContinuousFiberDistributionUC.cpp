@@ -42,6 +42,8 @@ FEContinuousFiberDistributionUC::FEContinuousFiberDistributionUC(FEModel* pfem)
 	m_pFmat = 0;
 	m_pFDD = 0;
 	m_pFint = 0;
+
+	m_bconstR = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -53,14 +55,96 @@ bool FEContinuousFiberDistributionUC::Init()
 	// initialize fiber integration scheme
 	if (FEUncoupledMaterial::Init() == false) return false;
 
+	// If the integration scheme has a table of integration points and the fiber density does
+	// not change over time, the fiber weights only need to be evaluated once for each point. 
+	// If they are also the same at all points, they are evaluated once for the material.
+	m_wR.clear();
+	m_bconstR = false;
+	int nint = m_pFint->IntegrationPoints();
+	if ((nint > 0) && m_pFDD->IsTimeInvariant())
+	{
+		m_bconstR = true;
+		if (m_pFDD->IsUniform() && HasUniformLocalCS())
+		{
+			FEMaterialPoint mp;
+			m_wR.resize(nint);
+			EvaluateFiberWeights(mp, &m_wR[0]);
+		}
+	}
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! Serialization
+void FEContinuousFiberDistributionUC::Serialize(DumpStream& ar)
+{
+	FEUncoupledMaterial::Serialize(ar);
+	if (ar.IsShallow()) return;
+	ar & m_bconstR & m_wR;
+}
+
 //-----------------------------------------------------------------------------
 // returns a pointer to a new material point object
 FEMaterialPoint* FEContinuousFiberDistributionUC::CreateMaterialPointData() 
 {
-	return m_pFmat->CreateMaterialPointData();
+	FEMaterialPoint* mp = m_pFmat->CreateMaterialPointData();
+
+	// add the fiber data at the end of the list
+	FEMaterialPoint* pt = mp;
+	while (pt->Next()) pt = pt->Next();
+	pt->SetNext(new FEFiberMaterialPoint);
+
+	return mp;
+}
+
+//-----------------------------------------------------------------------------
+// The fiber weights are the integration weights multiplied by the fiber density, and divided
+// by the integrated fiber density. Returns null if the scheme has no integration table.
+const double* FEContinuousFiberDistributionUC::FiberWeights(FEMaterialPoint& mp)
+{
+	if (m_pFint->IntegrationPoints() == 0) return nullptr;
+
+	// see if the weights are the same for all points
+	if (m_wR.empty() == false) return &m_wR[0];
+
+	FEFiberMaterialPoint* fp = mp.ExtractData<FEFiberMaterialPoint>();
+	if (fp == nullptr) return nullptr;
+
+	if ((fp->m_bvalid == false) || (m_bconstR == false))
+	{
+		fp->m_wR.resize(m_pFint->IntegrationPoints());
+		EvaluateFiberWeights(mp, &fp->m_wR[0]);
+		fp->m_bvalid = true;
+	}
+
+	return &fp->m_wR[0];
+}
+
+//-----------------------------------------------------------------------------
+void FEContinuousFiberDistributionUC::EvaluateFiberWeights(FEMaterialPoint& mp, double* wR)
+{
+	// get the local coordinate systems
+	mat3d QT = GetLocalCS(mp).transpose();
+
+	int nint = m_pFint->IntegrationPoints();
+	const double* nx = m_pFint->FiberX();
+	const double* ny = m_pFint->FiberY();
+	const double* nz = m_pFint->FiberZ();
+	const double* wn = m_pFint->Weights();
+
+	double IFD = 0.0;
+	for (int i = 0; i < nint; ++i)
+	{
+		// rotate to local configuration to evaluate ellipsoidally distributed material coefficients
+		vec3d n0a = QT*vec3d(nx[i], ny[i], nz[i]);
+		wR[i] = m_pFDD->FiberDensity(mp, n0a)*wn[i];
+
+		// integrate the fiber distribution
+		IFD += wR[i];
+	}
+
+	for (int i = 0; i < nint; ++i) wR[i] /= IFD;
 }
 
 //-----------------------------------------------------------------------------
@@ -69,6 +153,13 @@ mat3ds FEContinuousFiberDistributionUC::DevStress(FEMaterialPoint& mp)
 { 
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 
+	// use the integration table if the scheme has one
+	const double* wR = FiberWeights(mp);
+	if (wR)
+	{
+		return m_pFmat->DevFiberStressSum(pt, m_pFint->IntegrationPoints(), m_pFint->FiberX(), m_pFint->FiberY(), m_pFint->FiberZ(), wR);
+	}
+
 	// calculate stress
 	mat3ds s; s.zero();
 
@@ -113,6 +204,13 @@ tens4ds FEContinuousFiberDistributionUC::DevTangent(FEMaterialPoint& mp)
 { 
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 
+	// use the integration table if the scheme has one
+	const double* wR = FiberWeights(mp);
+	if (wR)
+	{
+		return m_pFmat->DevFiberTangentSum(mp, m_pFint->IntegrationPoints(), m_pFint->FiberX(), m_pFint->FiberY(), m_pFint->FiberZ(), wR);
+	}
+
 	// get the local coordinate systems
 	mat3d Q = GetLocalCS(mp);
 	mat3d QT = Q.transpose();
@@ -157,6 +255,13 @@ double FEContinuousFiberDistributionUC::DevStrainEnergyDensity(FEMaterialPoint&
 { 
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 
+	// use the integration table if the scheme has one
+	const double* wR = FiberWeights(mp);
+	if (wR)
+	{
+		return m_pFmat->DevFiberStrainEnergyDensitySum(mp, m_pFint->IntegrationPoints(), m_pFint->FiberX(), m_pFint->FiberY(), m_pFint->FiberZ(), wR);
+	}
+
 	// get the local coordinate systems
 	mat3d Q = GetLocalCS(mp);
 	mat3d QT = Q.transpose();
@@ -58,10 +58,24 @@ public:
 	// returns a pointer to a new material point object
 	FEMaterialPoint* CreateMaterialPointData() override;
 
+	//! Serialization
+	void Serialize(DumpStream& ar) override;
+
+protected:
+	// get the fiber weights of the integration table at a material point
+	const double* FiberWeights(FEMaterialPoint& mp);
+
+	// evaluate the fiber weights of the integration table at a material point
+	void EvaluateFiberWeights(FEMaterialPoint& mp, double* wR);
+
 public:
     FEElasticFiberMaterialUC*   m_pFmat;    // pointer to fiber material
 	FEFiberDensityDistribution* m_pFDD;     // pointer to fiber density distribution
 	FEFiberIntegrationScheme*	m_pFint;    // pointer to fiber integration scheme
 
+protected:
+	bool				m_bconstR;	// the fiber weights don't change over time and are stored at the material points
+	std::vector<double>	m_wR;		// fiber weights, if they are the same at all material points
+
 	DECLARE_FECORE_CLASS();
 };
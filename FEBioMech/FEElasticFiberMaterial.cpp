@@ -57,3 +57,36 @@ vec3d FEElasticFiberMaterial::FiberVector(FEMaterialPoint& mp)
 
 	return a0;
 }
+
+//-----------------------------------------------------------------------------
+mat3ds FEElasticFiberMaterial::FiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	mat3ds s; s.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		if (w[i] != 0.0) s += FiberStress(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEElasticFiberMaterial::FiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	tens4ds c; c.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		if (w[i] != 0.0) c += FiberTangent(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+double FEElasticFiberMaterial::FiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	double sed = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		if (w[i] != 0.0) sed += FiberStrainEnergyDensity(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return sed;
+}
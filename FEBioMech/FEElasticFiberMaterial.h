@@ -49,6 +49,13 @@ public:
 	//! Strain energy density
 	virtual double FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& a0) = 0;
 
+	// Weighted sums over a set of n fibers. The fiber vectors are given by their components 
+	// (nx, ny, nz) and the weights by w. The default implementations call the functions above
+	// for each fiber, but materials can override these to evaluate the fibers in a single loop.
+	virtual mat3ds FiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
+	virtual tens4ds FiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
+	virtual double FiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
+
 private:
 	// These are made private since fiber materials should implement the functions above instead. 
 	// The functions can still be reached when a fiber material is used in an elastic mixture. 
@@ -56,3 +56,36 @@ vec3d FEElasticFiberMaterialUC::FiberVector(FEMaterialPoint& mp)
 
 	return a0;
 }
+
+//-----------------------------------------------------------------------------
+mat3ds FEElasticFiberMaterialUC::DevFiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	mat3ds s; s.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		if (w[i] != 0.0) s += DevFiberStress(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEElasticFiberMaterialUC::DevFiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	tens4ds c; c.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		if (w[i] != 0.0) c += DevFiberTangent(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+double FEElasticFiberMaterialUC::DevFiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	double sed = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		if (w[i] != 0.0) sed += DevFiberStrainEnergyDensity(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return sed;
+}
@@ -49,6 +49,18 @@ FEElasticMaterial::~FEElasticMaterial()
 //! return the strain energy density
 double FEElasticMaterial::StrainEnergyDensity(FEMaterialPoint& pt) { return 0; }
 
+//-----------------------------------------------------------------------------
+void FEElasticMaterial::BatchStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	for (int i=0; i<pts.n; ++i) s[i] = Stress(*pts.mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticMaterial::BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c)
+{
+	for (int i=0; i<pts.n; ++i) c[i] = Tangent(*pts.mp[i]);
+}
+
 //-----------------------------------------------------------------------------
 FEElasticStress::FEElasticStress() : FEDomainParameter("stress")
 {
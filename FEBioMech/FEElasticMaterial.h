@@ -30,6 +30,48 @@ SOFTWARE.*/
 #include "FESolidMaterial.h"
 #include "FEElasticMaterialPoint.h"
 
+//-----------------------------------------------------------------------------
+//! A batch of material points that are evaluated together (e.g. the integration
+//! points of an element). The deformation gradients and their determinants are
+//! packed in contiguous arrays, so that materials can evaluate the batch in loops
+//! without virtual calls, which the compiler can vectorize.
+struct FEMaterialPointBatch
+{
+	enum { MAX_POINTS = 27 };	//!< max nr of points in a batch (= max nr of integration points)
+
+	int					n;		//!< number of points
+	FEMaterialPoint**	mp;		//!< the material points
+	const mat3d*		F;		//!< deformation gradients
+	const double*		J;		//!< determinants of the deformation gradients
+
+	//! left Cauchy-Green tensor at point i
+	mat3ds LeftCauchyGreen(int i) const
+	{
+		const mat3d& Fi = F[i];
+		return mat3ds(
+			Fi[0][0]*Fi[0][0]+Fi[0][1]*Fi[0][1]+Fi[0][2]*Fi[0][2],
+			Fi[1][0]*Fi[1][0]+Fi[1][1]*Fi[1][1]+Fi[1][2]*Fi[1][2],
+			Fi[2][0]*Fi[2][0]+Fi[2][1]*Fi[2][1]+Fi[2][2]*Fi[2][2],
+			Fi[0][0]*Fi[1][0]+Fi[0][1]*Fi[1][1]+Fi[0][2]*Fi[1][2],
+			Fi[1][0]*Fi[2][0]+Fi[1][1]*Fi[2][1]+Fi[1][2]*Fi[2][2],
+			Fi[0][0]*Fi[2][0]+Fi[0][1]*Fi[2][1]+Fi[0][2]*Fi[2][2]);
+	}
+
+	//! deviatoric left Cauchy-Green tensor at point i
+	mat3ds DevLeftCauchyGreen(int i) const
+	{
+		double Jm23 = pow(J[i], -2.0/3.0);
+		const mat3d& Fi = F[i];
+		return mat3ds(
+			Jm23*(Fi[0][0]*Fi[0][0]+Fi[0][1]*Fi[0][1]+Fi[0][2]*Fi[0][2]),
+			Jm23*(Fi[1][0]*Fi[1][0]+Fi[1][1]*Fi[1][1]+Fi[1][2]*Fi[1][2]),
+			Jm23*(Fi[2][0]*Fi[2][0]+Fi[2][1]*Fi[2][1]+Fi[2][2]*Fi[2][2]),
+			Jm23*(Fi[0][0]*Fi[1][0]+Fi[0][1]*Fi[1][1]+Fi[0][2]*Fi[1][2]),
+			Jm23*(Fi[1][0]*Fi[2][0]+Fi[1][1]*Fi[2][1]+Fi[1][2]*Fi[2][2]),
+			Jm23*(Fi[0][0]*Fi[2][0]+Fi[0][1]*Fi[2][1]+Fi[0][2]*Fi[2][2]));
+	}
+};
+
 //-----------------------------------------------------------------------------
 //! Base class for (hyper-)elastic materials
 
@@ -47,6 +89,14 @@ public:
 
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt);
+
+	//! calculate the stress at a batch of material points
+	//! (The default implementation evaluates the stress at each point separately.)
+	virtual void BatchStress(const FEMaterialPointBatch& pts, mat3ds* s);
+
+	//! calculate the tangent at a batch of material points
+	//! (The default implementation evaluates the tangent at each point separately.)
+	virtual void BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c);
     
     // get the elastic material
     virtual FEElasticMaterial* GetElasticMaterial() { return this; }
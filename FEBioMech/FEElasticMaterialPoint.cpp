@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEElasticMaterialPoint.h"
+#include <FECore/FEPoolAllocator.h>
 
 //-----------------------------------------------------------------------------
 FEElasticMaterialPoint::FEElasticMaterialPoint()
@@ -40,6 +41,24 @@ FEElasticMaterialPoint::FEElasticMaterialPoint()
     m_Wt = m_Wp = 0;
 }
 
+//-----------------------------------------------------------------------------
+// The pool is never deleted, since material points may still be released during program exit.
+static FEPoolAllocator& ElasticPointPool()
+{
+	static FEPoolAllocator* pool = new FEPoolAllocator(sizeof(FEElasticMaterialPoint));
+	return *pool;
+}
+
+void* FEElasticMaterialPoint::operator new(size_t size)
+{
+	return ElasticPointPool().Allocate(size);
+}
+
+void FEElasticMaterialPoint::operator delete(void* p, size_t size)
+{
+	ElasticPointPool().Deallocate(p, size);
+}
+
 //-----------------------------------------------------------------------------
 FEMaterialPoint* FEElasticMaterialPoint::Copy()
 {
@@ -70,7 +89,13 @@ void FEElasticMaterialPoint::Init()
 void FEElasticMaterialPoint::Serialize(DumpStream& ar)
 {
 	FEMaterialPoint::Serialize(ar);
-    ar & m_F & m_J & m_s & m_v & m_a & m_gradJ & m_L & m_Wt & m_Wp;
+	if (ar.IsStateOnly())
+	{
+		// the velocity, acceleration and their gradients are recalculated from
+		// the nodal values when the stresses are updated, so we don't need to store them.
+		ar & m_F & m_J & m_s & m_Wt & m_Wp;
+	}
+    else ar & m_F & m_J & m_s & m_v & m_a & m_gradJ & m_L & m_Wt & m_Wp;
 }
 
 //-----------------------------------------------------------------------------
@@ -49,6 +49,12 @@ public:
 	//! serialize material point data
 	void Serialize(DumpStream& ar) override;
 
+public:
+	//! Elastic material points are allocated from a pool, so that the points 
+	//! of a domain are stored contiguously.
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
+
 public:
 	mat3ds Strain() const;
 	mat3ds SmallStrain() const;
@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FECore/mat3d.h"
 #include "FECore/tens6d.h"
 #include <FECore/log.h>
+#include <FECore/FEException.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -50,10 +51,9 @@ bool FEElasticMultiscaleDomain1O::Init()
 	FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
 	if (m_pMat == 0) return false;
 
-	// get the parent RVE
-	FERVEModel& rve = pmat->m_mrve;
-
 	// loop over all elements
+	// NOTE: The material point RVEs are solved with the RVE pool of the material,
+	//       so we don't need to create them here.
 	for (size_t i=0; i<m_Elem.size(); ++i)
 	{
 		FESolidElement& el = m_Elem[i];
@@ -63,11 +63,7 @@ bool FEElasticMultiscaleDomain1O::Init()
 			FEMaterialPoint& mp = *el.GetMaterialPoint(j);
 			FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 			FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
-
-			// create the material point RVEs
 			mmpt.m_F_prev = pt.m_F;	// TODO: I think I can remove this line
-			mmpt.m_rve.CopyFrom(rve);
-			if (mmpt.m_rve.Init() == false) return false;
 		}
 	}
 
@@ -83,9 +79,17 @@ bool FEElasticMultiscaleDomain1O::Init()
 			int ngp = p.m_ngp - 1;
 			if ((ngp>=0)&&(ngp<nint))
 			{
+				// probed points need their own RVE, since the probe tracks the RVE over time
 				FEMaterialPoint& mp = *pel->GetMaterialPoint(ngp);
 				FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
-				FERVEProbe* prve = new FERVEProbe(fem, mmpt.m_rve, p.m_szfile.c_str());
+				if (mmpt.m_rve == nullptr)
+				{
+					mmpt.m_rve = pmat->CreateRVE();
+					if (mmpt.m_rve == nullptr) return false;
+				}
+
+				FERVEProbe* prve = new FERVEProbe(fem, *mmpt.m_rve, p.m_szfile.c_str());
+				p.m_probe = prve;
 				prve->SetDebugFlag(p.m_bdebug);
 			}
 			else
@@ -103,3 +107,68 @@ bool FEElasticMultiscaleDomain1O::Init()
 
 	return true;
 }
+
+//-----------------------------------------------------------------------------
+//! Update the element stresses. This solves the RVE problems of all the integration
+//! points. Since the time it takes to solve an RVE problem can vary a lot between
+//! points, the elements are scheduled dynamically over the threads.
+void FEElasticMultiscaleDomain1O::Update(const FETimeInfo& tp)
+{
+	bool berr = false;
+	bool bfail = false;
+	int failElem = -1, failGpt = -1;
+	int NE = Elements();
+	#pragma omp parallel for schedule(dynamic) shared(NE, berr, bfail)
+	for (int i=0; i<NE; ++i)
+	{
+		try
+		{
+			FESolidElement& el = Element(i);
+			if (el.isActive())
+			{
+				UpdateElementStress(i, tp);
+			}
+		}
+		catch (NegativeJacobian e)
+		{
+			#pragma omp critical
+			{
+				berr = true;
+				if (e.DoOutput()) feLogError(e.what());
+			}
+		}
+		catch (FEMultiScaleException e)
+		{
+			#pragma omp critical
+			{
+				if (bfail == false)
+				{
+					bfail = true;
+					failElem = Element(i).GetID();
+					failGpt = e.gptIndex;
+				}
+			}
+		}
+	}
+
+	if (bfail)
+	{
+		// store all the probes
+		FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
+		int NP = pmat->Probes();
+		for (int i=0; i<NP; ++i)
+		{
+			FEMicroProbe& p = pmat->Probe(i);
+			if (p.m_probe && p.m_bdebug) p.m_probe->Save();
+		}
+
+		throw FEMultiScaleException(failElem, failGpt);
+	}
+
+	// if we encountered an error, we request a running restart
+	if (berr)
+	{
+		if (NegativeJacobian::DoOutput() == false) feLogError("Negative jacobian was detected.");
+		throw DoRunningRestart();
+	}
+}
@@ -442,10 +442,7 @@ void FEElasticShellDomain::ElementBodyForceStiffness(FEBodyForce& BF, FEShellEle
 void FEElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
 {
     // repeat over all shell elements
-    int NS = (int)m_Elem.size();
-#pragma omp parallel for shared (NS)
-    for (int iel=0; iel<NS; ++iel)
-    {
+    AssembleElements(LS, [&](int iel) {
 		FEShellElement& el = m_Elem[iel];
         
         // create the element's stiffness matrix
@@ -462,8 +459,9 @@ void FEElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
 		ke.SetIndices(lm);
         
         // assemble element matrix in global stiffness matrix
+		ke.SetScatterMap(ElementScatterMap(iel));
 		LS.Assemble(ke);
-    }
+    });
 }
 
 //-----------------------------------------------------------------------------
@@ -336,6 +336,27 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	// weights at gauss points
 	const double *gw = el.GaussWeights();
 
+	// evaluate the tangents at all integration points at once,
+	// unless the secant tangent is requested
+	// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
+	FEElasticMaterial* pme = (m_pMat->m_secant ? nullptr : dynamic_cast<FEElasticMaterial*>(m_pMat));
+	tens4ds Cb[FEElement::MAX_INTPOINTS];
+	if (pme)
+	{
+		FEMaterialPoint* mpb[FEElement::MAX_INTPOINTS];
+		mat3d Fb[FEElement::MAX_INTPOINTS];
+		double Jb[FEElement::MAX_INTPOINTS];
+		for (int n=0; n<nint; ++n)
+		{
+			mpb[n] = el.GetMaterialPoint(n);
+			FEElasticMaterialPoint& pt = *mpb[n]->ExtractData<FEElasticMaterialPoint>();
+			Fb[n] = pt.m_F;
+			Jb[n] = pt.m_J;
+		}
+		FEMaterialPointBatch pts = { nint, mpb, Fb, Jb };
+		pme->BatchTangent(pts, Cb);
+	}
+
 	// calculate element stiffness matrix
 	for (int n=0; n<nint; ++n)
 	{
@@ -343,12 +364,13 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 		detJt = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
 
 		// setup the material point
-		// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
 
 		// get the 'D' matrix
 //		tens4ds C = m_pMat->Tangent(mp);
-        tens4dmm C = m_pMat->m_secant ? m_pMat->SecantTangent(mp) : m_pMat->Tangent(mp);
+		tens4dmm C;
+		if (pme) C = Cb[n];
+		else C = m_pMat->m_secant ? m_pMat->SecantTangent(mp) : m_pMat->Tangent(mp);
 		C.extract(D);
 
 		// we only calculate the upper triangular part
@@ -411,11 +433,7 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 {
 	// repeat over all solid elements
-	int NE = Elements();
-	
-	#pragma omp parallel for shared (NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
+	AssembleElements(LS, [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		if (el.isActive()) {
@@ -446,9 +464,10 @@ void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 					ke[j][i] = ke[i][j];
 */
 			// assemble element matrix in global stiffness matrix
+			ke.SetScatterMap(ElementScatterMap(iel));
 			LS.Assemble(ke);
 		}
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
@@ -602,8 +621,13 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 		}
 	}
 
-	// loop over the integration points and calculate
-	// the stress at the integration point
+	// the material points and their deformation gradients, packed for the batch evaluation
+	const int NINT = FEElement::MAX_INTPOINTS;
+	FEMaterialPoint* mpb[NINT];
+	mat3d Fb[NINT], Ftb[NINT];
+	double Jb[NINT], Jtb[NINT];
+
+	// loop over the integration points and update the kinematics
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
@@ -639,20 +663,39 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 
         // update specialized material points
         m_pMat->UpdateSpecializedMaterialPoints(mp, tp);
-        
-		// calculate the stress at this material point
-        pt.m_s = m_pMat->Stress(mp);
+
+		mpb[n] = &mp;
+		Fb[n] = pt.m_F; Jb[n] = pt.m_J;
+		Ftb[n] = Ft; Jtb[n] = Jt;
+	}
+
+	// calculate the stresses at all integration points at once
+	FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
+	mat3ds sb[NINT];
+	if (pme)
+	{
+		FEMaterialPointBatch pts = { nint, mpb, Fb, Jb };
+		pme->BatchStress(pts, sb);
+	}
+	else
+	{
+		for (int n=0; n<nint; ++n) sb[n] = m_pMat->Stress(*mpb[n]);
+	}
+
+	for (int n=0; n<nint; ++n)
+	{
+		FEElasticMaterialPoint& pt = *(mpb[n]->ExtractData<FEElasticMaterialPoint>());
+		pt.m_s = sb[n];
         
         // adjust stress for strain energy conservation
         if (m_alphaf == 0.5) 
 		{
 			// evaluate strain energy at current time
 			FEElasticMaterialPoint et = pt;
-			et.m_F = Ft;
-			et.m_J = Jt;
+			et.m_F = Ftb[n];
+			et.m_J = Jtb[n];
 
 			// evaluate strain-energy density
-			FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
 			pt.m_Wt = pme->StrainEnergyDensity(et);
 
             mat3ds D = pt.RateOfDeformation();
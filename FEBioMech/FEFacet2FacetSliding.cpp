@@ -365,6 +365,9 @@ void FEFacet2FacetSliding::Activate()
 	// project primary surface onto secondary surface
 	ProjectSurface(m_ss, m_ms, true, m_breloc);
 
+	// the node relocation changes the reference geometry
+	if (m_breloc) GetFEModel()->GetMesh().ReferenceGeometryChanged();
+
 	if (m_btwo_pass) 
 	{
 		ProjectSurface(m_ms, m_ss, true);
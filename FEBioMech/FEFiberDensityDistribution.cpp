@@ -28,11 +28,59 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEFiberDensityDistribution.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEScalarValuator.h>
 
 #ifndef SQR
 #define SQR(x) ((x)*(x))
 #endif
 
+//-----------------------------------------------------------------------------
+bool FEFiberDensityDistribution::IsTimeInvariant()
+{
+	FEModel* fem = GetFEModel();
+	FEParameterList& pl = GetParameterList();
+	FEParamIterator it = pl.first();
+	for (int i = 0; i < pl.Parameters(); ++i, ++it)
+	{
+		FEParam& p = *it;
+		if (fem->GetLoadController(&p)) return false;
+
+		// math expressions may depend on time
+		// (vector parameters don't expose their valuator, so we assume the worst if they are not constant)
+		for (int j = 0; j < p.dim(); ++j)
+		{
+			if ((p.type() == FE_PARAM_DOUBLE_MAPPED) && dynamic_cast<FEMathValue*>(p.value<FEParamDouble>(j).valuator())) return false;
+			if ((p.type() == FE_PARAM_VEC3D_MAPPED) && (p.value<FEParamVec3>(j).isConst() == false)) return false;
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEFiberDensityDistribution::IsUniform()
+{
+	FEParameterList& pl = GetParameterList();
+	FEParamIterator it = pl.first();
+	for (int i = 0; i < pl.Parameters(); ++i, ++it)
+	{
+		FEParam& p = *it;
+		for (int j = 0; j < p.dim(); ++j)
+		{
+			switch (p.type())
+			{
+			case FE_PARAM_DOUBLE_MAPPED: if (p.value<FEParamDouble>(j).isConst() == false) return false; break;
+			case FE_PARAM_VEC3D_MAPPED : if (p.value<FEParamVec3  >(j).isConst() == false) return false; break;
+			case FE_PARAM_MAT3D_MAPPED : if (p.value<FEParamMat3d >(j).isConst() == false) return false; break;
+			case FE_PARAM_MAT3DS_MAPPED: if (p.value<FEParamMat3ds>(j).isConst() == false) return false; break;
+			default:
+				break;
+			}
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 // define the ellipsoidal fiber density distributionmaterial parameters
 BEGIN_FECORE_CLASS(FEEllipsodialFiberDensityDistribution, FEFiberDensityDistribution)
@@ -40,6 +40,13 @@ public:
     
     // Evaluation of fiber density along n0
     virtual double FiberDensity(FEMaterialPoint& mp, const vec3d& n0) = 0;
+
+	// Returns true if the fiber density does not change over time, i.e. none of the 
+	// parameters are load-controlled or defined by math expressions.
+	bool IsTimeInvariant();
+
+	// Returns true if the fiber density is the same at all material points
+	bool IsUniform();
 };
 
 //---------------------------------------------------------------------------
@@ -165,3 +165,139 @@ double FEFiberExpPowUncoupled::DevFiberStrainEnergyDensity(FEMaterialPoint& mp,
     
     return sed;
 }
+
+//-----------------------------------------------------------------------------
+// The sums over the fibers are evaluated in a single loop without any function calls
+// (except for pow and exp), so that the loops can be vectorized. Fibers that are not
+// in tension are included with a zero weight instead of being skipped. 
+mat3ds FEFiberExpPowUncoupled::DevFiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	// deformation gradient
+	double J = pt.m_J;
+	mat3d F = pt.m_F*pow(J,-1.0/3.0);
+
+	// deviatoric right Cauchy-Green tensor
+	mat3ds C = pt.DevRightCauchyGreen();
+	const double Cxx = C.xx(), Cyy = C.yy(), Czz = C.zz(), Cxy = C.xy(), Cyz = C.yz(), Cxz = C.xz();
+
+	const double ksi = m_ksi, alpha = m_alpha, beta = m_beta;
+
+	double sxx = 0.0, syy = 0.0, szz = 0.0, sxy = 0.0, syz = 0.0, sxz = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		const double x = nx[i], y = ny[i], z = nz[i];
+
+		// Calculate In = n0*C*n0
+		double In_1 = x*(Cxx*x + Cxy*y + Cxz*z) + y*(Cxy*x + Cyy*y + Cyz*z) + z*(Cxz*x + Cyz*y + Czz*z) - 1.0;
+
+		// only take fibers in tension into consideration
+		double t = (In_1 >= 0.0 ? In_1 : 0.0);
+		double Wl = ksi*pow(t, beta - 1.0)*exp(alpha*pow(t, beta));
+		Wl = (In_1 >= 0.0 ? Wl*w[i] : 0.0);
+
+		// global spatial fiber direction in current configuration
+		double ax = F[0][0]*x + F[0][1]*y + F[0][2]*z;
+		double ay = F[1][0]*x + F[1][1]*y + F[1][2]*z;
+		double az = F[2][0]*x + F[2][1]*y + F[2][2]*z;
+
+		sxx += Wl*ax*ax; syy += Wl*ay*ay; szz += Wl*az*az;
+		sxy += Wl*ax*ay; syz += Wl*ay*az; sxz += Wl*ax*az;
+	}
+
+	mat3ds s = mat3ds(sxx, syy, szz, sxy, syz, sxz)*(2.0/J);
+
+	return s.dev();
+}
+
+//-----------------------------------------------------------------------------
+// Since the deviatoric projection of the fiber tangent is linear in the fiber stress and 
+// tangent, it is applied once to the sums instead of to each fiber.
+tens4ds FEFiberExpPowUncoupled::DevFiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	// deformation gradient
+	double J = pt.m_J;
+	mat3d F = pt.m_F*pow(J,-1.0/3.0);
+
+	// deviatoric right Cauchy-Green tensor
+	mat3ds C = pt.DevRightCauchyGreen();
+	const double Cxx = C.xx(), Cyy = C.yy(), Czz = C.zz(), Cxy = C.xy(), Cyz = C.yz(), Cxz = C.xz();
+
+	const double ksi = m_ksi, alpha = m_alpha, beta = m_beta;
+
+	double sxx = 0.0, syy = 0.0, szz = 0.0, sxy = 0.0, syz = 0.0, sxz = 0.0;
+	double d[tens4ds::NNZ] = { 0 };
+	for (int i = 0; i < n; ++i)
+	{
+		const double x = nx[i], y = ny[i], z = nz[i];
+
+		// Calculate In = n0*C*n0
+		double In_1 = x*(Cxx*x + Cxy*y + Cxz*z) + y*(Cxy*x + Cyy*y + Cyz*z) + z*(Cxz*x + Cyz*y + Czz*z) - 1.0;
+
+		// only take fibers in tension into consideration
+		double t = (In_1 >= 0.0 ? In_1 : 0.0);
+		double tmp = alpha*pow(t, beta);
+		double Wl = ksi*pow(t, beta - 1.0)*exp(tmp);
+		double Wll = ksi*pow(t, beta - 2.0)*((tmp + 1)*beta - 1.0)*exp(tmp);
+		Wl  = (In_1 >= 0.0 ? Wl *w[i] : 0.0);
+		Wll = (In_1 >= 0.0 ? Wll*w[i] : 0.0);
+
+		// global spatial fiber direction in current configuration
+		double ax = F[0][0]*x + F[0][1]*y + F[0][2]*z;
+		double ay = F[1][0]*x + F[1][1]*y + F[1][2]*z;
+		double az = F[2][0]*x + F[2][1]*y + F[2][2]*z;
+
+		// add N and N dyad1s N, where N = a dyad a 
+		const double N[6] = { ax*ax, ay*ay, az*az, ax*ay, ay*az, ax*az };
+		sxx += Wl*N[0]; syy += Wl*N[1]; szz += Wl*N[2];
+		sxy += Wl*N[3]; syz += Wl*N[4]; sxz += Wl*N[5];
+		for (int k = 0, l = 0; k < 6; ++k)
+			for (int m = 0; m <= k; ++m, ++l) d[l] += Wll*N[m]*N[k];
+	}
+
+	// fiber stress and tangent
+	mat3ds s = mat3ds(sxx, syy, szz, sxy, syz, sxz)*(2.0/J);
+	tens4ds c;
+	const double f = 4.0/J;
+	for (int l = 0; l < tens4ds::NNZ; ++l) c.d[l] = d[l]*f;
+
+	// This is the final value of the elasticity tensor
+	mat3dd I(1);
+	tens4ds IxI = dyad1s(I);
+	tens4ds I4  = dyad4s(I);
+	c += ((I4+IxI/3.0)*s.tr() - dyad1s(I,s))*(2./3.)
+	- (ddots(IxI, c)-IxI*(c.tr()/3.))/3.;
+
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+double FEFiberExpPowUncoupled::DevFiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	// deviatoric right Cauchy-Green tensor
+	mat3ds C = pt.DevRightCauchyGreen();
+	const double Cxx = C.xx(), Cyy = C.yy(), Czz = C.zz(), Cxy = C.xy(), Cyz = C.yz(), Cxz = C.xz();
+
+	const double ksi = m_ksi, alpha = m_alpha, beta = m_beta;
+
+	double sed = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		const double x = nx[i], y = ny[i], z = nz[i];
+
+		// Calculate In = n0*C*n0
+		double In_1 = x*(Cxx*x + Cxy*y + Cxz*z) + y*(Cxy*x + Cyy*y + Cyz*z) + z*(Cxz*x + Cyz*y + Czz*z) - 1.0;
+
+		// only take fibers in tension into consideration
+		double t = (In_1 >= 0.0 ? In_1 : 0.0);
+		double Wi = (alpha > 0 ? ksi/(alpha*beta)*(exp(alpha*pow(t, beta)) - 1) : ksi/beta*pow(t, beta));
+		sed += (In_1 >= 0.0 ? Wi*w[i] : 0.0);
+	}
+
+	return sed;
+}
@@ -46,6 +46,11 @@ public:
 	
 	//! Strain energy density
 	virtual double DevFiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& a0) override;
+
+	//! weighted sums over a set of fibers
+	mat3ds DevFiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w) override;
+	tens4ds DevFiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w) override;
+	double DevFiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w) override;
     
 protected:
 	double	m_alpha;	// coefficient of (In-1) in exponential
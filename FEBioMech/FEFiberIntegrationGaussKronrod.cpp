@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEFiberIntegrationGaussKronrod.h"
 #include "gausskronrod.h"
+#include <limits>
 #include <FECore/log.h>
 
 #ifndef SQR
@@ -144,6 +144,11 @@ void FEFiberIntegrationGeodesic::InitIntegrationRule()
 		m_sph[n] = sin(phi[n]);
 		m_w[n] = w[n];
 	}
+
+	// store the integration points in the table
+	ClearTable();
+	for (int n=0; n<m_nint; ++n)
+		AddTablePoint(vec3d(m_cth[n]*m_sph[n], m_sth[n]*m_sph[n], m_cph[n]), m_w[n]);
 }
 
 //-----------------------------------------------------------------------------
@@ -32,3 +32,21 @@ SOFTWARE.*/
 FEFiberIntegrationScheme::FEFiberIntegrationScheme(FEModel* pfem) : FEMaterial(pfem)
 {
 }
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationScheme::ClearTable()
+{
+	m_nx.clear();
+	m_ny.clear();
+	m_nz.clear();
+	m_wn.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationScheme::AddTablePoint(const vec3d& n, double w)
+{
+	m_nx.push_back(n.x);
+	m_ny.push_back(n.y);
+	m_nz.push_back(n.z);
+	m_wn.push_back(w);
+}
@@ -60,6 +60,8 @@ public:
 // for the FEBio input file. The code will use the GetIterator function to create an
 // iterator that can be used to loop over all the integration points of the scheme and to
 // evaluate the fiber vector and weights at each point.
+// Schemes whose integration points do not depend on the material point also store the
+// fiber vectors and weights in a table, which can be used instead of the iterator. 
 class FEFiberIntegrationScheme : public FEMaterial
 {
 public:
@@ -69,4 +71,26 @@ public:
 	// In general, the integration scheme may depend on the material point.
 	// The passed material point pointer will be zero when evaluating the integrated fiber density
 	virtual FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp = 0) = 0;
+
+public:
+	// Number of integration points in the table. 
+	// This is zero if the integration points depend on the material point, in which case the iterator must be used.
+	int IntegrationPoints() const { return (int) m_wn.size(); }
+
+	// fiber vector components and weights of the integration points in the table
+	const double* FiberX() const { return &m_nx[0]; }
+	const double* FiberY() const { return &m_ny[0]; }
+	const double* FiberZ() const { return &m_nz[0]; }
+	const double* Weights() const { return &m_wn[0]; }
+
+protected:
+	// clear the table of integration points
+	void ClearTable();
+
+	// add an integration point to the table
+	void AddTablePoint(const vec3d& n, double w);
+
+private:
+	std::vector<double>	m_nx, m_ny, m_nz;	// fiber vector components
+	std::vector<double>	m_wn;				// integration weights
 };
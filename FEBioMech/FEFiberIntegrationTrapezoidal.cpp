@@ -100,6 +100,43 @@ FEFiberIntegrationTrapezoidal::~FEFiberIntegrationTrapezoidal()
 {
 }
 
+//-----------------------------------------------------------------------------
+bool FEFiberIntegrationTrapezoidal::Init()
+{
+	// initialize integration rule data
+	InitIntegrationRule();
+
+	// also initialize the parent class
+	return FEFiberIntegrationScheme::Init();
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationTrapezoidal::Serialize(DumpStream& ar)
+{
+	FEFiberIntegrationScheme::Serialize(ar);
+	if (ar.IsSaving() == false)
+	{
+		InitIntegrationRule();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// The table stores the same integration points as the iterator.
+void FEFiberIntegrationTrapezoidal::InitIntegrationRule()
+{
+	double pi = 4 * atan(1.0);
+	double dth = pi / m_nth;  // integrate from 0 to pi
+
+	ClearTable();
+	for (int i=0; i<m_nth; ++i)
+	{
+		double theta = i*dth;
+
+		// Multiply by 2 since fibers along theta+pi have same stress as along theta
+		AddTablePoint(vec3d(cos(theta), sin(theta), 0.0), dth*2.0);
+	}
+}
+
 //-----------------------------------------------------------------------------
 FEFiberIntegrationSchemeIterator* FEFiberIntegrationTrapezoidal::GetIterator(FEMaterialPoint* mp)
 {
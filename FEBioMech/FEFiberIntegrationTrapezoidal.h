@@ -40,8 +40,17 @@ public:
     FEFiberIntegrationTrapezoidal(FEModel* pfem);
     ~FEFiberIntegrationTrapezoidal();
 
+	//! Initialization
+	bool Init() override;
+    
+	// serialization
+	void Serialize(DumpStream& ar) override;
+
 	// get iterator	
 	FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp) override;
+
+protected:
+	void InitIntegrationRule();
     
 private:
     int             m_nth;  // number of trapezoidal integration points along theta
@@ -358,6 +358,11 @@ void FEFiberIntegrationTriangle::InitIntegrationRule()
             }
             break;
     }
+
+	// store the integration points in the table
+	ClearTable();
+	for (int n=0; n<m_nint; ++n)
+		AddTablePoint(vec3d(m_cth[n]*m_sph[n], m_sth[n]*m_sph[n], m_cph[n]), m_w[n]);
 }
 
 //-----------------------------------------------------------------------------
@@ -26,4 +26,34 @@ SOFTWARE.*/
 
 
 
+#include "stdafx.h"
 #include "FEFiberMaterialPoint.h"
+
+//-----------------------------------------------------------------------------
+FEFiberMaterialPoint::FEFiberMaterialPoint(FEMaterialPoint* pt) : FEMaterialPoint(pt)
+{
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPoint* FEFiberMaterialPoint::Copy()
+{
+	FEFiberMaterialPoint* pt = new FEFiberMaterialPoint(*this);
+	if (m_pNext) pt->m_pNext = m_pNext->Copy();
+	return pt;
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberMaterialPoint::Init()
+{
+	FEMaterialPoint::Init();
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+// The fiber weights are not stored since they are re-evaluated when needed.
+void FEFiberMaterialPoint::Serialize(DumpStream& ar)
+{
+	FEMaterialPoint::Serialize(ar);
+	if (ar.IsShallow() == false) m_bvalid = false;
+}
@@ -28,3 +28,26 @@ SOFTWARE.*/
 
 #pragma once
 #include "FECore/FEMaterial.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Material point data for continuous fiber distributions. 
+//! This stores the weights of the fibers of the integration table, i.e. the 
+//! integration weight multiplied by the fiber density and divided by the integrated 
+//! fiber density. If the fiber density does not change over time, the weights are
+//! only evaluated once. 
+class FEFiberMaterialPoint : public FEMaterialPoint
+{
+public:
+	FEFiberMaterialPoint(FEMaterialPoint* pt = 0);
+
+	FEMaterialPoint* Copy() override;
+
+	void Init() override;
+
+	void Serialize(DumpStream& ar) override;
+
+public:
+	std::vector<double>	m_wR;		//!< fiber weights
+	bool				m_bvalid;	//!< the fiber weights were evaluated and can be reused
+};
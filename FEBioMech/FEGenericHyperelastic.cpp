@@ -88,6 +88,15 @@ bool FEGenericHyperelastic::Init()
 	string sWJJ = o2s.Convert(m_WJJ); feLog("WJJ = %s\n", sWJJ.c_str());
 #endif
 
+	// compile the derivatives that are needed for the stress and tangent
+	if (m_dW.Compile({ &m_W1, &m_W2, &m_WJ }) == false) return false;
+	if (m_d2W.Compile({ &m_W1, &m_W2, &m_WJ, &m_W11, &m_W22, &m_W12, &m_WJJ }) == false) return false;
+	for (int i = 0; i < (int)m_param.size(); ++i)
+	{
+		m_dW.BindVariable(3 + i, m_param[i]);
+		m_d2W.BindVariable(3 + i, m_param[i]);
+	}
+
 	return FEElasticMaterial::Init();
 }
 
@@ -104,12 +113,13 @@ mat3ds FEGenericHyperelastic::Stress(FEMaterialPoint& mp)
 	double I1 = B.tr();
 	double I2 = 0.5*(I1*I1 - B2.tr());
 
-	vector<double> v = { I1, I2, J };
-	for (int i = 0; i < m_param.size(); ++i) v.push_back(*m_param[i]);
-
-	double W1 = m_W1.value_s(v);
-	double W2 = m_W2.value_s(v);
-	double WJ = m_WJ.value_s(v);
+	// evaluate the strain energy derivatives
+	double v[3] = { I1, I2, J };
+	double dW[3];
+	m_dW.value(v, dW);
+	double W1 = dW[0];
+	double W2 = dW[1];
+	double WJ = dW[2];
 
 	mat3dd I(1.0);
 
@@ -131,18 +141,17 @@ tens4ds FEGenericHyperelastic::Tangent(FEMaterialPoint& mp)
 	double I1 = B.tr();
 	double I2 = 0.5*(I1*I1 - B2.tr());
 
-	vector<double> v = { I1, I2, J };
-	for (int i = 0; i < m_param.size(); ++i) v.push_back(*m_param[i]);
-
-	double W1 = m_W1.value_s(v);
-	double W2 = m_W2.value_s(v);
-	double WJ = m_WJ.value_s(v);
-
-	double W11 = m_W11.value_s(v);
-	double W22 = m_W22.value_s(v);
-	double W12 = m_W12.value_s(v);
-
-	double WJJ = m_WJJ.value_s(v);
+	// evaluate the strain energy derivatives
+	double v[3] = { I1, I2, J };
+	double d2W[7];
+	m_d2W.value(v, d2W);
+	double W1 = d2W[0];
+	double W2 = d2W[1];
+	double WJ = d2W[2];
+	double W11 = d2W[3];
+	double W22 = d2W[4];
+	double W12 = d2W[5];
+	double WJJ = d2W[6];
 
 	mat3dd I(1.0);
 	tens4ds IxI = dyad1s(I);
@@ -26,6 +26,7 @@ SOFTWARE.*/
 #pragma once
 #include "FEElasticMaterial.h"
 #include <FECore/MathObject.h>
+#include <FECore/MCompiledExpression.h>
 
 //! Hyperelastic material, defined by strain energy function. 
 //! This case only considers the strain energy function to be a function of
@@ -62,5 +63,9 @@ private:
 	MSimpleExpression	m_W22;
 	MSimpleExpression	m_WJJ;
 
+	// compiled derivatives
+	MCompiledExpression	m_dW;	// first derivatives (for the stress)
+	MCompiledExpression	m_d2W;	// first and second derivatives (for the tangent)
+
 	DECLARE_FECORE_CLASS();
 };
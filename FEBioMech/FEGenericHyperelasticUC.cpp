@@ -85,6 +85,15 @@ bool FEGenericHyperelasticUC::Init()
 		string sW22 = o2s.Convert(m_W22); feLog("W22 = %s\n", sW22.c_str());
 	}
 
+	// compile the derivatives that are needed for the stress and tangent
+	if (m_dW.Compile({ &m_W1, &m_W2 }) == false) return false;
+	if (m_d2W.Compile({ &m_W1, &m_W2, &m_W11, &m_W22, &m_W12 }) == false) return false;
+	for (int i = 0; i < (int)m_param.size(); ++i)
+	{
+		m_dW.BindVariable(2 + i, m_param[i]);
+		m_d2W.BindVariable(2 + i, m_param[i]);
+	}
+
 	return FEUncoupledMaterial::Init();
 }
 
@@ -107,11 +116,12 @@ mat3ds FEGenericHyperelasticUC::DevStress(FEMaterialPoint& mp)
 	double I1 = B.tr();
 	double I2 = 0.5*(I1*I1 - B2.tr());
 
-	// get strain energy derivatives
-	vector<double> v = { I1, I2 };
-	for (int i = 0; i < m_param.size(); ++i) v.push_back(*m_param[i]);
-	double W1 = m_W1.value_s(v);
-	double W2 = m_W2.value_s(v);
+	// evaluate the strain energy derivatives
+	double v[2] = { I1, I2 };
+	double dW[2];
+	m_dW.value(v, dW);
+	double W1 = dW[0];
+	double W2 = dW[1];
 
 	// calculate T = F*dW/dC*Ft
 	mat3ds T = B*(W1 + W2*I1) - B2*W2;
@@ -140,15 +150,15 @@ tens4ds FEGenericHyperelasticUC::DevTangent(FEMaterialPoint& mp)
 	double I1 = B.tr();
 	double I2 = 0.5*(I1*I1 - B2.tr());
 
-	// get strain energy derivatives
-	vector<double> v = { I1, I2 };
-	for (int i = 0; i < m_param.size(); ++i) v.push_back(*m_param[i]);
-	double W1 = m_W1.value_s(v);
-	double W2 = m_W2.value_s(v);
-
-	double W11 = m_W11.value_s(v);
-	double W22 = m_W22.value_s(v);
-	double W12 = m_W12.value_s(v);
+	// evaluate the strain energy derivatives
+	double v[2] = { I1, I2 };
+	double d2W[5];
+	m_d2W.value(v, d2W);
+	double W1 = d2W[0];
+	double W2 = d2W[1];
+	double W11 = d2W[2];
+	double W22 = d2W[3];
+	double W12 = d2W[4];
 
 	// define fourth-order tensors
 	mat3dd I(1.0);
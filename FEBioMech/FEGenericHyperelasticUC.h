@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 #pragma once
 #include "FEUncoupledMaterial.h"
+#include <FECore/MCompiledExpression.h>
 
 class FEGenericHyperelasticUC : public FEUncoupledMaterial
 {
@@ -58,5 +59,9 @@ private:
 	MSimpleExpression	m_W12;
 	MSimpleExpression	m_W22;
 
+	// compiled derivatives
+	MCompiledExpression	m_dW;	// first derivatives (for the stress)
+	MCompiledExpression	m_d2W;	// first and second derivatives (for the tangent)
+
 	DECLARE_FECORE_CLASS();
 };
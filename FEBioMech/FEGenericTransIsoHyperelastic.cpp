@@ -117,6 +117,15 @@ bool FEGenericTransIsoHyperelastic::Init()
 	string sWJJ = o2s.Convert(m_WJJ); feLog("WJJ = %s\n", sWJJ.c_str());
 #endif
 
+	// compile the derivatives that are needed for the stress and tangent
+	if (m_dW.Compile({ &m_W1, &m_W2, &m_W4, &m_W5, &m_WJ }) == false) return false;
+	if (m_d2W.Compile({ &m_W1, &m_W2, &m_W4, &m_W5, &m_WJ, &m_W11, &m_W12, &m_W14, &m_W15, &m_W22, &m_W24, &m_W25, &m_W44, &m_W45, &m_W55, &m_WJJ }) == false) return false;
+	for (int i = 0; i < (int)m_param.size(); ++i)
+	{
+		m_dW.BindVariable(5 + i, m_param[i]);
+		m_d2W.BindVariable(5 + i, m_param[i]);
+	}
+
 	return FEElasticMaterial::Init();
 }
 
@@ -143,16 +152,15 @@ mat3ds FEGenericTransIsoHyperelastic::Stress(FEMaterialPoint& mp)
 	double I4 = lam*lam;
 	double I5 = I4*(a*(B*a));
 
-	// create the parameter list
-	vector<double> v = { I1, I2, I4, I5, J };
-	for (int i = 0; i < m_param.size(); ++i) v.push_back(*m_param[i]);
-
 	// evaluate the strain energy derivatives
-	double W1 = m_W1.value_s(v);
-	double W2 = m_W2.value_s(v);
-	double W4 = m_W4.value_s(v);
-	double W5 = m_W5.value_s(v);
-	double WJ = m_WJ.value_s(v);
+	double v[5] = { I1, I2, I4, I5, J };
+	double dW[5];
+	m_dW.value(v, dW);
+	double W1 = dW[0];
+	double W2 = dW[1];
+	double W4 = dW[2];
+	double W5 = dW[3];
+	double WJ = dW[4];
 
 	mat3dd I(1.0);
 	mat3ds AxA = dyad(a);
@@ -187,29 +195,26 @@ tens4ds FEGenericTransIsoHyperelastic::Tangent(FEMaterialPoint& mp)
 	double I4 = lam*lam;
 	double I5 = I4*(a*(B*a));
 
-	// evaluate parameters
-	vector<double> v = { I1, I2, I4, I5, J };
-	for (int i = 0; i < m_param.size(); ++i) v.push_back(*m_param[i]);
-
-	// evaluate strain energy derivatives
-	double W1 = m_W1.value_s(v);
-	double W2 = m_W2.value_s(v);
-	double W4 = m_W4.value_s(v);
-	double W5 = m_W5.value_s(v);
-	double WJ = m_WJ.value_s(v);
-
-	double W11 = m_W11.value_s(v);
-	double W12 = m_W12.value_s(v);
-	double W14 = m_W14.value_s(v);
-	double W15 = m_W15.value_s(v);
-	double W22 = m_W22.value_s(v);
-	double W24 = m_W24.value_s(v);
-	double W25 = m_W25.value_s(v);
-	double W44 = m_W44.value_s(v);
-	double W45 = m_W45.value_s(v);
-	double W55 = m_W55.value_s(v);
-
-	double WJJ = m_WJJ.value_s(v);
+	// evaluate the strain energy derivatives
+	double v[5] = { I1, I2, I4, I5, J };
+	double d2W[16];
+	m_d2W.value(v, d2W);
+	double W1 = d2W[0];
+	double W2 = d2W[1];
+	double W4 = d2W[2];
+	double W5 = d2W[3];
+	double WJ = d2W[4];
+	double W11 = d2W[5];
+	double W12 = d2W[6];
+	double W14 = d2W[7];
+	double W15 = d2W[8];
+	double W22 = d2W[9];
+	double W24 = d2W[10];
+	double W25 = d2W[11];
+	double W44 = d2W[12];
+	double W45 = d2W[13];
+	double W55 = d2W[14];
+	double WJJ = d2W[15];
 
 	mat3dd I(1.0);
 	tens4ds IxI = dyad1s(I);
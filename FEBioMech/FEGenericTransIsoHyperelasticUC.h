@@ -26,6 +26,7 @@ SOFTWARE.*/
 #pragma once
 #include "FEUncoupledMaterial.h"
 #include <FECore/MathObject.h>
+#include <FECore/MCompiledExpression.h>
 
 //! Uncoupled transversely isotropic Hyperelastic material, defined by strain energy function. 
 //! This case assumes the strain energy function to be a function of
@@ -72,5 +73,9 @@ private:
 	MSimpleExpression	m_W45;
 	MSimpleExpression	m_W55;
 
+	// compiled derivatives
+	MCompiledExpression	m_dW;	// first derivatives (for the stress)
+	MCompiledExpression	m_d2W;	// first and second derivatives (for the tangent)
+
 	DECLARE_FECORE_CLASS();
 };
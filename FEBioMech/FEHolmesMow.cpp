@@ -108,6 +108,57 @@ tens4ds FEHolmesMow::Tangent(FEMaterialPoint& mp)
 	return c;
 }
 
+//-----------------------------------------------------------------------------
+void FEHolmesMow::BatchStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	mat3ds identity(1.,1.,1.,0.,0.,0.);
+
+	// calculate stress (see Stress)
+	for (int i=0; i<pts.n; ++i)
+	{
+		double detFi = 1.0/pts.J[i];
+
+		mat3ds b = pts.LeftCauchyGreen(i);
+		mat3ds b2 = b.sqr();
+
+		double I1 = b.tr();
+		double I2 = (I1*I1 - b2.tr())/2.;
+		double I3 = b.det();
+
+		double eQ = exp(m_b*((2*mu-lam)*(I1-3) + lam*(I2-3))/Ha)/pow(I3,m_b);
+
+		s[i] = 0.5*detFi*eQ*((2*mu+lam*(I1-1))*b - lam*b2 - Ha*identity);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEHolmesMow::BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c)
+{
+	mat3ds identity(1.,1.,1.,0.,0.,0.);
+	tens4ds I4 = dyad4s(identity);
+
+	// calculate tangent (see Tangent)
+	for (int i=0; i<pts.n; ++i)
+	{
+		double detF = pts.J[i];
+		double detFi = 1.0/detF;
+
+		mat3ds b = pts.LeftCauchyGreen(i);
+		mat3ds b2 = b.sqr();
+
+		double I1 = b.tr();
+		double I2 = (I1*I1 - b2.tr())*0.5;
+		double I3 = b.det();
+
+		double eQ = exp(m_b*((2*mu-lam)*(I1-3) + lam*(I2-3))/Ha)/pow(I3,m_b);
+
+		mat3ds s = 0.5*detFi*eQ*((2*mu+lam*(I1-1))*b - lam*b2 - Ha*identity);
+
+		c[i] = 4.*m_b/Ha*detF/eQ*dyad1s(s) 
+		+ detFi*eQ*(lam*(dyad1s(b) - dyad4s(b)) + Ha*I4);
+	}
+}
+
 //-----------------------------------------------------------------------------
 double FEHolmesMow::StrainEnergyDensity(FEMaterialPoint& mp)
 {
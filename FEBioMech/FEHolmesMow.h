@@ -52,6 +52,12 @@ public:
 		
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt) override;
+
+	//! calculate stress at a batch of material points
+	void BatchStress(const FEMaterialPointBatch& pts, mat3ds* s) override;
+
+	//! calculate tangent stiffness at a batch of material points
+	void BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c) override;
     
 	//! data initialization and checking
 	bool Validate() override;
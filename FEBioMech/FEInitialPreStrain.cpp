@@ -110,5 +110,8 @@ void FEInitialPreStrain::Activate()
 			node.set(dofY, 0.0);
 			node.set(dofZ, 0.0);
 		}
+
+		// let the domains know that the reference geometry has changed
+		mesh.ReferenceGeometryChanged();
 	}
 }
@@ -85,6 +85,48 @@ tens4ds FEIsotropicElastic::Tangent(FEMaterialPoint& mp)
 	return dyad1s(b)*lam + dyad4s(b)*(2.0*mu);
 }
 
+//-----------------------------------------------------------------------------
+void FEIsotropicElastic::BatchStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	// lame parameters (without the 1/J factor)
+	double lam0 = m_v*m_E/((1+m_v)*(1-2*m_v));
+	double mu0  = 0.5*m_E/(1+m_v);
+
+	// calculate stress (see Stress)
+	for (int i=0; i<pts.n; ++i)
+	{
+		double Ji = 1.0 / pts.J[i];
+		double lam = Ji*lam0;
+		double mu  = Ji*mu0;
+
+		mat3ds b = pts.LeftCauchyGreen(i);
+		double trE = 0.5*(b.tr()-3);
+		mat3ds b2 = b.sqr();
+
+		s[i] = b*(lam*trE - mu) + b2*mu;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEIsotropicElastic::BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c)
+{
+	// lame parameters (without the 1/J factor)
+	double lam0 = m_v*m_E/((1+m_v)*(1-2*m_v));
+	double mu0  = 0.5*m_E/(1+m_v);
+
+	// calculate tangent (see Tangent)
+	for (int i=0; i<pts.n; ++i)
+	{
+		double Ji = 1.0 / pts.J[i];
+		double lam = Ji*lam0;
+		double mu  = Ji*mu0;
+
+		mat3ds b = pts.LeftCauchyGreen(i);
+
+		c[i] = dyad1s(b)*lam + dyad4s(b)*(2.0*mu);
+	}
+}
+
 //-----------------------------------------------------------------------------
 double FEIsotropicElastic::StrainEnergyDensity(FEMaterialPoint& mp)
 {
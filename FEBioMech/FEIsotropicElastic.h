@@ -48,6 +48,12 @@ public:
 
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt) override;
+
+	//! calculate stress at a batch of material points
+	void BatchStress(const FEMaterialPointBatch& pts, mat3ds* s) override;
+
+	//! calculate tangent stiffness at a batch of material points
+	void BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c) override;
     
     //! calculate the 2nd Piola-Kirchhoff stress at material point
     mat3ds PK2Stress(FEMaterialPoint& pt, const mat3ds E) override;
@@ -37,6 +37,7 @@ SOFTWARE.*/
 #include "FEBioPlot/FEBioPlotFile.h"
 #include <FECore/mat6d.h>
 #include "FEBCPrescribedDeformation.h"
+#include <FECore/sys.h>
 #include <sstream>
 
 //=============================================================================
@@ -91,6 +92,17 @@ FEMicroMaterialPoint::FEMicroMaterialPoint(FEMaterialPoint* mp) : FEMaterialPoin
 	
 	m_macro_energy_inc = 0.;
 	m_micro_energy_inc = 0.;
+
+	m_Ca.zero();
+	m_PK1.zero();
+
+	m_rve = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEMicroMaterialPoint::~FEMicroMaterialPoint()
+{
+	delete m_rve;
 }
 
 //-----------------------------------------------------------------------------
@@ -181,6 +193,7 @@ FEMicroMaterial::FEMicroMaterial(FEModel* pfem) : FEElasticMaterial(pfem)
 //-----------------------------------------------------------------------------
 FEMicroMaterial::~FEMicroMaterial(void)
 {
+	for (size_t i = 0; i < m_pool.size(); ++i) delete m_pool[i];
 }
 
 //-----------------------------------------------------------------------------
@@ -215,9 +228,85 @@ bool FEMicroMaterial::Init()
 		feLogError("An error occurred preparing RVE model"); return false;
 	}
 
+	// create the RVE pool
+	for (size_t i = 0; i < m_pool.size(); ++i) delete m_pool[i];
+	m_pool.clear();
+	m_inuse.clear();
+	int nt = omp_get_max_threads();
+	if (nt < 1) nt = 1;
+	for (int i = 0; i < nt; ++i)
+	{
+		FERVEModel* rve = CreateRVE();
+		if (rve == nullptr) {
+			feLogError("An error occurred preparing RVE model"); return false;
+		}
+		m_pool.push_back(rve);
+		m_inuse.push_back(0);
+	}
+
+	// all material point RVEs start from this state
+	m_pool[0]->SaveState(m_state0);
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+FERVEModel* FEMicroMaterial::CreateRVE()
+{
+	FERVEModel* rve = new FERVEModel;
+	rve->CopyFrom(m_mrve);
+	if (rve->Init() == false)
+	{
+		delete rve;
+		return nullptr;
+	}
+	return rve;
+}
+
+//-----------------------------------------------------------------------------
+// The pool RVEs are handed out to whichever thread asks for one, so this does not 
+// depend on the thread numbers (which are not unique in nested parallel regions). 
+// When all RVEs are in use a new one is added to the pool.
+FERVEModel* FEMicroMaterial::AcquireRVE()
+{
+	FERVEModel* rve = nullptr;
+	#pragma omp critical (FEMicroMaterial_pool)
+	{
+		for (size_t i = 0; i < m_pool.size(); ++i)
+		{
+			if (m_inuse[i] == 0)
+			{
+				m_inuse[i] = 1;
+				rve = m_pool[i];
+				break;
+			}
+		}
+
+		if (rve == nullptr)
+		{
+			rve = CreateRVE();
+			if (rve)
+			{
+				m_pool.push_back(rve);
+				m_inuse.push_back(1);
+			}
+		}
+	}
+	return rve;
+}
+
+//-----------------------------------------------------------------------------
+void FEMicroMaterial::ReleaseRVE(FERVEModel* rve)
+{
+	#pragma omp critical (FEMicroMaterial_pool)
+	{
+		for (size_t i = 0; i < m_pool.size(); ++i)
+		{
+			if (m_pool[i] == rve) { m_inuse[i] = 0; break; }
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 // Note that this function is not used in the first-order implemenetation
 mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
@@ -226,22 +315,56 @@ mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
 	mat3d F = pt.m_F;
-	
-	// update the BC's
-	mmpt.m_rve.Update(F);
 
-	// solve the RVE
-	bool bret = mmpt.m_rve.Solve();
+	// Unless this point has its own RVE, we restore the state of the
+	// point's RVE in an RVE of the pool.
+	FERVEModel* rve = mmpt.m_rve;
+	bool bpool = (rve == nullptr);
+	if (bpool)
+	{
+		rve = AcquireRVE();
+		if (rve == nullptr) throw FEMultiScaleException(-1, -1);
+	}
+
+	mat3ds sa;
+	try {
+		if (bpool)
+		{
+			const std::vector<char>& state = (mmpt.m_rveState.empty() ? m_state0 : mmpt.m_rveState);
+			if (rve->RestoreState(state) == false) throw FEMultiScaleException(-1, -1);
+		}
 
-	// make sure it converged
-	if (bret == false) throw FEMultiScaleException(-1, -1);
+		// update the BC's
+		rve->Update(F);
+
+		// solve the RVE
+		bool bret = rve->Solve();
+
+		// make sure it converged
+		if (bret == false) throw FEMultiScaleException(-1, -1);
+
+		// calculate the averaged Cauchy stress
+		sa = rve->StressAverage(mp);
+
+		// calculate the difference between the macro and micro energy for Hill-Mandel condition
+		mmpt.m_micro_energy = micro_energy(*rve);
+
+		// The pool RVE will be used for other points, so we evaluate
+		// the stiffness and PK1 stress here as well.
+		mmpt.m_Ca = rve->StiffnessAverage(mp);
+		mmpt.m_PK1 = AveragedStressPK1(*rve, mp);
+
+		// store the new state
+		if (bpool) rve->SaveState(mmpt.m_rveState);
+	}
+	catch (...)
+	{
+		// make sure the RVE goes back to the pool
+		if (bpool) ReleaseRVE(rve);
+		throw;
+	}
+	if (bpool) ReleaseRVE(rve);
 
-	// calculate the averaged Cauchy stress
-	mat3ds sa = mmpt.m_rve.StressAverage(mp);
-	
-	// calculate the difference between the macro and micro energy for Hill-Mandel condition
-	mmpt.m_micro_energy = micro_energy(mmpt.m_rve);	
-	
 	return sa;
 }
 
@@ -252,7 +375,7 @@ mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
 tens4ds FEMicroMaterial::Tangent(FEMaterialPoint &mp)
 {
 	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
-	return mmpt.m_rve.StiffnessAverage(mp);
+	return mmpt.m_Ca;
 }
 
 //-----------------------------------------------------------------------------
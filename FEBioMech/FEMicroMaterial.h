@@ -66,6 +66,7 @@ class FEMicroMaterialPoint : public FEMaterialPoint
 public:
 	//! constructor
 	FEMicroMaterialPoint(FEMaterialPoint* mp);
+	~FEMicroMaterialPoint();
 
 	//! Initialize material point data
 	void Init();
@@ -90,7 +91,11 @@ public:
 	double	   m_macro_energy_inc;	// Macroscopic strain energy increment
 	double	   m_micro_energy_inc;	// Microscopic strain energy increment
 
-	FERVEModel	m_rve;				// Local copy of the parent rve
+	tens4ds		m_Ca;				// averaged stiffness of the RVE solution
+	mat3d		m_PK1;				// averaged PK1 stress of the RVE solution
+
+	std::vector<char>	m_rveState;	// solution state of this point's RVE
+	FERVEModel*	m_rve;				// RVE of this point (only allocated for probed points)
 };
 
 //-----------------------------------------------------------------------------
@@ -154,6 +159,15 @@ public:
 	// average RVE energy
 	double micro_energy(FEModel& rve);
 
+	//! create a copy of the parent RVE
+	FERVEModel* CreateRVE();
+
+	//! get an RVE from the pool that is not in use (the pool grows if needed)
+	FERVEModel* AcquireRVE();
+
+	//! return an RVE to the pool
+	void ReleaseRVE(FERVEModel* rve);
+
 public:
 	int Probes() { return (int) m_probe.size(); }
 	FEMicroProbe& Probe(int i) { return *m_probe[i]; }
@@ -161,6 +175,13 @@ public:
 protected:
 	std::vector<FEMicroProbe*>	m_probe;
 
+	// The material points don't have their own RVE, but only store the solution state
+	// of their RVE. The RVE problems are solved with the RVEs of this pool, which starts
+	// with one RVE per thread.
+	std::vector<FERVEModel*>	m_pool;		//!< the RVEs that solve the material point problems
+	std::vector<char>			m_inuse;	//!< flags the pool RVEs that are in use
+	std::vector<char>			m_state0;	//!< initial state of the material point RVEs
+
 public:
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
@@ -137,6 +137,89 @@ tens4ds FEMooneyRivlin::DevTangent(FEMaterialPoint& mp)
 	return c;
 }
 
+//-----------------------------------------------------------------------------
+//! Calculate the deviatoric stress at a batch of points
+void FEMooneyRivlin::BatchDevStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	const int n = pts.n;
+	assert(n <= FEMaterialPointBatch::MAX_POINTS);
+
+	// get material parameters first, so that the loop below has no function calls
+	double c1[FEMaterialPointBatch::MAX_POINTS], c2[FEMaterialPointBatch::MAX_POINTS];
+	for (int i=0; i<n; ++i)
+	{
+		c1[i] = m_c1(*pts.mp[i]);
+		c2[i] = m_c2(*pts.mp[i]);
+	}
+
+	// calculate the deviatoric stress (see DevStress)
+	for (int i=0; i<n; ++i)
+	{
+		double J = pts.J[i];
+
+		mat3ds B = pts.DevLeftCauchyGreen(i);
+		mat3ds B2 = B.sqr();
+		double I1 = B.tr();
+
+		double W1 = c1[i];
+		double W2 = c2[i];
+
+		mat3ds T = B*(W1 + W2*I1) - B2*W2;
+		s[i] = T.dev()*(2.0/J);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Calculate the deviatoric tangent at a batch of points
+void FEMooneyRivlin::BatchDevTangent(const FEMaterialPointBatch& pts, tens4ds* c)
+{
+	const int n = pts.n;
+	assert(n <= FEMaterialPointBatch::MAX_POINTS);
+
+	// get material parameters and the deviatoric stress first, 
+	// so that the loop below has no function calls
+	double c1[FEMaterialPointBatch::MAX_POINTS], c2[FEMaterialPointBatch::MAX_POINTS];
+	mat3ds devs[FEMaterialPointBatch::MAX_POINTS];
+	for (int i=0; i<n; ++i)
+	{
+		FEMaterialPoint& mp = *pts.mp[i];
+		c1[i] = m_c1(mp);
+		c2[i] = m_c2(mp);
+		devs[i] = mp.ExtractData<FEElasticMaterialPoint>()->m_s.dev();
+	}
+
+	// Identity tensor
+	mat3ds I(1,1,1,0,0,0);
+	tens4ds IxI = dyad1s(I);
+	tens4ds I4  = dyad4s(I);
+
+	// calculate the deviatoric tangent (see DevTangent)
+	for (int i=0; i<n; ++i)
+	{
+		double J = pts.J[i];
+		double Ji = 1.0/J;
+
+		mat3ds B = pts.DevLeftCauchyGreen(i);
+		mat3ds B2 = B.sqr();
+		double I1 = B.tr();
+		double I2 = 0.5*(I1*I1 - B2.tr());
+
+		double W1 = c1[i];
+		double W2 = c2[i];
+
+		double WC = W1*I1 + 2*W2*I2;
+		double CWWC = 2*I2*W2;
+
+		tens4ds BxB = dyad1s(B);
+		tens4ds B4  = dyad4s(B);
+
+		mat3ds WCCxC = B*(W2*I1) - B2*W2;
+
+		tens4ds cw = (BxB - B4)*(W2*4.0*Ji) - dyad1s(WCCxC, I)*(4.0/3.0*Ji) + IxI*(4.0/9.0*Ji*CWWC);
+		c[i] = dyad1s(devs[i], I)*(-2.0/3.0) + (I4 - IxI/3.0)*(4.0/3.0*Ji*WC) + cw;
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! calculate deviatoric strain energy density
 double FEMooneyRivlin::DevStrainEnergyDensity(FEMaterialPoint& mp)
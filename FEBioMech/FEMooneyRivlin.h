@@ -51,6 +51,12 @@ public:
 
 	//! calculate deviatoric strain energy density
 	double DevStrainEnergyDensity(FEMaterialPoint& mp) override;
+
+	//! calculate deviatoric stress at a batch of material points
+	void BatchDevStress(const FEMaterialPointBatch& pts, mat3ds* s) override;
+
+	//! calculate deviatoric tangent stiffness at a batch of material points
+	void BatchDevTangent(const FEMaterialPointBatch& pts, tens4ds* c) override;
     
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
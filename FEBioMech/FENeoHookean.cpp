@@ -95,6 +95,71 @@ tens4ds FENeoHookean::Tangent(FEMaterialPoint& mp)
 	return tens4ds(D);
 }
 
+//-----------------------------------------------------------------------------
+void FENeoHookean::BatchStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	const int n = pts.n;
+	assert(n <= FEMaterialPointBatch::MAX_POINTS);
+
+	// evaluate the lame parameters first, so that the loop below has no function calls
+	double lam[FEMaterialPointBatch::MAX_POINTS], mu[FEMaterialPointBatch::MAX_POINTS];
+	for (int i=0; i<n; ++i)
+	{
+		double E = m_E(*pts.mp[i]);
+		double v = m_v(*pts.mp[i]);
+		lam[i] = v*E/((1+v)*(1-2*v));
+		mu [i] = 0.5*E/(1+v);
+	}
+
+	// Identity
+	mat3dd I(1);
+
+	// calculate stress (see Stress)
+	for (int i=0; i<n; ++i)
+	{
+		double detF = pts.J[i];
+		double detFi = 1.0/detF;
+		double lndetF = log(detF);
+
+		mat3ds b = pts.LeftCauchyGreen(i);
+
+		s[i] = (b - I)*(mu[i]*detFi) + I*(lam[i]*lndetF*detFi);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FENeoHookean::BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c)
+{
+	const int n = pts.n;
+	assert(n <= FEMaterialPointBatch::MAX_POINTS);
+
+	// evaluate the lame parameters first, so that the loop below has no function calls
+	double lam[FEMaterialPointBatch::MAX_POINTS], mu[FEMaterialPointBatch::MAX_POINTS];
+	for (int i=0; i<n; ++i)
+	{
+		double E = m_E(*pts.mp[i]);
+		double v = m_v(*pts.mp[i]);
+		lam[i] = v*E/((1+v)*(1-2*v));
+		mu [i] = 0.5*E/(1+v);
+	}
+
+	// calculate tangent (see Tangent)
+	for (int i=0; i<n; ++i)
+	{
+		double detF = pts.J[i];
+		double lam1 = lam[i] / detF;
+		double mu1  = (mu[i] - lam[i]*log(detF)) / detF;
+
+		double* d = c[i].d;
+		d[ 0] = lam1+2.*mu1;
+		d[ 1] = lam1; d[ 2] = lam1+2.*mu1;
+		d[ 3] = lam1; d[ 4] = lam1; d[ 5] = lam1+2.*mu1;
+		d[ 6] = 0; d[ 7] = 0; d[ 8] = 0; d[ 9] = mu1;
+		d[10] = 0; d[11] = 0; d[12] = 0; d[13] = 0; d[14] = mu1;
+		d[15] = 0; d[16] = 0; d[17] = 0; d[18] = 0; d[19] = 0; d[20] = mu1;
+	}
+}
+
 //-----------------------------------------------------------------------------
 double FENeoHookean::StrainEnergyDensity(FEMaterialPoint& mp)
 {
@@ -199,6 +199,151 @@ tens4ds FEOgdenMaterial::DevTangent(FEMaterialPoint& mp)
     return c;
 }
 
+//-----------------------------------------------------------------------------
+//! Calculates the deviatoric stress at a batch of material points.
+//! The eigen decompositions are done first, so that the loop that evaluates the 
+//! Ogden terms has no function calls (other than pow). Terms with a zero coefficient
+//! do not contribute and are skipped.
+void FEOgdenMaterial::BatchDevStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	const int n = pts.n;
+	assert(n <= FEMaterialPointBatch::MAX_POINTS);
+
+	// get the eigenvalues and eigenvectors of the deviatoric left Cauchy-Green tensors
+	double lam[FEMaterialPointBatch::MAX_POINTS][3];
+	vec3d ev[FEMaterialPointBatch::MAX_POINTS][3];
+	for (int i=0; i<n; ++i)
+	{
+		mat3ds b = pts.DevLeftCauchyGreen(i);
+		double lam2[3];
+		EigenValues(b, lam2, ev[i], m_eps);
+		lam[i][0] = sqrt(lam2[0]);
+		lam[i][1] = sqrt(lam2[1]);
+		lam[i][2] = sqrt(lam2[2]);
+	}
+
+	// collect the nonzero terms
+	int nt = 0;
+	double c[MAX_TERMS], m[MAX_TERMS];
+	for (int j=0; j<MAX_TERMS; ++j)
+		if (m_c[j] != 0) { c[nt] = m_c[j]; m[nt] = m_m[j]; nt++; }
+
+	// principal stresses
+	double T[FEMaterialPointBatch::MAX_POINTS][3];
+	for (int i=0; i<n; ++i)
+	{
+		double J = pts.J[i];
+		for (int k=0; k<3; ++k)
+		{
+			T[i][k] = 0;
+			for (int j=0; j<nt; ++j)
+				T[i][k] += c[j]/m[j]*(pow(lam[i][k], m[j]) - 1)/J;
+		}
+	}
+
+	// stress
+	for (int i=0; i<n; ++i)
+	{
+		mat3ds si;
+		si.zero();
+		for (int k=0; k<3; ++k) si += dyad(ev[i][k])*T[i][k];
+		s[i] = si.dev();
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates the deviatoric tangent at a batch of material points (see DevTangent).
+void FEOgdenMaterial::BatchDevTangent(const FEMaterialPointBatch& pts, tens4ds* ct)
+{
+	const int n = pts.n;
+	assert(n <= FEMaterialPointBatch::MAX_POINTS);
+
+	// get the eigenvalues and eigenvectors of the deviatoric left Cauchy-Green tensors
+	double lam2[FEMaterialPointBatch::MAX_POINTS][3];
+	vec3d ev[FEMaterialPointBatch::MAX_POINTS][3];
+	for (int i=0; i<n; ++i)
+	{
+		mat3ds b = pts.DevLeftCauchyGreen(i);
+		EigenValues(b, lam2[i], ev[i], m_eps);
+	}
+
+	// collect the nonzero terms
+	int nt = 0;
+	double c[MAX_TERMS], m[MAX_TERMS];
+	for (int j=0; j<MAX_TERMS; ++j)
+		if (m_c[j] != 0) { c[nt] = m_c[j]; m[nt] = m_m[j]; nt++; }
+
+	mat3dd I(1.0);
+	tens4ds IxI = dyad1s(I);
+	tens4ds I4  = dyad4s(I);
+
+	for (int p=0; p<n; ++p)
+	{
+		double J = pts.J[p];
+
+		// get the eigenvalues of V
+		double lam[3];
+		mat3ds N[3];
+		for (int i=0; i<3; ++i) {
+			lam[i] = sqrt(lam2[p][i]);
+			N[i] = dyad(ev[p][i]);
+		}
+
+		// calculate the powers of eigenvalues
+		double lamp[3][MAX_TERMS];
+		for (int j=0; j<nt; ++j)
+		{
+			lamp[0][j] = pow(lam[0], m[j]);
+			lamp[1][j] = pow(lam[1], m[j]);
+			lamp[2][j] = pow(lam[2], m[j]);
+		}
+
+		// principal stresses
+		mat3ds s;
+		s.zero();
+		double T[3];
+		for (int i=0; i<3; ++i) {
+			T[i] = 0;
+			for (int j=0; j<nt; ++j)
+				T[i] += c[j]/m[j]*(lamp[i][j] - 1)/J;
+			s += N[i]*T[i];
+		}
+
+		// coefficients appearing in elasticity tensor
+		double D[3][3],E[3][3];
+		for (int j=0; j<3; ++j) {
+			D[j][j] = 0;
+			for (int k=0; k<nt; ++k)
+				D[j][j] += c[k]/m[k]*((m[k]-2)*lamp[j][k]+2)/J;
+			for (int i=j+1; i<3; ++i) {
+				D[i][j] = 0;
+				if (lam2[p][j] != lam2[p][i])
+					E[i][j] = 2*(lam2[p][j]*T[i] - lam2[p][i]*T[j])/(lam2[p][i]-lam2[p][j]);
+				else {
+					E[i][j] = 0;
+					for (int k=0; k<nt; ++k)
+						E[i][j] += c[k]/m[k]*((m[k]-2)*lamp[j][k]+2)/J;
+				}
+			}
+		}
+
+		// spatial elasticity tensor
+		tens4ds cp(0.0);
+		for (int j=0; j<3; ++j) {
+			cp += dyad1s(N[j])*D[j][j];
+			for (int i=j+1; i<3; ++i) {
+				cp += dyad1s(N[i],N[j])*D[i][j];
+				cp += dyad4s(N[i],N[j])*E[i][j];
+			}
+		}
+
+		cp += - 1./3.*(ddots(cp,IxI) - IxI*(cp.tr()/3.))
+		+ 2./3.*((I4-IxI/3.)*s.tr()-dyad1s(s.dev(),I));
+
+		ct[p] = cp;
+	}
+}
+
 //-----------------------------------------------------------------------------
 double FEOgdenMaterial::DevStrainEnergyDensity(FEMaterialPoint& mp)
 {
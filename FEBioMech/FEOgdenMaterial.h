@@ -45,6 +45,12 @@ public:
 
 	//! calculate the deviatoric strain energy density
 	double DevStrainEnergyDensity(FEMaterialPoint& pt) override;
+
+	//! calculate the deviatoric stress at a batch of material points
+	void BatchDevStress(const FEMaterialPointBatch& pts, mat3ds* s) override;
+
+	//! calculate the deviatoric tangent at a batch of material points
+	void BatchDevTangent(const FEMaterialPointBatch& pts, tens4ds* c) override;
     
 protected:
 	void EigenValues(mat3ds& A, double l[3], vec3d r[3], const double eps = 0);
@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include "FEElasticMaterial.h"
 #include "FEPeriodicBoundary1O.h"
 #include "FECore/FEAnalysis.h"
+#include "FECore/FETimeStepController.h"
 #include "FECore/FELoadCurve.h"
 #include "FEBCPrescribedDeformation.h"
 #include "FESolidSolver2.h"
@@ -43,7 +44,12 @@ SOFTWARE.*/
 #include <FECore/FECoreKernel.h>
 
 //-----------------------------------------------------------------------------
-FERVEModel::FERVEModel()
+// The states are restored in the pool RVEs of the micro materials, which have
+// solved other material points before. A state-only snapshot would leave the 
+// data of the previous point in the fields that it skips (e.g. the total solver
+// displacements, the material point velocities, or the contact penalties), so the 
+// RVE records its full shallow state.
+FERVEModel::FERVEModel() : m_snapshot(*this, false)
 {
 	m_bctype = DISPLACEMENT;
 }
@@ -67,6 +73,45 @@ void FERVEModel::CopyFrom(FERVEModel& rve)
 	m_BN = rve.m_BN;
 }
 
+//-----------------------------------------------------------------------------
+void FERVEModel::SaveState(std::vector<char>& buf)
+{
+	m_snapshot.Save();
+	m_snapshot.CopyTo(buf);
+}
+
+//-----------------------------------------------------------------------------
+bool FERVEModel::RestoreState(const std::vector<char>& buf)
+{
+	m_snapshot.CopyFrom(buf);
+	return m_snapshot.Restore();
+}
+
+//-----------------------------------------------------------------------------
+// The RVE continues from its last solution each time it is solved, so besides
+// the model state, a shallow copy also needs the current step, the start time
+// and the time step controllers in order to restore an RVE.
+void FERVEModel::Serialize(DumpStream& ar)
+{
+	FEModel::Serialize(ar);
+	if (ar.IsShallow() == false) return;
+
+	int nstep = GetCurrentStepIndex();
+	double t0 = GetStartTime();
+	ar & nstep & t0;
+	if (ar.IsLoading())
+	{
+		SetCurrentStepIndex(nstep);
+		SetStartTime(t0);
+	}
+
+	for (int i = 0; i < Steps(); ++i)
+	{
+		FETimeStepController* tc = GetStep(i)->m_timeController;
+		if (tc) tc->Serialize(ar);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! Initializes the RVE model and evaluates some useful quantities.
 bool FERVEModel::InitRVE(int rveType, const char* szbc)
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "FECore/FEModel.h"
 #include <FECore/tens4d.h>
+#include <FECore/FEStateSnapshot.h>
 
 class FEBCPrescribedDeformation;
 
@@ -76,6 +77,16 @@ public:
 	//! Calculate the stiffness average
 	tens4ds StiffnessAverage(FEMaterialPoint &mp);
 
+	//! save the solution state of the RVE to a buffer
+	void SaveState(std::vector<char>& buf);
+
+	//! restore the solution state of the RVE from a buffer
+	//! The state can be from any copy of the same parent RVE.
+	bool RestoreState(const std::vector<char>& buf);
+
+	//! serialize data
+	void Serialize(DumpStream& ar) override;
+
 protected:
 	//! Calculate the initial volume
 	void EvalInitialVolume();
@@ -95,4 +106,6 @@ private:
 	int				m_bctype;			//!< RVE type
 	FEBoundingBox	m_bb;				//!< bounding box of mesh
 	vector<int>		m_BN;				//!< boundary node flags
+
+	FEStateSnapshot	m_snapshot;			//!< used for saving and restoring the solution state
 };
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEReactiveVEMaterialPoint.h"
 #include "FEElasticMaterial.h"
+#include <assert.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -50,10 +51,7 @@ FEMaterialPoint* FEReactiveVEMaterialPoint::Copy()
 void FEReactiveVEMaterialPoint::Init()
 {
 	// initialize data to zero
-	m_Fi.clear();
-	m_Ji.clear();
-	m_v.clear();
-	m_w.clear();
+	ClearGenerations();
     
     // don't forget to initialize the base class
     FEMaterialPoint::Init();
@@ -67,22 +65,20 @@ void FEReactiveVEMaterialPoint::Update(const FETimeInfo& timeInfo)
 
 	// check if the current deformation gradient is different from that of
 	// the last generation, in which case store the current state
+	// NOTE: the reforming bond mass fraction depends on the new generation, 
+	//       so it is evaluated after the generation is added.
 	if (m_pRve) {
 	    if (m_pRve->NewGeneration(*this)) {
-		    m_Fi.push_back(pt.m_F.inverse());
-	        m_Ji.push_back(1./pt.m_J);
-			m_v.push_back(timeInfo.currentTime);
-			double w = m_pRve->ReformingBondMassFraction(*this);
-			m_w.push_back(w);
+			AddGeneration(pt.m_F.inverse(), 1./pt.m_J, timeInfo.currentTime, 0.0);
+			LastGeneration().w = m_pRve->ReformingBondMassFraction(*this);
+			m_pRve->LimitGenerations(*this);
 		}
 	}
 	else {
 		if (m_pRuc->NewGeneration(*this)) {
-			m_Fi.push_back(pt.m_F.inverse());
-			m_Ji.push_back(1./pt.m_J);
-			m_v.push_back(timeInfo.currentTime);
-			double w = m_pRuc->ReformingBondMassFraction(*this);
-			m_w.push_back(w);
+			AddGeneration(pt.m_F.inverse(), 1./pt.m_J, timeInfo.currentTime, 0.0);
+			LastGeneration().w = m_pRuc->ReformingBondMassFraction(*this);
+			m_pRuc->LimitGenerations(*this);
 		}
 	}
     
@@ -90,6 +86,57 @@ void FEReactiveVEMaterialPoint::Update(const FETimeInfo& timeInfo)
     FEMaterialPoint::Update(timeInfo);
 }
 
+//-----------------------------------------------------------------------------
+void FEReactiveVEMaterialPoint::AddGeneration(const mat3d& Fi, double Ji, double v, double w)
+{
+	// make room at the end of the buffer
+	if (m_g0 + m_ng == (int)m_gen.size())
+	{
+		if ((m_g0 > 0) && (m_g0 >= m_ng))
+		{
+			// move the generations to the front of the buffer
+			for (int i = 0; i < m_ng; ++i) m_gen[i] = m_gen[m_g0 + i];
+			m_g0 = 0;
+		}
+		else m_gen.resize(m_gen.empty() ? 8 : 2 * m_gen.size());
+	}
+
+	Generation& g = m_gen[m_g0 + m_ng];
+	g.Fi = Fi;
+	g.Ji = Ji;
+	g.v = v;
+	g.w = w;
+	m_ng++;
+}
+
+//-----------------------------------------------------------------------------
+void FEReactiveVEMaterialPoint::RemoveOldestGeneration()
+{
+	assert(m_ng > 0);
+	m_g0++;
+	m_ng--;
+	if (m_ng == 0) m_g0 = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FEReactiveVEMaterialPoint::ClearGenerations()
+{
+	m_g0 = 0;
+	m_ng = 0;
+}
+
+//-----------------------------------------------------------------------------
+//! Merge generation ig into generation ig+1, which keeps its deformation gradient 
+//! and time, and gets the mass fraction w.
+void FEReactiveVEMaterialPoint::MergeGeneration(int ig, double w)
+{
+	assert((ig >= 0) && (ig < m_ng - 1));
+	Generation* g = &m_gen[m_g0];
+	g[ig + 1].w = w;
+	for (int i = ig; i > 0; --i) g[i] = g[i - 1];
+	RemoveOldestGeneration();
+}
+
 //-----------------------------------------------------------------------------
 //! Serialize data to the archive
 void FEReactiveVEMaterialPoint::Serialize(DumpStream& ar)
@@ -98,18 +145,25 @@ void FEReactiveVEMaterialPoint::Serialize(DumpStream& ar)
     
     if (ar.IsSaving())
     {
-        int n = (int)m_Fi.size();
+        int n = m_ng;
         ar << n;
-        for (int i=0; i<n; ++i) ar << m_Fi[i] << m_Ji[i] << m_v[i] << m_w[i];
+        for (int i=0; i<n; ++i)
+		{
+			Generation& g = GetGeneration(i);
+			ar << g.Fi << g.Ji << g.v << g.w;
+		}
     }
     else
     {
         int n;
         ar >> n;
-		m_Fi.resize(n);
-		m_Ji.resize(n);
-		m_v.resize(n);
-		m_w.resize(n);
-        for (int i=0; i<n; ++i) ar >> m_Fi[i] >> m_Ji[i] >> m_v[i] >> m_w[i];
+		ClearGenerations();
+		if ((int)m_gen.size() < n) m_gen.resize(n);
+		m_ng = n;
+        for (int i=0; i<n; ++i)
+		{
+			Generation& g = GetGeneration(i);
+			ar >> g.Fi >> g.Ji >> g.v >> g.w;
+		}
     }
 }
@@ -30,19 +30,33 @@ SOFTWARE.*/
 #include "FECore/FEMaterialPoint.h"
 #include "FEReactiveViscoelastic.h"
 #include "FEUncoupledReactiveViscoelastic.h"
-#include <deque>
+#include <vector>
 
 class FEReactiveViscoelasticMaterial;
 class FEUncoupledReactiveViscoelasticMaterial;
 
 //-----------------------------------------------------------------------------
 //! Material point data for reactive viscoelastic materials
+//! The bond generations are stored oldest first in a contiguous window of a buffer.
+//! New generations are added at the end of the window and culled generations are
+//! removed from its front. The window is moved back to the front of the buffer
+//! when the buffer is full, so the buffer only grows when at least half of it is in use.
 class FEReactiveVEMaterialPoint : public FEMaterialPoint
 {
+public:
+	//! data of a generation of bonds
+	struct Generation
+	{
+		mat3d	Fi;		//!< inverse of relative deformation gradient
+		double	Ji;		//!< determinant of Fi (store for efficiency)
+		double	v;		//!< time when generation starts breaking
+		double	w;		//!< mass fraction when generation starts breaking
+	};
+
 public:
     //! olverloaded constructors
-    FEReactiveVEMaterialPoint(FEMaterialPoint *pt, FEReactiveViscoelasticMaterial *pe) : FEMaterialPoint(pt) { m_pRve = pe; m_pRuc = 0; }
-    FEReactiveVEMaterialPoint(FEMaterialPoint *pt, FEUncoupledReactiveViscoelasticMaterial *pe) : FEMaterialPoint(pt) { m_pRve = 0; m_pRuc = pe; }
+    FEReactiveVEMaterialPoint(FEMaterialPoint *pt, FEReactiveViscoelasticMaterial *pe) : FEMaterialPoint(pt) { m_pRve = pe; m_pRuc = 0; m_g0 = 0; m_ng = 0; }
+    FEReactiveVEMaterialPoint(FEMaterialPoint *pt, FEUncoupledReactiveViscoelasticMaterial *pe) : FEMaterialPoint(pt) { m_pRve = 0; m_pRuc = pe; m_g0 = 0; m_ng = 0; }
     
     //! copy material point data
     FEMaterialPoint* Copy();
@@ -55,13 +69,36 @@ public:
     
     //! Serialize data to archive
     void Serialize(DumpStream& ar);
+
+public:
+	//! number of generations
+	int Generations() const { return m_ng; }
+
+	//! get a generation (zero is the oldest generation)
+	Generation& GetGeneration(int i) { return m_gen[m_g0 + i]; }
+	const Generation& GetGeneration(int i) const { return m_gen[m_g0 + i]; }
+
+	//! the newest generation
+	Generation& LastGeneration() { return m_gen[m_g0 + m_ng - 1]; }
+
+	//! add a new generation
+	void AddGeneration(const mat3d& Fi, double Ji, double v, double w);
+
+	//! remove the oldest generation
+	void RemoveOldestGeneration();
+
+	//! merge a generation into the next generation, which gets mass fraction w
+	void MergeGeneration(int ig, double w);
+
+	//! remove all generations
+	void ClearGenerations();
     
 public:
-    // multigenerational material data
-    deque <mat3d>  m_Fi;	//!< inverse of relative deformation gradient
-    deque <double> m_Ji;	//!< determinant of Fi (store for efficiency)
-    deque <double> m_v;     //!< time when generation starts breaking
-    deque <double> m_w;     //!< mass fraction when generation starts breaking
     FEReactiveViscoelasticMaterial*  m_pRve; //!< pointer to parent material
     FEUncoupledReactiveViscoelasticMaterial*  m_pRuc; //!< pointer to parent material
+
+private:
+	std::vector<Generation>	m_gen;	//!< generation buffer
+	int		m_g0;		//!< index of oldest generation in buffer
+	int		m_ng;		//!< number of generations
 };
@@ -68,6 +68,9 @@ public:
     //! cull generations
     void CullGenerations(FEMaterialPoint& pt);
     
+    //! merge generations when there are more than the max nr of generations
+    void LimitGenerations(FEMaterialPoint& pt);
+    
     //! evaluate bond mass fraction for a given generation
     double BreakingBondMassFraction(FEMaterialPoint& pt, const int ig, const mat3ds D);
     
@@ -89,6 +92,7 @@ public:
     double	m_wmin;		//!< minimum value of relaxation
     int     m_btype;    //!< bond kinetics type
     int     m_ttype;    //!< bond breaking trigger type
+    int     m_nmax;     //!< max nr of generations (0 = no limit)
     
     DECLARE_FECORE_CLASS();
 };
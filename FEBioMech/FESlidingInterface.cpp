@@ -54,7 +54,9 @@ void FESlidingSurface::FESlidingPoint::Serialize(DumpStream& ar)
 {
 	FEContactMaterialPoint::Serialize(ar);
 
-	ar & m_gap & m_nu & m_eps & m_off;
+	// the penalty and offset are only set when the interface is activated
+	ar & m_gap & m_nu;
+	if (ar.IsStateOnly() == false) ar & m_eps & m_off;
 	ar & m_rs & m_rsp;
 	ar & m_Lm & m_Lt & m_Ln;
 	ar & m_M;
@@ -473,6 +475,9 @@ void FESlidingInterface::Activate()
 	ProjectSurface(m_ss, m_ms, true, m_breloc);
 	if (m_bautopen) CalcAutoPenalty(m_ss);
 
+	// the node relocation changes the reference geometry
+	if (m_breloc) GetFEModel()->GetMesh().ReferenceGeometryChanged();
+
 	// for two-pass algorithms we repeat the previous
 	// two steps with primary and secondary surface switched
 	if (m_btwo_pass && (m_bself_contact == false))
@@ -496,19 +501,25 @@ void FESlidingInterface::Activate()
 
 void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface& ms, bool bupseg, bool bmove)
 {
-	// node projection data
-	double r, s;
-	vec3d q;
-
 	FEClosestPointProjection cpp(ms);
 	cpp.SetTolerance(m_stol);
 	cpp.SetSearchRadius(m_sradius);
 	cpp.HandleSpecialCases(true);
 	cpp.Init();
 
+	// Each node only modifies its own data, so we can process the nodes in parallel.
+	// The exception is when nodes are moved onto a self-contacting surface, since
+	// then later projections depend on the nodes that were already moved.
+	bool bparallel = ((bmove && m_bself_contact) == false);
+
 	// loop over all primary surface nodes
+#pragma omp parallel for schedule(dynamic, 64) if (bparallel)
 	for (int i=0; i<ss.Nodes(); ++i)
 	{
+		// node projection data
+		double r, s;
+		vec3d q;
+
 		// get the node
 		FENode& node = ss.Node(i);
 
@@ -536,6 +536,10 @@ void FESlidingInterfaceBW::ProjectSurface(FESlidingSurfaceBW& ss, FESlidingSurfa
         }
     }
     
+    // update the broad phase of the contact search, so that we can skip
+    // the points that are too far from the secondary surface
+    if (bupseg) ss.UpdateContactCandidates(ms, R, m_stol);
+
     // loop over all integration points
 #pragma omp parallel for schedule(dynamic)
     for (int i=0; i<ss.Elements(); ++i)
@@ -575,7 +579,7 @@ void FESlidingInterfaceBW::ProjectSurface(FESlidingSurfaceBW& ss, FESlidingSurfa
             }
             
             // find the intersection point with the secondary surface
-            if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+            if (pme == 0 && bupseg && ss.IsContactCandidate(i)) pme = np.Project(r, nu, rs);
             
             data.m_pme = pme;
             data.m_nu = nu;
@@ -647,8 +651,11 @@ void FESlidingInterfaceBW::Update()
     // this will update the gap functions as well
     static bool bfirst = true;
     ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+    // the node relocation changes the reference geometry
+    if (m_breloc && bfirst) GetFEModel()->GetMesh().ReferenceGeometryChanged();
     bfirst = false;
     if (m_btwo_pass) ProjectSurface(m_ms, m_ss, bupseg);
+    ReportContactSearch(m_ss, m_ms);
     
 	int nsolve_iter = GetFEModel()->GetCurrentStep()->GetFESolver()->m_niter;
     if (nsolve_iter == 0)
@@ -89,6 +89,7 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 		//	if (m_fem.m_DC.size() > 0)
 		{
 			SparseMatrix& K = m_K;
+			bool batomic = K.AtomicAssembly();
 
 			int N = ke.rows();
 
@@ -109,8 +110,12 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 						if (I >= 0)
 						{
 							// dof i is not a prescribed degree of freedom
-							#pragma omp atomic
-							m_F[I] -= ke[i][j] * ui[J];
+							if (batomic)
+							{
+								#pragma omp atomic
+								m_F[I] -= ke[i][j] * ui[J];
+							}
+							else m_F[I] -= ke[i][j] * ui[J];
 						}
 					}
 
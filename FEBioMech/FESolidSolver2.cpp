@@ -48,6 +48,7 @@ SOFTWARE.*/
 #include <FECore/FEModelLoad.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/vector.h>
+#include <FECore/FEProfiler.h>
 #include "FESolidLinearSystem.h"
 #include "FEBioMech.h"
 
@@ -270,13 +271,16 @@ void FESolidSolver2::Serialize(DumpStream& ar)
 	ar & m_alphaf;
 	ar & m_alpham;
 
-	ar & m_Ut & m_Ui;
+	// The total displacement increment is zeroed at the start of each time step,
+	// so it is not part of the solution state
+	ar & m_Ut;
+	if (ar.IsStateOnly() == false) ar & m_Ui;
 
 	ar & m_arcLength;
 	ar & m_al_scale;
 	ar & m_al_lam & m_al_inc;// &m_al_ds;
 
-	if (ar.IsLoading())
+	if (ar.IsLoading() && (ar.IsStateOnly() == false))
 	{
 		m_Fn.assign(m_neq, 0);
 		m_Fr.assign(m_neq, 0);
@@ -1076,6 +1080,7 @@ bool FESolidSolver2::StiffnessMatrix()
 	{
 		if (mesh.Domain(i).IsActive()) 
 		{
+			FE_PROFILE_DOMAIN("stiffness", &mesh.Domain(i));
 			FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
 			dom.StiffnessMatrix(LS);
 		}
@@ -1168,7 +1173,11 @@ void FESolidSolver2::ContactStiffness(FELinearSystem& LS)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+		if (pci->IsActive())
+		{
+			FE_PROFILE_SCOPE("contact stiffness", pci);
+			pci->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -1181,7 +1190,11 @@ void FESolidSolver2::ContactForces(FEGlobalVector& R)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->LoadVector(R, tp);
+		if (pci->IsActive())
+		{
+			FE_PROFILE_SCOPE("contact forces", pci);
+			pci->LoadVector(R, tp);
+		}
 	}
 }
 
@@ -1280,6 +1293,7 @@ void FESolidSolver2::InternalForces(FEGlobalVector& R)
 		FESolidMaterial* mat = dynamic_cast<FESolidMaterial*>(dom.GetMaterial());
 		if ((mat == nullptr) || (mat->IsRigid() == false))
 		{
+			FE_PROFILE_DOMAIN("internal forces", &dom);
 			FEElasticDomain& edom = dynamic_cast<FEElasticDomain&>(dom);
 			edom.InternalForces(R);
 		}
@@ -184,6 +184,9 @@ void FETiedInterface::Activate()
 
 	// project primary surface onto secondary surface
 	ProjectSurface(ss, ms, m_breloc);
+
+	// the node relocation changes the reference geometry
+	if (m_breloc) GetFEModel()->GetMesh().ReferenceGeometryChanged();
 }
 
 //-----------------------------------------------------------------------------
@@ -98,6 +98,48 @@ tens4ds FEUncoupledMaterial::Tangent(FEMaterialPoint &mp)
 	return DevTangent(mp) + (IxI - I4*2)*p + IxI*(UJJ(pt.m_J)*pt.m_J);
 }
 
+//-----------------------------------------------------------------------------
+//! Same as Stress, but for a batch of material points
+void FEUncoupledMaterial::BatchStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	BatchDevStress(pts, s);
+	for (int i=0; i<pts.n; ++i) s[i] = mat3dd(UJ(pts.J[i])) + s[i];
+}
+
+//-----------------------------------------------------------------------------
+//! Same as Tangent, but for a batch of material points
+void FEUncoupledMaterial::BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c)
+{
+	BatchDevTangent(pts, c);
+
+	// 2nd-order identity tensor
+	mat3dd I(1);
+
+	// 4th-order identity tensors
+	tens4ds IxI = dyad1s(I);
+	tens4ds I4  = dyad4s(I);
+
+	// add the pressure terms (see Tangent)
+	for (int i=0; i<pts.n; ++i)
+	{
+		double J = pts.J[i];
+		double p = UJ(J);
+		c[i] = c[i] + (IxI - I4*2)*p + IxI*(UJJ(J)*J);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::BatchDevStress(const FEMaterialPointBatch& pts, mat3ds* s)
+{
+	for (int i=0; i<pts.n; ++i) s[i] = DevStress(*pts.mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::BatchDevTangent(const FEMaterialPointBatch& pts, tens4ds* c)
+{
+	for (int i=0; i<pts.n; ++i) c[i] = DevTangent(*pts.mp[i]);
+}
+
 //-----------------------------------------------------------------------------
 //! The strain energy density function calculates the total sed as a sum of
 //! two terms, namely the deviatoric sed and U(J).
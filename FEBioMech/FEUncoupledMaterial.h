@@ -68,6 +68,12 @@ public:
 
 	//! Deviatoric strain energy density
 	virtual double DevStrainEnergyDensity(FEMaterialPoint& mp) { return 0; }
+
+	//! Deviatoric Cauchy stress at a batch of material points (default evaluates each point separately)
+	virtual void BatchDevStress(const FEMaterialPointBatch& pts, mat3ds* s);
+
+	//! Deviatoric spatial tangent at a batch of material points (default evaluates each point separately)
+	virtual void BatchDevTangent(const FEMaterialPointBatch& pts, tens4ds* c);
     
 public:
 	//! strain energy density U(J)
@@ -115,6 +121,12 @@ public:
 	//! calculate strain energy (do not overload!)
 	double StrainEnergyDensity(FEMaterialPoint& pt) final;
 
+	//! total Cauchy stress at a batch of material points (do not overload!)
+	void BatchStress(const FEMaterialPointBatch& pts, mat3ds* s) final;
+
+	//! total spatial tangent at a batch of material points (do not overload!)
+	void BatchTangent(const FEMaterialPointBatch& pts, tens4ds* c) final;
+
 	// Create material point data
 	FEMaterialPoint* CreateMaterialPointData() override;
     
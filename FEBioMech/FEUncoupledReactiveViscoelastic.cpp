@@ -43,6 +43,7 @@ BEGIN_FECORE_CLASS(FEUncoupledReactiveViscoelasticMaterial, FEUncoupledMaterial)
 	ADD_PARAMETER(m_wmin , FE_RANGE_CLOSED(0.0, 1.0), "wmin"    );
 	ADD_PARAMETER(m_btype, FE_RANGE_CLOSED(1, 2), "kinetics");
 	ADD_PARAMETER(m_ttype, FE_RANGE_CLOSED(0, 2), "trigger" );
+	ADD_PARAMETER(m_nmax , FE_RANGE_GREATER_OR_EQUAL(0), "max_generations");
 
 	// set material properties
 	ADD_PROPERTY(m_pBase, "elastic");
@@ -58,6 +59,7 @@ FEUncoupledReactiveViscoelasticMaterial::FEUncoupledReactiveViscoelasticMaterial
     m_wmin = 0;
     m_btype = 0;
     m_ttype = 0;
+    m_nmax = 0;
 
 	m_pBase = 0;
 	m_pBond = 0;
@@ -101,8 +103,8 @@ bool FEUncoupledReactiveViscoelasticMaterial::NewGeneration(FEMaterialPoint& mp)
     // the last generation, in which case store the current state
     // evaluate the relative deformation gradient
     mat3d F = pe.m_F;
-    int lg = (int)pt.m_Fi.size() - 1;
-    mat3d Fi = (lg > -1) ? pt.m_Fi[lg] : mat3d(mat3dd(1));
+    int lg = pt.Generations() - 1;
+    mat3d Fi = (lg > -1) ? pt.GetGeneration(lg).Fi : mat3d(mat3dd(1));
     mat3d Fu = F*Fi;
     
     switch (m_ttype) {
@@ -163,23 +165,24 @@ double FEUncoupledReactiveViscoelasticMaterial::BreakingBondMassFraction(FEMater
         case 1:
         {
             // time when this generation started breaking
-            double v = pt.m_v[ig];
+            const FEReactiveVEMaterialPoint::Generation& g = pt.GetGeneration(ig);
+            double v = g.v;
             
             if (time >= v)
-                w = pt.m_w[ig]*m_pRelx->Relaxation(mp, time - v, D);
+                w = g.w*m_pRelx->Relaxation(mp, time - v, D);
         }
             break;
         case 2:
         {
             double tu, tv;
             if (ig == 0) {
-                tv = time - pt.m_v[ig];
+                tv = time - pt.GetGeneration(ig).v;
                 w = m_pRelx->Relaxation(mp, tv, D);
             }
             else
             {
-                tu = time - pt.m_v[ig-1];
-                tv = time - pt.m_v[ig];
+                tu = time - pt.GetGeneration(ig-1).v;
+                tv = time - pt.GetGeneration(ig).v;
                 w = m_pRelx->Relaxation(mp, tv, D) - m_pRelx->Relaxation(mp, tu, D);
             }
         }
@@ -211,15 +214,17 @@ double FEUncoupledReactiveViscoelasticMaterial::ReformingBondMassFraction(FEMate
     double J = ep.m_J;
     
     // get current number of generations
-    int ng = (int)pt.m_Fi.size();
+    int ng = pt.Generations();
     
     double w = 1;
     
     for (int ig=0; ig<ng-1; ++ig)
     {
         // evaluate relative deformation gradient for this generation Fu(v)
-        ep.m_F = pt.m_Fi[ig+1].inverse()*pt.m_Fi[ig];
-        ep.m_J = pt.m_Ji[ig]/pt.m_Ji[ig+1];
+        const FEReactiveVEMaterialPoint::Generation& g0 = pt.GetGeneration(ig);
+        const FEReactiveVEMaterialPoint::Generation& g1 = pt.GetGeneration(ig+1);
+        ep.m_F = g1.Fi.inverse()*g0.Fi;
+        ep.m_J = g0.Ji/g1.Ji;
         // evaluate the breaking bond mass fraction for this generation
         w -= BreakingBondMassFraction(mp, ig, D);
     }
@@ -253,7 +258,7 @@ mat3ds FEUncoupledReactiveViscoelasticMaterial::DevStress(FEMaterialPoint& mp)
     mat3ds s = m_pBase->DevStress(mp);
     
     // current number of breaking generations
-    int ng = (int)pt.m_Fi.size();
+    int ng = pt.Generations();
     
     // no bonds have broken
     if (ng == 0) {
@@ -271,14 +276,15 @@ mat3ds FEUncoupledReactiveViscoelasticMaterial::DevStress(FEMaterialPoint& mp)
         // calculate the bond stresses for breaking generations
         for (int ig=0; ig<ng; ++ig) {
             // evaluate relative deformation gradient for this generation
-            ep.m_F = F*pt.m_Fi[ig];
-            ep.m_J = J*pt.m_Ji[ig];
+            const FEReactiveVEMaterialPoint::Generation& g = pt.GetGeneration(ig);
+            ep.m_F = F*g.Fi;
+            ep.m_J = J*g.Ji;
             // evaluate bond mass fraction for this generation
             w = BreakingBondMassFraction(mp, ig, D);
             // evaluate bond stress
             sb = m_pBond->DevStress(mp);
             // add bond stress to total stress
-            s += sb*(w*pt.m_Ji[ig]);
+            s += sb*(w*g.Ji);
         }
         
         // restore safe copy of deformation gradient
@@ -308,7 +314,7 @@ tens4ds FEUncoupledReactiveViscoelasticMaterial::DevTangent(FEMaterialPoint& mp)
     tens4ds c = m_pBase->DevTangent(mp);
     
     // current number of breaking generations
-    int ng = (int)pt.m_Fi.size();
+    int ng = pt.Generations();
     
     // no bonds have broken
     if (ng == 0) {
@@ -326,14 +332,15 @@ tens4ds FEUncoupledReactiveViscoelasticMaterial::DevTangent(FEMaterialPoint& mp)
         // calculate the bond tangents for breaking generations
         for (int ig=0; ig<ng; ++ig) {
             // evaluate relative deformation gradient for this generation
-            ep.m_F = F*pt.m_Fi[ig];
-            ep.m_J = J*pt.m_Ji[ig];
+            const FEReactiveVEMaterialPoint::Generation& g = pt.GetGeneration(ig);
+            ep.m_F = F*g.Fi;
+            ep.m_J = J*g.Ji;
             // evaluate bond mass fraction for this generation
             w = BreakingBondMassFraction(mp, ig, D);
             // evaluate bond tangent
             cb = m_pBond->DevTangent(mp);
             // add bond tangent to total tangent
-            c += cb*(w*pt.m_Ji[ig]);
+            c += cb*(w*g.Ji);
         }
         
         // restore safe copy of deformation gradient
@@ -364,7 +371,7 @@ double FEUncoupledReactiveViscoelasticMaterial::DevStrainEnergyDensity(FEMateria
     double sed = m_pBase->DevStrainEnergyDensity(mp);
     
     // current number of breaking generations
-    int ng = (int)pt.m_Fi.size();
+    int ng = pt.Generations();
     
     // no bonds have broken
     if (ng == 0) {
@@ -382,8 +389,9 @@ double FEUncoupledReactiveViscoelasticMaterial::DevStrainEnergyDensity(FEMateria
         // calculate the strain energy density for breaking generations
         for (int ig=0; ig<ng; ++ig) {
             // evaluate relative deformation gradient for this generation
-            ep.m_F = F*pt.m_Fi[ig];
-            ep.m_J = J*pt.m_Ji[ig];
+            const FEReactiveVEMaterialPoint::Generation& g = pt.GetGeneration(ig);
+            ep.m_F = F*g.Fi;
+            ep.m_J = J*g.Ji;
             // evaluate bond mass fraction for this generation
             w = BreakingBondMassFraction(mp, ig, D);
             // evaluate bond stress
@@ -413,7 +421,7 @@ void FEUncoupledReactiveViscoelasticMaterial::CullGenerations(FEMaterialPoint& m
     
     mat3ds D = ep.RateOfDeformation();
     
-    if (pt.m_Fi.empty()) return;
+    if (pt.Generations() == 0) return;
     
     // culling termination flag
     bool done = false;
@@ -421,15 +429,71 @@ void FEUncoupledReactiveViscoelasticMaterial::CullGenerations(FEMaterialPoint& m
     // always check oldest generation
     while (!done) {
         double w = BreakingBondMassFraction(mp, 0, D);
-        if ((w > m_wmin) || (pt.m_Fi.size() == 1))
+        if ((w > m_wmin) || (pt.Generations() == 1))
             done = true;
-        else {
-            pt.m_Fi.pop_front();
-            pt.m_Ji.pop_front();
-            pt.m_v.pop_front();
-            pt.m_w.pop_front();
-        }
+        else
+            pt.RemoveOldestGeneration();
     }
     
     return;
 }
+
+//-----------------------------------------------------------------------------
+//! Merge generations until there are no more than m_nmax generations. The breaking
+//! generation that is merged into the next generation is the one for which this 
+//! changes the bond stress the least, i.e. for which the product of its current bond
+//! mass fraction and the difference of its deformation gradient with that of the next
+//! generation is smallest. For the first kinetics type the mass fraction of the merged 
+//! generation is set such that it has the current bond mass of both generations.
+//! For the second kinetics type the merged generation breaks from the time of the
+//! previous generation, so its mass fraction needs no adjustment.
+void FEUncoupledReactiveViscoelasticMaterial::LimitGenerations(FEMaterialPoint& mp)
+{
+    if (m_nmax <= 0) return;
+    
+    // get the elastic part
+    FEElasticMaterialPoint& ep = *mp.ExtractData<FEElasticMaterialPoint>();
+    
+    // get the reactive viscoelastic point data
+    FEReactiveVEMaterialPoint& pt = *mp.ExtractData<FEReactiveVEMaterialPoint>();
+    
+    mat3ds D = ep.RateOfDeformation();
+    
+    // keep at least two breaking generations and the reforming generation
+    int nmax = (m_nmax < 3 ? 3 : m_nmax);
+    
+    // keep safe copy of deformation gradient
+    mat3d F = ep.m_F;
+    double J = ep.m_J;
+    
+    while (pt.Generations() > nmax) {
+        // find the generation to merge (the newest generation is never merged)
+        int ng = pt.Generations();
+        int imin = -1;
+        double dmin = 0, wmin = 0;
+        for (int ig=0; ig<ng-2; ++ig) {
+            const FEReactiveVEMaterialPoint::Generation& g0 = pt.GetGeneration(ig);
+            const FEReactiveVEMaterialPoint::Generation& g1 = pt.GetGeneration(ig+1);
+            ep.m_F = F*g0.Fi;
+            ep.m_J = J*g0.Ji;
+            double w = BreakingBondMassFraction(mp, ig, D);
+            double d = w*(g1.Fi - g0.Fi).norm();
+            if ((imin == -1) || (d < dmin)) { imin = ig; dmin = d; wmin = w; }
+        }
+        
+        const FEReactiveVEMaterialPoint::Generation& g1 = pt.GetGeneration(imin+1);
+        double w = g1.w;
+        if (m_btype == 1) {
+            // the merged generation keeps the current bond mass of both generations
+            ep.m_F = F*g1.Fi;
+            ep.m_J = J*g1.Ji;
+            double w1 = BreakingBondMassFraction(mp, imin+1, D);
+            if (w1 > 0) w = g1.w*(wmin + w1)/w1;
+        }
+        pt.MergeGeneration(imin, w);
+    }
+    
+    // restore safe copy of deformation gradient
+    ep.m_F = F;
+    ep.m_J = J;
+}
@@ -430,11 +430,7 @@ void FEBiphasicShellDomain::ElementInternalForceSS(FEShellElement& el, vector<do
 void FEBiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 {
     // repeat over all solid elements
-    int NE = (int)m_Elem.size();
-    
-#pragma omp parallel for shared(NE)
-    for (int iel=0; iel<NE; ++iel)
-    {
+    AssembleElements(LS, [&](int iel) {
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
@@ -451,19 +447,16 @@ void FEBiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		ke.SetIndices(lm);
         
         // assemble element matrix in global stiffness matrix
+		ke.SetScatterMap(ElementScatterMap(iel));
 		LS.Assemble(ke);
-    }
+    });
 }
 
 //-----------------------------------------------------------------------------
 void FEBiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 {
     // repeat over all solid elements
-    int NE = (int)m_Elem.size();
-    
-#pragma omp parallel for shared(NE)
-    for (int iel=0; iel<NE; ++iel)
-    {
+    AssembleElements(LS, [&](int iel) {
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
@@ -480,8 +473,9 @@ void FEBiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		ke.SetIndices(lm);
         
         // assemble element matrix in global stiffness matrix
+		ke.SetScatterMap(ElementScatterMap(iel));
 		LS.Assemble(ke);
-    }
+    });
 }
 
 //-----------------------------------------------------------------------------
@@ -487,11 +487,7 @@ void FEBiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector<do
 void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 {
 	// repeat over all solid elements
-	int NE = (int)m_Elem.size();
-    
-    #pragma omp parallel for shared(NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
+	AssembleElements(LS, [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
@@ -512,19 +508,16 @@ void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		ke.SetIndices(lm);
 
         // assemble element matrix in global stiffness matrix
+		ke.SetScatterMap(ElementScatterMap(iel));
 		LS.Assemble(ke);
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
 void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 {
 	// repeat over all solid elements
-	int NE = (int)m_Elem.size();
-
-	#pragma omp parallel for shared(NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
+	AssembleElements(LS, [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
@@ -545,8 +538,9 @@ void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		ke.SetIndices(lm);
 
 		// assemble element matrix in global stiffness matrix
+		ke.SetScatterMap(ElementScatterMap(iel));
 		LS.Assemble(ke);
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
@@ -706,12 +706,6 @@ double FESlidingInterface2::AutoPressurePenalty(FESurfaceElement& el, FESlidingS
 void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface2& ms, bool bupseg, bool bmove)
 {
 	FEMesh& mesh = GetFEModel()->GetMesh();
-	FESurfaceElement* pme;
-	vec3d r, nu;
-	double rs[2];
-	double Ln;
-
-	double ps[FEElement::MAX_NODES], p1;
 
 	double R = m_srad*mesh.GetBoundingBox().radius();
 
@@ -774,8 +768,13 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 		}
 	}
 
+	// update the broad phase of the contact search, so that we can skip
+	// the points that are too far from the secondary surface
+	if (bupseg) ss.UpdateContactCandidates(ms, R, m_stol);
+
 	// loop over all integration points
- //   #pragma omp parallel for shared(R, bupseg)
+	// (each integration point only modifies its own data, so this can be done in parallel)
+#pragma omp parallel for
 	for (int i=0; i<ss.Elements(); ++i)
 	{
 		FESurfaceElement& el = ss.Element(i);
@@ -785,6 +784,7 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 		int nint = el.GaussPoints();
 
 		// get the nodal pressures
+		double ps[FEElement::MAX_NODES];
 		if (sporo)
 		{
 			for (int j=0; j<ne; ++j) ps[j] = mesh.Node(el.m_node[j]).get(m_dofP);
@@ -796,16 +796,18 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 			FESlidingSurface2::Data& pt = static_cast<FESlidingSurface2::Data&>(*el.GetMaterialPoint(j));
 
 			// calculate the global position of the integration point
-			r = ss.Local2Global(el, j);
+			vec3d r = ss.Local2Global(el, j);
 
 			// get the pressure at the integration point
+			double p1 = 0;
             if (sporo) p1 = el.eval(ps, j);
 
 			// calculate the normal at this integration point
-			nu = ss.SurfaceNormal(el, j);
+			vec3d nu = ss.SurfaceNormal(el, j);
 
 			// first see if the old intersected face is still good enough
-			pme = pt.m_pme;
+			double rs[2] = { 0, 0 };
+			FESurfaceElement* pme = pt.m_pme;
 			if (pme)
 			{
 				double g;
@@ -823,7 +825,7 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 			}
 
 			// find the intersection point with the secondary surface
-			if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+			if (pme == 0 && bupseg && ss.IsContactCandidate(i)) pme = np.Project(r, nu, rs);
 
 			pt.m_pme = pme;
 			pt.m_nu = nu;
@@ -842,7 +844,7 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 
 				double eps = m_epsn*pt.m_epsn*psf;
 
-				Ln = pt.m_Lmd + eps*g;
+				double Ln = pt.m_Lmd + eps*g;
 
 				pt.m_gap = (g <= R? g : 0);
 
@@ -924,6 +926,7 @@ void FESlidingInterface2::Update()
 	static bool bfirst = true;
 	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
 	if (m_btwo_pass || m_ms.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
+	ReportContactSearch(m_ss, m_ms);
 	bfirst = false;
 
 	// Update the net contact pressures
@@ -787,13 +787,6 @@ double FESlidingInterface3::AutoConcentrationPenalty(FESurfaceElement& el, FESli
 void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface3& ms, bool bupseg, bool bmove)
 {
 	FEMesh& mesh = GetFEModel()->GetMesh();
-	FESurfaceElement* pme;
-	vec3d r, nu;
-	double rs[2];
-	double Ln;
-	
-	double ps[FEElement::MAX_NODES], p1;
-	double cs[FEElement::MAX_NODES], c1;
 	
 	double R = m_srad*mesh.GetBoundingBox().radius();
 	
@@ -857,8 +850,13 @@ void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface
         }
     }
     
+	// update the broad phase of the contact search, so that we can skip
+	// the points that are too far from the secondary surface
+	if (bupseg) ss.UpdateContactCandidates(ms, (R > m_srad ? R : m_srad), m_stol);
+
 	// loop over all integration points
-//    #pragma omp parallel for shared(R, bupseg)
+	// (each integration point only modifies its own data, so this can be done in parallel)
+#pragma omp parallel for
 	for (int i=0; i<ss.Elements(); ++i)
 	{
 		FESurfaceElement& el = ss.Element(i);
@@ -871,12 +869,14 @@ void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface
 		int nint = el.GaussPoints();
 		
 		// get the nodal pressures
+		double ps[FEElement::MAX_NODES];
 		if (sporo)
 		{
 			for (int j=0; j<ne; ++j) ps[j] = mesh.Node(el.m_node[j]).get(m_dofP);
 		}
 		
 		// get the nodal concentrations
+		double cs[FEElement::MAX_NODES];
 		if (ssolu)
 		{
 			for (int j=0; j<ne; ++j) cs[j] = mesh.Node(el.m_node[j]).get(m_dofC + sid);
@@ -887,19 +887,22 @@ void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface
 			FESlidingSurface3::Data& pt = static_cast<FESlidingSurface3::Data&>(*el.GetMaterialPoint(j));
 
 			// calculate the global position of the integration point
-			r = ss.Local2Global(el, j);
+			vec3d r = ss.Local2Global(el, j);
 			
 			// get the pressure at the integration point
+			double p1 = 0;
 			if (sporo) p1 = el.eval(ps, j);
 			
 			// get the concentration at the integration point
+			double c1 = 0;
 			if (ssolu) c1 = el.eval(cs, j);
 			
 			// calculate the normal at this integration point
-			nu = ss.SurfaceNormal(el, j);
+			vec3d nu = ss.SurfaceNormal(el, j);
 			
 			// first see if the old intersected face is still good enough
-			pme = pt.m_pme;
+			double rs[2] = { 0, 0 };
+			FESurfaceElement* pme = pt.m_pme;
 			if (pme)
 			{
 				double g;
@@ -917,7 +920,7 @@ void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface
 			}
 			
 			// find the intersection point with the secondary surface
-			if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+			if (pme == 0 && bupseg && ss.IsContactCandidate(i)) pme = np.Project(r, nu, rs);
 			
 			pt.m_pme = pme;
 			pt.m_nu = nu;
@@ -936,7 +939,7 @@ void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface
 				
 				double eps = m_epsn*pt.m_epsn*psf;
 				
-				Ln = pt.m_Lmd + eps*g;
+				double Ln = pt.m_Lmd + eps*g;
 				
 				pt.m_gap = (g <= R? g : 0);
 				
@@ -1033,6 +1036,7 @@ void FESlidingInterface3::Update()
     static bool bfirst = true;
     ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
 	if (m_btwo_pass || m_ss.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
+	ReportContactSearch(m_ss, m_ms);
     bfirst = false;
 	
 	// Update the net contact pressures
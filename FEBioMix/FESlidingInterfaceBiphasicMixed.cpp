@@ -857,6 +857,10 @@ void FESlidingInterfaceBiphasicMixed::ProjectSurface(FESlidingSurfaceBiphasicMix
         }
     }
     
+    // update the broad phase of the contact search, so that we can skip
+    // the points that are too far from the secondary surface
+    if (bupseg) ss.UpdateContactCandidates(ms, R, m_stol);
+
     // loop over all integration points
 #pragma omp parallel for
     for (int i=0; i<ss.Elements(); ++i)
@@ -909,7 +913,7 @@ void FESlidingInterfaceBiphasicMixed::ProjectSurface(FESlidingSurfaceBiphasicMix
             }
             
             // find the intersection point with the secondary surface
-            if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+            if (pme == 0 && bupseg && ss.IsContactCandidate(i)) pme = np.Project(r, nu, rs);
             
             pt.m_pme = pme;
             pt.m_nu = nu;
@@ -1034,6 +1038,7 @@ void FESlidingInterfaceBiphasicMixed::Update()
     static bool bfirst = true;
     ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
     if (m_btwo_pass || m_ms.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
+    ReportContactSearch(m_ss, m_ms);
     bfirst = false;
     
     // Call InitSlidingSurface on the first iteration of each time step
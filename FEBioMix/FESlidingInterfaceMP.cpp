@@ -916,16 +916,9 @@ double FESlidingInterfaceMP::AutoConcentrationPenalty(FESurfaceElement& el,
 void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfaceMP& ms, bool bupseg, bool bmove)
 {
 	FEMesh& mesh = GetFEModel()->GetMesh();
-	FESurfaceElement* pme;
-	vec3d r, nu;
-	double rs[2];
-	double Ln;
 	
 	const int MN = FEElement::MAX_NODES;
 	int nsol = (int)m_sid.size();
-	double ps[MN], p1;
-	vector< vector<double> > cs(nsol, vector<double>(MN));
-	vector<double> c1(nsol);
 	
 	double R = m_srad*mesh.GetBoundingBox().radius();
 
@@ -989,8 +982,18 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
         }
     }
     
+	// update the broad phase of the contact search, so that we can skip
+	// the points that are too far from the secondary surface
+	if (bupseg) ss.UpdateContactCandidates(ms, (R > m_srad ? R : m_srad), m_stol);
+
 	// loop over all integration points
-//    #pragma omp parallel for shared(R, bupseg)
+	// (each integration point only modifies its own data, so this can be done in parallel)
+#pragma omp parallel
+	{
+	vector< vector<double> > cs(nsol, vector<double>(MN));
+	vector<double> c1(nsol);
+
+#pragma omp for
 	for (int i=0; i<ss.Elements(); ++i)
 	{
 		FESurfaceElement& el = ss.Element(i);
@@ -1001,6 +1004,7 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 		int nint = el.GaussPoints();
 		
 		// get the nodal pressures
+		double ps[MN];
 		if (sporo)
 		{
 			for (int j=0; j<ne; ++j) ps[j] = mesh.Node(el.m_node[j]).get(m_dofP);
@@ -1016,19 +1020,21 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 			FESlidingSurfaceMP::Data& pt = static_cast<FESlidingSurfaceMP::Data&>(*el.GetMaterialPoint(j));
 
 			// calculate the global position of the integration point
-			r = ss.Local2Global(el, j);
+			vec3d r = ss.Local2Global(el, j);
 			
 			// get the pressure at the integration point
+			double p1 = 0;
 			if (sporo) p1 = el.eval(ps, j);
 			
 			// get the concentration at the integration point
 			for (int isol=0; isol<nsol; ++isol) c1[isol] = el.eval(&cs[isol][0], j);
 			
 			// calculate the normal at this integration point
-			nu = ss.SurfaceNormal(el, j);
+			vec3d nu = ss.SurfaceNormal(el, j);
 			
 			// first see if the old intersected face is still good enough
-			pme = pt.m_pme;
+			double rs[2] = { 0, 0 };
+			FESurfaceElement* pme = pt.m_pme;
 			if (pme)
 			{
 				double g;
@@ -1046,7 +1052,7 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 			}
 			
 			// find the intersection point with the secondary surface
-			if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+			if (pme == 0 && bupseg && ss.IsContactCandidate(i)) pme = np.Project(r, nu, rs);
 			
 			pt.m_pme = pme;
 			pt.m_nu = nu;
@@ -1065,7 +1071,7 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 				
 				double eps = m_epsn*pt.m_epsn*psf;
 				
-				Ln = pt.m_Lmd + eps*g;
+				double Ln = pt.m_Lmd + eps*g;
 				
 				pt.m_gap = (g <= R? g : 0);
 				
@@ -1119,6 +1125,7 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 			}
 		}
 	}
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -1179,6 +1186,7 @@ void FESlidingInterfaceMP::Update()
     static bool bfirst = true;
 	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
 	if (m_btwo_pass || m_ss.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
+	ReportContactSearch(m_ss, m_ms);
     bfirst = false;
 	
 	// Update the net contact pressures
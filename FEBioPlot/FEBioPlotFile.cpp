@@ -28,12 +28,14 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEBioPlotFile.h"
+#include "PltReader.h"
 #include "FECore/FECoreKernel.h"
 #include "FECore/FEDataExport.h"
 #include "FECore/FEModel.h"
 #include "FECore/FEMaterial.h"
 #include <FEBioLib/version.h>
 #include <FECore/FESurface.h>
+#include <FECore/sys.h>
 
 FEBioPlotFile::DICTIONARY_ITEM::DICTIONARY_ITEM()
 {
@@ -41,6 +43,7 @@ FEBioPlotFile::DICTIONARY_ITEM::DICTIONARY_ITEM()
 	m_ntype = 0;
 	m_nfmt = 0;
 	m_arraySize = 0;
+	m_nenc = DataEncoding::FP32;
 	m_szname[0] = 0;
 }
 
@@ -51,6 +54,7 @@ FEBioPlotFile::DICTIONARY_ITEM::DICTIONARY_ITEM(const FEBioPlotFile::DICTIONARY_
 	m_nfmt = item.m_nfmt;
 	m_arraySize = item.m_arraySize;
 	m_arrayNames = item.m_arrayNames;
+	m_nenc = item.m_nenc;
 	m_szname[0] = 0;
 	if (item.m_szname[0]) strcpy(m_szname, item.m_szname);
 }
@@ -125,7 +129,7 @@ private:
 class FEPlotVariable : public FEPlotNodeData
 {
 public:
-	FEPlotVariable(FEModel* fem, const char* szname, Var_Type itype, Storage_Fmt fmt) : FEPlotNodeData(fem, itype, fmt) { strcpy(m_szname, szname); }
+	FEPlotVariable(FEModel* fem, const char* szname, Var_Type itype, Storage_Fmt fmt) : FEPlotNodeData(fem, itype, fmt) { strcpy(m_szname, szname); SetThreadSafe(true); }
 	bool Save(FEMesh& mesh, FEDataStream& str)
 	{
 		// get the DOFS
@@ -514,6 +518,8 @@ void FEBioPlotFile::PlotObject::AddData(const char* szname, Var_Type type, FEPlo
 FEBioPlotFile::FEBioPlotFile(FEModel& fem) : m_fem(fem)
 {
 	m_ncompress = 0;
+	m_ncodec = 0;
+	m_bindex = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -562,9 +568,19 @@ bool FEBioPlotFile::AddVariable(const char* sz)
 }
 
 //-----------------------------------------------------------------------------
-bool FEBioPlotFile::AddVariable(const char* sz, vector<int>& item, const char* szdom)
+bool FEBioPlotFile::AddVariable(const char* sz, vector<int>& item, const char* szdom, int nenc)
 { 
-	return m_dic.AddVariable(&m_fem, sz, item, szdom); 
+	size_t nnode = m_dic.m_Node.size();
+	size_t nelem = m_dic.m_Elem.size();
+	size_t nface = m_dic.m_Face.size();
+	if (m_dic.AddVariable(&m_fem, sz, item, szdom) == false) return false;
+
+	// set the encoding of the new variable
+	if      (m_dic.m_Node.size() > nnode) m_dic.m_Node.back().m_nenc = nenc;
+	else if (m_dic.m_Elem.size() > nelem) m_dic.m_Elem.back().m_nenc = nenc;
+	else if (m_dic.m_Face.size() > nface) m_dic.m_Face.back().m_nenc = nenc;
+
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -619,6 +635,18 @@ void FEBioPlotFile::SetCompression(int n)
 	m_ncompress = n;
 }
 
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::SetBlockCompression(int ncodec)
+{
+	m_ncodec = ncodec;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::SetIndex(bool b)
+{
+	m_bindex = b;
+}
+
 //-----------------------------------------------------------------------------
 bool FEBioPlotFile::IsValid() const
 {
@@ -628,7 +656,12 @@ bool FEBioPlotFile::IsValid() const
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::Close()
 {
+	// the index is written at the end of the file
+	if (m_bindex && m_ar.IsValid() && m_ar.IsSaving()) WriteIndex();
+
 	m_ar.Close();
+	m_time.clear();
+	m_index.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -690,7 +723,21 @@ bool FEBioPlotFile::WriteHeader(FEModel& fem)
 	m_ar.WriteChunk(PLT_HDR_VERSION, nversion);
 
 	// compression flag
-	m_ar.WriteChunk(PLT_HDR_COMPRESSION, m_ncompress);
+	// For block compression this is zero, since the states are not compressed
+	// as a single stream. Instead, the codec is stored in a separate flag.
+	int ncompress = (m_ncodec ? 0 : m_ncompress);
+	m_ar.WriteChunk(PLT_HDR_COMPRESSION, ncompress);
+	if (m_ncompress && m_ncodec)
+	{
+		m_ar.WriteChunk(PLT_HDR_BLOCK_COMPRESSION, m_ncodec);
+	}
+
+	// index flag
+	if (m_bindex)
+	{
+		unsigned int nindex = 1;
+		m_ar.WriteChunk(PLT_HDR_INDEX, nindex);
+	}
 
 	// software flag
 	char sz[256] = {0};
@@ -780,6 +827,7 @@ void FEBioPlotFile::WriteDictionaryItem(DICTIONARY_ITEM& it)
 			m_ar.WriteChunk(PLT_DIC_ITEM_ARRAYNAME, (char*)c, STR_SIZE);
 		}
 	}
+	if (it.m_nenc != DataEncoding::FP32) m_ar.WriteChunk(PLT_DIC_ITEM_ENCODING, it.m_nenc);
 	m_ar.WriteChunk(PLT_DIC_ITEM_NAME, it.m_szname, STR_SIZE);
 }
 
@@ -1308,11 +1356,17 @@ void FEBioPlotFile::WriteObject(PlotObject* po)
 //-----------------------------------------------------------------------------
 bool FEBioPlotFile::Write(FEModel &fem, float ftime)
 {
+	// the writer thread discards all states after a write error
+	if (m_ar.HasWriteError()) return false;
+
 	// store the fem pointer
 	m_pfem = &fem;
 
+	// keep track of the state times for the index
+	if (m_bindex) m_time.push_back(ftime);
+
 	// compress these sections if requested
-	m_ar.SetCompression(m_ncompress);
+	m_ar.SetCompression(m_ncompress, (m_ncompress ? m_ncodec : 0));
 	m_ar.BeginChunk(PLT_STATE);
 	{
 		// state header
@@ -1386,7 +1440,7 @@ bool FEBioPlotFile::Write(FEModel &fem, float ftime)
 	}
 	m_ar.EndChunk();
 
-	return true;
+	return (m_ar.HasWriteError() == false);
 }
 
 //-----------------------------------------------------------------------------
@@ -1398,56 +1452,93 @@ void FEBioPlotFile::WriteGlobalData(FEModel& fem)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteNodeData(FEModel& fem)
 {
-	list<DICTIONARY_ITEM>::iterator it = m_dic.m_Node.begin();
-	for (int i=0; i<(int) m_dic.m_Node.size(); ++i, ++it)
+	WriteFields(fem, PLT_NODE_DATA, m_dic.m_Node);
+}
+
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::WriteDomainData(FEModel& fem)
+{
+	WriteFields(fem, PLT_ELEMENT_DATA, m_dic.m_Elem);
+}
+
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
+{
+	WriteFields(fem, PLT_FACE_DATA, m_dic.m_Face);
+}
+
+//-----------------------------------------------------------------------------
+// Evaluate and write the plot variables of a dictionary list. The variables are 
+// processed in batches of one variable per thread: the variables of a batch are 
+// evaluated into separate buffers (in parallel where possible) and then written 
+// to the archive in dictionary order. Since the archive already keeps the entire 
+// state in memory until it is flushed, the buffers add at most one batch of 
+// variables to that.
+void FEBioPlotFile::WriteFields(FEModel& fem, unsigned int nsection, list<DICTIONARY_ITEM>& dic)
+{
+	vector<FEPlotData*> pd;
+	vector<int> nenc;
+	list<DICTIONARY_ITEM>::iterator it = dic.begin();
+	for (int i = 0; i<(int)dic.size(); ++i, ++it)
 	{
-		m_ar.BeginChunk(PLT_STATE_VARIABLE);
-		{
-			unsigned int nid = i+1;
-			m_ar.WriteChunk(PLT_STATE_VAR_ID, nid);
-			m_ar.BeginChunk(PLT_STATE_VAR_DATA);
-			{
-				if (it->m_psave) WriteNodeDataField(fem, it->m_psave);
-			}
-			m_ar.EndChunk();
-		}
-		m_ar.EndChunk();
+		pd.push_back(it->m_psave);
+		nenc.push_back(it->m_nenc);
+	}
+
+	int N = (int)pd.size();
+	int nbatch = omp_get_max_threads();
+	for (int i0 = 0; i0 < N; i0 += nbatch)
+	{
+		int n = (N - i0 < nbatch ? N - i0 : nbatch);
+		vector<FieldData> data(n);
+		for (int i = 0; i < n; ++i) data[i].nenc = nenc[i0 + i];
+
+		EvaluateFields(fem, &pd[i0], data);
+		WriteFields(nsection, i0, data);
 	}
 }
 
 //-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteDomainData(FEModel& fem)
+// Evaluate the plot variables pd[0], ..., pd[n-1] (with n the size of data). 
+// Since the data is buffered and only written afterwards, the plot variables 
+// can be evaluated in parallel.
+void FEBioPlotFile::EvaluateFields(FEModel& fem, FEPlotData** pd, vector<FieldData>& data)
 {
-	list<DICTIONARY_ITEM>::iterator it = m_dic.m_Elem.begin();
-	for (int i=0; i<(int) m_dic.m_Elem.size(); ++i, ++it)
+	int N = (int)data.size();
+
+#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i<N; ++i)
 	{
-		m_ar.BeginChunk(PLT_STATE_VARIABLE);
-		{
-			unsigned int nid = i+1;
-			m_ar.WriteChunk(PLT_STATE_VAR_ID, nid);
-			m_ar.BeginChunk(PLT_STATE_VAR_DATA);
-			{
-				if (it->m_psave) WriteDomainDataField(fem, it->m_psave);
-			}
-			m_ar.EndChunk();
-		}
-		m_ar.EndChunk();
+		if (pd[i] && pd[i]->IsThreadSafe()) SaveDataField(fem, pd[i], data[i]);
+	}
+
+	// the remaining variables are evaluated serially
+	for (int i = 0; i<N; ++i)
+	{
+		if (pd[i] && (pd[i]->IsThreadSafe() == false)) SaveDataField(fem, pd[i], data[i]);
 	}
 }
 
 //-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
+// Write the evaluated plot variables. The first one is the variable with index 
+// i0 in the dictionary list. When indexing, the position of the data is recorded, 
+// so that it can be added to the index.
+void FEBioPlotFile::WriteFields(unsigned int nsection, int i0, vector<FieldData>& data)
 {
-	list<DICTIONARY_ITEM>::iterator it = m_dic.m_Face.begin();
-	for (int i=0; i<(int) m_dic.m_Face.size(); ++i, ++it)
+	for (int i=0; i<(int) data.size(); ++i)
 	{
 		m_ar.BeginChunk(PLT_STATE_VARIABLE);
 		{
-			unsigned int nid = i+1;
+			unsigned int nid = i0 + i + 1;
 			m_ar.WriteChunk(PLT_STATE_VAR_ID, nid);
 			m_ar.BeginChunk(PLT_STATE_VAR_DATA);
 			{
-				if (it->m_psave) WriteSurfaceDataField(fem, it->m_psave);
+				FieldData& d = data[i];
+				for (int j = 0; j < (int)d.id.size(); ++j)
+				{
+					if (m_bindex) m_ar.WriteMarkedData(d.id[j], d.data[j].data(), nsection, nid, d.nenc);
+					else m_ar.WriteData(d.id[j], d.data[j].data(), d.nenc);
+				}
 			}
 			m_ar.EndChunk();
 		}
@@ -1456,7 +1547,20 @@ void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
 }
 
 //-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteNodeDataField(FEModel &fem, FEPlotData* pd)
+void FEBioPlotFile::SaveDataField(FEModel& fem, FEPlotData* pd, FieldData& data)
+{
+	switch (pd->RegionType())
+	{
+	case FE_REGION_NODE   : SaveNodeDataField   (fem, pd, data); break;
+	case FE_REGION_DOMAIN : SaveDomainDataField (fem, pd, data); break;
+	case FE_REGION_SURFACE: SaveSurfaceDataField(fem, pd, data); break;
+	default:
+		assert(false);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::SaveNodeDataField(FEModel &fem, FEPlotData* pd, FieldData& data)
 {
 	// loop over all node sets
 	// right now there is only one, namely the node set of all mesh nodes
@@ -1468,12 +1572,13 @@ void FEBioPlotFile::WriteNodeDataField(FEModel &fem, FEPlotData* pd)
 	if (pd->Save(fem.GetMesh(), a))
 	{
 		assert(a.size() == N*ndata);
-		m_ar.WriteData(0, a.data());
+		data.id.push_back(0);
+		data.data.push_back(a);
 	}
 }
 
 //-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
+void FEBioPlotFile::SaveSurfaceDataField(FEModel& fem, FEPlotData* pd, FieldData& data)
 {
 	// loop over all surfaces
 	FEMesh& m = fem.GetMesh();
@@ -1515,7 +1620,8 @@ void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
 			if (a.size() == nsize)
 			{
 				// assumed padding is already there, or not needed
-				m_ar.WriteData(i + 1, a.data());
+				data.id.push_back(i + 1);
+				data.data.push_back(a);
 			}
 			else
 			{
@@ -1536,15 +1642,16 @@ void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
 					}
 				}
 
-				// write the padded data
-				m_ar.WriteData(i + 1, b.data());
+				// store the padded data
+				data.id.push_back(i + 1);
+				data.data.push_back(b);
 			}
 		}
 	}
 }
 
 //-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteDomainDataField(FEModel &fem, FEPlotData* pd)
+void FEBioPlotFile::SaveDomainDataField(FEModel &fem, FEPlotData* pd, FieldData& data)
 {
 	FEMesh& m = fem.GetMesh();
 	int ND = m.Domains();
@@ -1593,7 +1700,8 @@ void FEBioPlotFile::WriteDomainDataField(FEModel &fem, FEPlotData* pd)
 		if (pd->Save(D, a))
 		{
 			assert(a.size() == nsize);
-			m_ar.WriteData(item[i] + 1, a.data());
+			data.id.push_back(item[i] + 1);
+			data.data.push_back(a);
 		}
 	}
 }
@@ -1613,7 +1721,12 @@ bool FEBioPlotFile::Append(FEModel& fem, const char *szfile)
 	while (m_ar.OpenChunk() == IO_OK)
 	{
 		nid = m_ar.GetChunkID();
-		if (nid == PLT_DICTIONARY)
+		if (nid == PLT_HEADER)
+		{
+			// read the compression settings, so we can append the states in the same way
+			if (ReadHeader() == false) break;
+		}
+		else if (nid == PLT_DICTIONARY)
 		{
 			// read the dictionary
 			bok = ReadDictionary();
@@ -1624,14 +1737,58 @@ bool FEBioPlotFile::Append(FEModel& fem, const char *szfile)
 
 	// close it again ...
 	m_ar.Close();
+	if (bok == false) return false;
 
 	// rebuild the surface table
 	BuildSurfaceTable();
 
+	// If the file has an index, we keep the entries of the states that are already
+	// in the file. The index itself (and any incomplete data after the last state, in 
+	// case the run was aborted) is removed, since it's rewritten when the file is closed.
+	if (m_bindex)
+	{
+		PltReader plt;
+		if (plt.Open(szfile) == false) return false;
+		m_index = plt.Index();
+		long long nend = plt.DataEnd();
+		long long nsize = plt.FileSize();
+		plt.Close();
+
+		if ((nend < nsize) && (FileStream::Truncate(szfile, nend) == false)) return false;
+	}
+
 	// ... and open for appending
-	if (bok) return m_ar.Append(szfile);
+	return m_ar.Append(szfile);
+}
 
-	return false;
+//-----------------------------------------------------------------------------
+bool FEBioPlotFile::ReadHeader()
+{
+	m_ncompress = 0;
+	m_ncodec = 0;
+	m_bindex = false;
+	while (m_ar.OpenChunk() == IO_OK)
+	{
+		unsigned int nid = m_ar.GetChunkID();
+		switch (nid)
+		{
+		case PLT_HDR_COMPRESSION      : m_ar.read(m_ncompress); break;
+		case PLT_HDR_BLOCK_COMPRESSION: m_ar.read(m_ncodec); break;
+		case PLT_HDR_INDEX:
+			{
+				unsigned int nindex = 0;
+				m_ar.read(nindex);
+				m_bindex = (nindex != 0);
+			}
+			break;
+		}
+		m_ar.CloseChunk();
+	}
+
+	// for block compression, the compression flag is zero
+	if (m_ncodec) m_ncompress = 1;
+
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -1666,14 +1823,17 @@ bool FEBioPlotFile::ReadDicList()
 		unsigned int nid = m_ar.GetChunkID();
 		if (nid == PLT_DIC_ITEM)
 		{
+			// the encoding is stored before the name
+			unsigned int nenc = DataEncoding::FP32;
 			while (m_ar.OpenChunk() == IO_OK)
 			{
 				unsigned int nid = m_ar.GetChunkID();
-				if (nid == PLT_DIC_ITEM_NAME)
+				if (nid == PLT_DIC_ITEM_ENCODING) m_ar.read(nenc);
+				else if (nid == PLT_DIC_ITEM_NAME)
 				{
 					char sz[STR_SIZE];
 					m_ar.read(sz, STR_SIZE);
-					AddVariable(sz, l);
+					AddVariable(sz, l, "", nenc);
 				}
 				m_ar.CloseChunk();
 			}
@@ -1684,6 +1844,90 @@ bool FEBioPlotFile::ReadDicList()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Write the state index. This is called when the file is closed. 
+// The index contains the states that were already in the file (when appending) and the
+// states that were written since the file was opened. It is followed by a small chunk 
+// that stores the position of the index, so readers can find it from the end of the file.
+void FEBioPlotFile::WriteIndex()
+{
+	// find out where the states were written
+	vector<PltArchive::TREE_INFO> tree;
+	m_ar.GetTreeInfo(tree);
+	if (m_ar.HasWriteError()) return;
+
+	vector<IndexState> index = m_index;
+	int n = 0;
+	for (size_t i = 0; i < tree.size(); ++i)
+	{
+		PltArchive::TREE_INFO& ti = tree[i];
+		if ((ti.id != PLT_STATE) || (n >= (int)m_time.size())) continue;
+
+		IndexState s;
+		s.time = m_time[n++];
+		s.pos = ti.pos;
+		s.size = ti.size;
+		if      (ti.ncodec   ) s.compression = IndexState::BLOCKS;
+		else if (ti.ncompress) s.compression = IndexState::ZLIB_STREAM;
+		else s.compression = IndexState::RAW;
+
+		for (size_t j = 0; j < ti.marks.size(); ++j)
+		{
+			FileStream::MARK& m = ti.marks[j];
+			IndexField f = { m.tag0, m.tag1, m.nid, m.offset, m.size };
+			s.fields.push_back(f);
+		}
+		index.push_back(s);
+	}
+
+	// write the index (uncompressed)
+	m_ar.SetCompression(0);
+	m_ar.BeginChunk(PLT_INDEX);
+	{
+		for (size_t i = 0; i < index.size(); ++i)
+		{
+			IndexState& s = index[i];
+			m_ar.BeginChunk(PLT_INDEX_STATE);
+			{
+				unsigned int ncomp = s.compression;
+				m_ar.WriteChunk(PLT_INDEX_TIME, s.time);
+				m_ar.WriteChunk(PLT_INDEX_POS, s.pos);
+				m_ar.WriteChunk(PLT_INDEX_SIZE, s.size);
+				m_ar.WriteChunk(PLT_INDEX_COMPRESSION, ncomp);
+
+				if (s.fields.empty() == false)
+				{
+					vector<unsigned int> d; d.reserve(5 * s.fields.size());
+					for (size_t j = 0; j < s.fields.size(); ++j)
+					{
+						IndexField& f = s.fields[j];
+						d.push_back(f.section);
+						d.push_back(f.var);
+						d.push_back(f.region);
+						d.push_back(f.offset);
+						d.push_back(f.size);
+					}
+					m_ar.WriteChunk(PLT_INDEX_FIELDS, d);
+				}
+			}
+			m_ar.EndChunk();
+		}
+	}
+	m_ar.EndChunk();
+
+	// find the position of the index
+	m_ar.GetTreeInfo(tree);
+	if (m_ar.HasWriteError() || tree.empty() || (tree.back().id != PLT_INDEX)) return;
+	long long npos = tree.back().pos;
+
+	// write the trailer
+	m_ar.BeginChunk(PLT_INDEX_END);
+	{
+		m_ar.WriteChunk(PLT_INDEX_END_POS, npos);
+	}
+	m_ar.EndChunk();
+}
+
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteMeshState(FEMesh& mesh)
 {
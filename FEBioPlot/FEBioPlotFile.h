@@ -65,6 +65,8 @@ public:
 			PLT_HDR_COMPRESSION			= 0x01010004,
 			PLT_HDR_AUTHOR				= 0x01010005,	// new in 2.0
 			PLT_HDR_SOFTWARE			= 0x01010006,	// new in 2.0
+			PLT_HDR_BLOCK_COMPRESSION	= 0x01010007,	// block compression codec (states are stored in BLOCK_STREAM_ID chunks)
+			PLT_HDR_INDEX				= 0x01010008,	// the file ends with an index of the states (see PLT_INDEX)
 		PLT_DICTIONARY					= 0x01020000,
 			PLT_DIC_ITEM				= 0x01020001,
 			PLT_DIC_ITEM_TYPE			= 0x01020002,
@@ -72,6 +74,7 @@ public:
 			PLT_DIC_ITEM_NAME			= 0x01020004,
 			PLT_DIC_ITEM_ARRAYSIZE		= 0x01020005,	// added in version 0x05
 			PLT_DIC_ITEM_ARRAYNAME		= 0x01020006,	// added in version 0x05
+			PLT_DIC_ITEM_ENCODING		= 0x01020007,	// encoding of the data (see DataEncoding). Only written if not FP32.
 			PLT_DIC_GLOBAL				= 0x01021000,
 //			PLT_DIC_MATERIAL			= 0x01022000,	// this was removed
 			PLT_DIC_NODAL				= 0x01023000,
@@ -147,7 +150,19 @@ public:
 				PLT_FACE_DATA			= 0x02020500,
 			PLT_MESH_STATE				= 0x02030000,
 				PLT_ELEMENT_STATE		= 0x02030001,
-			PLT_OBJECTS_STATE			= 0x02040000
+			PLT_OBJECTS_STATE			= 0x02040000,
+
+		// The state index is written (uncompressed) when the file is closed and is followed by the 
+		// PLT_INDEX_END chunk, which makes up the last 24 bytes of the file.
+		PLT_INDEX						= 0x04000000,
+			PLT_INDEX_STATE				= 0x04010000,
+				PLT_INDEX_TIME			= 0x04010001,	// state time (float)
+				PLT_INDEX_POS			= 0x04010002,	// file position of the state (64-bit int)
+				PLT_INDEX_SIZE			= 0x04010003,	// size of the state in the file (64-bit int)
+				PLT_INDEX_COMPRESSION	= 0x04010004,	// how the state is stored (see IndexState)
+				PLT_INDEX_FIELDS		= 0x04010005,	// five values per field (see IndexField)
+		PLT_INDEX_END					= 0x04020000,
+			PLT_INDEX_END_POS			= 0x04020001	// file position of the PLT_INDEX chunk (64-bit int)
 	};
 	// --- element types ---
 	enum Elem_Type { 
@@ -188,6 +203,7 @@ public:
 		unsigned int	m_ntype;	// data type
 		unsigned int	m_nfmt;		// storage format
 		unsigned int	m_arraySize;	// size of arrays (only used by arrays)
+		unsigned int	m_nenc;		// data encoding (see DataEncoding)
 		vector<string>	m_arrayNames;	// names of array components (optional)
 		char			m_szname[STR_SIZE];
 	};
@@ -235,6 +251,38 @@ public:
 		FESurface*	surf;
 	};
 
+	// The data of one plot variable for the current state. 
+	// There is a data stream for each region (node set, domain, or surface) that has data.
+	struct FieldData
+	{
+		vector<int>				id;		// region ID
+		vector<FEDataStream>	data;	// the data of each region
+		int						nenc;	// data encoding
+	};
+
+	// Index entry of the data of a plot variable in one region. The offset is relative 
+	// to the start of the (uncompressed) state chunk.
+	struct IndexField
+	{
+		unsigned int	section;	// PLT_NODE_DATA, PLT_ELEMENT_DATA, or PLT_FACE_DATA
+		unsigned int	var;		// variable ID (one-based index in dictionary list)
+		unsigned int	region;		// region ID
+		unsigned int	offset;		// offset of the data
+		unsigned int	size;		// size of the data (in bytes)
+	};
+
+	// Index entry of a state
+	struct IndexState
+	{
+		enum { RAW, ZLIB_STREAM, BLOCKS };	// values of compression
+
+		float		time;			// state time
+		long long	pos;			// file position of the state
+		long long	size;			// size of the state in the file
+		int			compression;	// how the state is stored
+		vector<IndexField>	fields;	// field data
+	};
+
 	class PlotObject
 	{
 	public:
@@ -292,11 +340,18 @@ public:
 	//! Add a variable to the dictionary
 	bool AddVariable(FEPlotData* ps, const char* szname);
 	bool AddVariable(const char* sz);
-	bool AddVariable(const char* sz, vector<int>& item, const char* szdom = "");
+	bool AddVariable(const char* sz, vector<int>& item, const char* szdom = "", int nenc = DataEncoding::FP32);
 
 	//! Set the compression level
 	void SetCompression(int n);
 
+	//! Use block compression with the given codec (see FileStream::Block_Codec)
+	//! Only used when compression is on. Set to zero to compress each state as a single zlib stream.
+	void SetBlockCompression(int ncodec);
+
+	//! Write an index of the states at the end of the file (see PltReader)
+	void SetIndex(bool b);
+
 	//! see if the plot file is valid
 	virtual bool IsValid() const;
 
@@ -344,13 +399,21 @@ protected:
 	void WriteObjectsState();
 	void WriteObjectData(PlotObject* po);
 
-	void WriteNodeDataField(FEModel& fem, FEPlotData* pd);
-	void WriteDomainDataField(FEModel& fem, FEPlotData* pd);
-	void WriteSurfaceDataField(FEModel& fem, FEPlotData* pd);
+	void WriteFields(FEModel& fem, unsigned int nsection, list<DICTIONARY_ITEM>& dic);
+	void EvaluateFields(FEModel& fem, FEPlotData** pd, vector<FieldData>& data);
+	void WriteFields(unsigned int nsection, int i0, vector<FieldData>& data);
+
+	void SaveDataField(FEModel& fem, FEPlotData* pd, FieldData& data);
+	void SaveNodeDataField(FEModel& fem, FEPlotData* pd, FieldData& data);
+	void SaveDomainDataField(FEModel& fem, FEPlotData* pd, FieldData& data);
+	void SaveSurfaceDataField(FEModel& fem, FEPlotData* pd, FieldData& data);
 
 	void WriteMeshState(FEMesh& mesh);
 
+	void WriteIndex();
+
 protected:
+	bool ReadHeader();
 	bool ReadDictionary();
 	bool ReadDicList();
 	void BuildSurfaceTable();
@@ -360,6 +423,11 @@ protected:
 	PltArchive	m_ar;	// the data archive
 	FEModel&	m_fem;
 	int			m_ncompress;	// compression level
+	int			m_ncodec;		// block compression codec (0 = no block compression)
+	bool		m_bindex;		// write the state index
+
+	vector<float>		m_time;		// times of the states that were written (when indexing)
+	vector<IndexState>	m_index;	// index of the states that were already in the file when appending
 
 	vector<Surface>	m_Surf;
 
@@ -29,12 +29,57 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "PltArchive.h"
 #include <assert.h>
+#include <math.h>
+#ifdef WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
 
 #ifdef HAVE_ZLIB
 #include "zlib.h"
-static z_stream strm;
 #endif
 
+//-----------------------------------------------------------------------------
+// compress a block of data (used for block compression)
+static bool compress_block(int ncodec, const unsigned char* pd, size_t nsize, vector<unsigned char>& out)
+{
+#ifdef HAVE_ZLIB
+	int level = (ncodec == FileStream::BLOCK_ZLIB_FAST ? Z_BEST_SPEED : Z_DEFAULT_COMPRESSION);
+	uLongf ndst = compressBound((uLong)nsize);
+	out.resize(ndst);
+	if (compress2(&out[0], &ndst, pd, (uLong)nsize, level) != Z_OK) return false;
+	out.resize(ndst);
+	return true;
+#else
+	return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// inflate a block of data. The size of the uncompressed data must be known.
+static bool inflate_block(int ncodec, const unsigned char* pd, size_t nsize, unsigned char* pout, size_t nout)
+{
+	if (ncodec == FileStream::BLOCK_STORED)
+	{
+		if (nsize != nout) return false;
+		memcpy(pout, pd, nsize);
+		return true;
+	}
+#ifdef HAVE_ZLIB
+	if ((ncodec == FileStream::BLOCK_ZLIB) || (ncodec == FileStream::BLOCK_ZLIB_FAST))
+	{
+		uLongf ndst = (uLongf)nout;
+		if (uncompress(pout, &ndst, pd, (uLong)nsize) != Z_OK) return false;
+		return (ndst == nout);
+	}
+#endif
+	return false;
+}
+
 //=============================================================================
 // FileStream
 //=============================================================================
@@ -45,11 +90,19 @@ FileStream::FileStream()
 	m_buf  = new unsigned char[m_bufsize];
 	m_pout = new unsigned char[m_bufsize];
 	m_ncompress = 0;
+	m_ncodec = 0;
+	m_rawPos = 0;
+	m_fp = 0;
+	m_berror = false;
+	m_strm = 0;
 }
 
 FileStream::~FileStream()
 {
 	Close();
+#ifdef HAVE_ZLIB
+	if (m_strm) { deflateEnd(m_strm); delete m_strm; m_strm = 0; }
+#endif
 	delete [] m_buf;
 	delete [] m_pout;
 	m_buf = 0;
@@ -66,7 +119,11 @@ bool FileStream::Open(const char* szfile)
 bool FileStream::Append(const char* szfile)
 {
 	m_fp = fopen(szfile, "a+b");
-	return (m_fp != 0);
+	if (m_fp == 0) return false;
+
+	// make sure the file position is at the end, so that Position() is correct before we write
+	fseek(m_fp, 0, SEEK_END);
+	return true;
 }
 
 bool FileStream::Create(const char* szfile)
@@ -83,40 +140,62 @@ void FileStream::Close()
 
 void FileStream::BeginStreaming()
 {
+	m_rawPos = 0;
+	m_marks.clear();
+
+	if (m_ncodec)
+	{
+		// the data is collected in memory and compressed when streaming ends
+		m_raw.clear();
+		return;
+	}
+
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
-		strm.zalloc = Z_NULL;
-		strm.zfree = Z_NULL;
-		strm.opaque = Z_NULL;
-		deflateInit(&strm, -1);
+		// each file stream has its own zlib stream, since several files can be
+		// written at the same time (e.g. the plot file and an RVE probe file)
+		if (m_strm) deflateEnd(m_strm);
+		else m_strm = new z_stream;
+		m_strm->zalloc = Z_NULL;
+		m_strm->zfree = Z_NULL;
+		m_strm->opaque = Z_NULL;
+		deflateInit(m_strm, -1);
 	}
 #endif
 }
 
 void FileStream::EndStreaming()
 {
+	if (m_ncodec)
+	{
+		WriteBlocks();
+		return;
+	}
+
 	Flush();
 #ifdef HAVE_ZLIB
-	if (m_ncompress)
+	if (m_ncompress && m_strm)
 	{
-		strm.avail_in = 0;
-		strm.next_in = 0;
+		m_strm->avail_in = 0;
+		m_strm->next_in = 0;
 
 		/* run deflate() on input until output buffer not full, finish
 		compression if all of source has been read in */
 		do {
-			strm.avail_out = m_bufsize;
-			strm.next_out = m_pout;
-			int ret = deflate(&strm, Z_FINISH);    /* no bad return value */
+			m_strm->avail_out = m_bufsize;
+			m_strm->next_out = m_pout;
+			int ret = deflate(m_strm, Z_FINISH);    /* no bad return value */
 			assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
-			int have = m_bufsize - strm.avail_out;
-			fwrite(m_pout, 1, have, m_fp);
-		} while (strm.avail_out == 0);
-		assert(strm.avail_in == 0);     /* all input will be used */
+			size_t have = m_bufsize - m_strm->avail_out;
+			if (fwrite(m_pout, 1, have, m_fp) != have) m_berror = true;
+		} while (m_strm->avail_out == 0);
+		assert(m_strm->avail_in == 0);     /* all input will be used */
 
 		// all done
-		deflateEnd(&strm);
+		deflateEnd(m_strm);
+		delete m_strm;
+		m_strm = 0;
 
 		fflush(m_fp);
 	}
@@ -127,6 +206,13 @@ void FileStream::Write(void* pd, size_t Size, size_t Count)
 {
 	unsigned char* pdata = (unsigned char*) pd;
 	size_t nsize = Size*Count;
+	m_rawPos += nsize;
+	if (m_ncodec)
+	{
+		m_raw.insert(m_raw.end(), pdata, pdata + nsize);
+		return;
+	}
+
 	while (nsize > 0)
 	{
 		if (m_current + nsize < m_bufsize)
@@ -149,29 +235,29 @@ void FileStream::Write(void* pd, size_t Size, size_t Count)
 void FileStream::Flush()
 {
 #ifdef HAVE_ZLIB
-	if (m_ncompress)
+	if (m_ncompress && m_strm)
 	{
-		strm.avail_in = m_current;
-		strm.next_in = m_buf;
+		m_strm->avail_in = m_current;
+		m_strm->next_in = m_buf;
 
 		/* run deflate() on input until output buffer not full, finish
 		compression if all of source has been read in */
 		do {
-			strm.avail_out = m_bufsize;
-			strm.next_out = m_pout;
-			int ret = deflate(&strm, Z_NO_FLUSH);    /* no bad return value */
+			m_strm->avail_out = m_bufsize;
+			m_strm->next_out = m_pout;
+			int ret = deflate(m_strm, Z_NO_FLUSH);    /* no bad return value */
 			assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
-			int have = m_bufsize - strm.avail_out;
-			fwrite(m_pout, 1, have, m_fp);
-		} while (strm.avail_out == 0);
-		assert(strm.avail_in == 0);     /* all input will be used */
+			size_t have = m_bufsize - m_strm->avail_out;
+			if (fwrite(m_pout, 1, have, m_fp) != have) m_berror = true;
+		} while (m_strm->avail_out == 0);
+		assert(m_strm->avail_in == 0);     /* all input will be used */
 	}
 	else
 	{
-		if (m_fp) fwrite(m_buf, m_current, 1, m_fp);
+		if (m_fp && (fwrite(m_buf, 1, m_current, m_fp) != m_current)) m_berror = true;
 	}
 #else
-	if (m_fp) fwrite(m_buf, m_current, 1, m_fp);
+	if (m_fp && (fwrite(m_buf, 1, m_current, m_fp) != m_current)) m_berror = true;
 #endif
 
 	// flush the file
@@ -181,6 +267,69 @@ void FileStream::Flush()
 	m_current = 0;
 }
 
+void FileStream::WriteBlocks()
+{
+#ifdef HAVE_ZLIB
+	int ncodec = m_ncodec;
+#else
+	int ncodec = BLOCK_STORED;
+#endif
+
+	// split the data in blocks
+	const unsigned char* praw = (m_raw.empty() ? 0 : &m_raw[0]);
+	size_t rawSize = m_raw.size();
+	int blocks = (int)((rawSize + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+	// compress the blocks
+	vector< vector<unsigned char> > out(blocks);
+	if (ncodec != BLOCK_STORED)
+	{
+		int nerr = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+:nerr)
+		for (int i = 0; i < blocks; ++i)
+		{
+			size_t n0 = (size_t)i*BLOCK_SIZE;
+			size_t n1 = n0 + BLOCK_SIZE; if (n1 > rawSize) n1 = rawSize;
+			if (compress_block(ncodec, praw + n0, n1 - n0, out[i]) == false) nerr++;
+		}
+		if (nerr > 0) { m_berror = true; return; }
+	}
+
+	// setup the chunk header and block table
+	vector<unsigned int> hdr;
+	hdr.push_back(BLOCK_STREAM_ID);
+	hdr.push_back(0);
+	hdr.push_back(ncodec);
+	hdr.push_back((unsigned int)rawSize);
+	hdr.push_back(BLOCK_SIZE);
+	hdr.push_back(blocks);
+	size_t nsize = 4 * sizeof(unsigned int);
+	for (int i = 0; i < blocks; ++i)
+	{
+		size_t ni = out[i].size();
+		if (ncodec == BLOCK_STORED)
+		{
+			ni = rawSize - (size_t)i*BLOCK_SIZE;
+			if (ni > BLOCK_SIZE) ni = BLOCK_SIZE;
+		}
+		hdr.push_back((unsigned int)ni);
+		nsize += sizeof(unsigned int) + ni;
+	}
+	hdr[1] = (unsigned int)nsize;
+
+	// write everything
+	if (fwrite(&hdr[0], sizeof(unsigned int), hdr.size(), m_fp) != hdr.size()) m_berror = true;
+	for (int i = 0; i < blocks; ++i)
+	{
+		const unsigned char* pd = (ncodec == BLOCK_STORED ? praw + (size_t)i*BLOCK_SIZE : &(out[i])[0]);
+		size_t ni = hdr[6 + i];
+		if (fwrite(pd, 1, ni, m_fp) != ni) m_berror = true;
+	}
+	fflush(m_fp);
+
+	m_raw.clear();
+}
+
 size_t FileStream::read(void* pd, size_t Size, size_t Count)
 {
 	return fread(pd, Size, Count, m_fp);
@@ -196,6 +345,117 @@ void FileStream::seek(long noff, int norigin)
 	fseek(m_fp, noff, norigin);
 }
 
+long long FileStream::Position()
+{
+	if (m_fp == 0) return 0;
+#ifdef WIN32
+	long long npos = _ftelli64(m_fp);
+#else
+	long long npos = ftello(m_fp);
+#endif
+	// add the data that is still in the buffer
+	return npos + (long long) m_current;
+}
+
+void FileStream::AddMark(unsigned int tag0, unsigned int tag1, unsigned int nid, size_t offset, size_t size)
+{
+	MARK m = { tag0, tag1, nid, (unsigned int) offset, (unsigned int) size };
+	m_marks.push_back(m);
+}
+
+bool FileStream::Truncate(const char* szfile, long long nsize)
+{
+#ifdef WIN32
+	int fd = -1;
+	if (_sopen_s(&fd, szfile, _O_RDWR | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE) != 0) return false;
+	bool bok = (_chsize_s(fd, nsize) == 0);
+	_close(fd);
+	return bok;
+#else
+	return (truncate(szfile, (off_t) nsize) == 0);
+#endif
+}
+
+
+//=============================================================================
+// BlockStreamReader
+//=============================================================================
+
+BlockStreamReader::BlockStreamReader()
+{
+	m_pd = 0;
+	m_ncodec = 0;
+	m_rawSize = 0;
+	m_blockSize = 0;
+}
+
+bool BlockStreamReader::Attach(const unsigned char* pd, size_t nsize)
+{
+	// read the stream header
+	unsigned int hdr[4];
+	if (nsize < sizeof(hdr)) return false;
+	memcpy(hdr, pd, sizeof(hdr));
+	m_ncodec = hdr[0];
+	m_rawSize = hdr[1];
+	m_blockSize = hdr[2];
+	int blocks = hdr[3];
+	if ((m_blockSize == 0) || (blocks != (int)((m_rawSize + m_blockSize - 1) / m_blockSize))) return false;
+
+	// read the block table
+	size_t ntable = sizeof(hdr) + blocks*sizeof(unsigned int);
+	if (nsize < ntable) return false;
+	m_size.resize(blocks);
+	if (blocks > 0) memcpy(&m_size[0], pd + sizeof(hdr), blocks*sizeof(unsigned int));
+
+	// calculate the block offsets
+	m_off.resize(blocks);
+	size_t noff = 0;
+	for (int i = 0; i < blocks; ++i)
+	{
+		m_off[i] = noff;
+		noff += m_size[i];
+	}
+	if (ntable + noff > nsize) return false;
+
+	m_pd = pd + ntable;
+	return true;
+}
+
+bool BlockStreamReader::Read(size_t noff, size_t nsize, unsigned char* pout) const
+{
+	if (nsize == 0) return true;
+	if (noff + nsize > m_rawSize) return false;
+
+	// find the blocks that we need
+	int b0 = (int)(noff / m_blockSize);
+	int b1 = (int)((noff + nsize - 1) / m_blockSize);
+
+	int nerr = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+:nerr)
+	for (int i = b0; i <= b1; ++i)
+	{
+		// range of this block and the part that we need
+		size_t r0 = (size_t)i*m_blockSize;
+		size_t r1 = r0 + m_blockSize; if (r1 > m_rawSize) r1 = m_rawSize;
+		size_t n0 = (noff > r0 ? noff : r0);
+		size_t n1 = (noff + nsize < r1 ? noff + nsize : r1);
+
+		if ((n0 == r0) && (n1 == r1))
+		{
+			// we need the entire block, so inflate it directly into the output
+			if (inflate_block(m_ncodec, m_pd + m_off[i], m_size[i], pout + (r0 - noff), r1 - r0) == false) nerr++;
+		}
+		else
+		{
+			vector<unsigned char> buf(r1 - r0);
+			if (inflate_block(m_ncodec, m_pd + m_off[i], m_size[i], &buf[0], r1 - r0))
+				memcpy(pout + (n0 - noff), &buf[0] + (n0 - r0), n1 - n0);
+			else nerr++;
+		}
+	}
+
+	return (nerr == 0);
+}
 
 //=============================================================================
 // PltArchive
@@ -207,6 +467,11 @@ PltArchive::PltArchive()
 	m_pRoot = 0;
 	m_pChunk = 0;
 	m_bSaving = true;
+	m_ncompress = 0;
+	m_ncodec = 0;
+
+	m_bstop = false;
+	m_berror = false;
 }
 
 PltArchive::~PltArchive()
@@ -219,6 +484,9 @@ void PltArchive::Close()
 	if (m_bSaving)
 	{
 		if (m_pRoot) Flush();
+
+		// make sure everything is written before we close the file
+		StopWriter();
 	}
 	else 
 	{
@@ -235,30 +503,122 @@ void PltArchive::Close()
 	}
 }
 
-void PltArchive::SetCompression(int n)
+void PltArchive::SetCompression(int n, int ncodec)
 {
-	if (m_fp) m_fp->SetCompression(n);
+	// The file stream is used by the writer thread, so we only store the
+	// settings here. They are passed to the writer with each tree.
+	m_ncompress = n;
+	m_ncodec = ncodec;
+}
+
+bool PltArchive::HasWriteError()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_berror;
 }
 
 void PltArchive::Flush()
 {
-	if (m_fp && m_pRoot)
+	if ((m_fp == 0) || (m_pRoot == 0) || HasWriteError())
+	{
+		delete m_pRoot;
+		m_pRoot = 0;
+		m_pChunk = 0;
+		return;
+	}
+
+	// start the writer if it's not running yet
+	if (m_writer.joinable() == false)
 	{
-		m_fp->BeginStreaming();
-		m_pRoot->Write(m_fp);
-		m_fp->EndStreaming();
+		m_bstop = false;
+		m_writer = std::thread(&PltArchive::WriterThread, this);
 	}
-	delete m_pRoot;
+
+	// hand the tree to the writer, but wait if the queue is full
+	QUEUE_ITEM item = { m_pRoot, m_ncompress, m_ncodec };
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(lock, [this]() { return (m_queue.size() < MAX_QUEUE); });
+		m_queue.push_back(item);
+	}
+	m_cv.notify_all();
+
+	// the writer owns the tree now
 	m_pRoot = 0;
 	m_pChunk = 0;
 }
 
+void PltArchive::GetTreeInfo(vector<TREE_INFO>& info)
+{
+	// The writer is restarted when the next tree is flushed
+	StopWriter();
+	info = m_tree;
+}
+
+void PltArchive::StopWriter()
+{
+	if (m_writer.joinable() == false) return;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bstop = true;
+	}
+	m_cv.notify_all();
+	m_writer.join();
+}
+
+void PltArchive::WriterThread()
+{
+	while (true)
+	{
+		QUEUE_ITEM item;
+		{
+			// wait for the next tree (the queue is emptied before we stop)
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this]() { return (m_bstop || (m_queue.empty() == false)); });
+			if (m_queue.empty()) break;
+			item = m_queue.front();
+			m_queue.pop_front();
+		}
+		m_cv.notify_all();
+
+		// write the tree (after an error we just discard it)
+		TREE_INFO info;
+		bool berr = m_fp->HasError();
+		if (berr == false)
+		{
+			info.id = item.pRoot->GetID();
+			info.ncompress = item.ncompress;
+			info.ncodec = item.ncodec;
+			info.pos = m_fp->Position();
+
+			m_fp->SetCompression(item.ncompress);
+			m_fp->SetBlockCompression(item.ncodec);
+			m_fp->BeginStreaming();
+			item.pRoot->Write(m_fp);
+			m_fp->EndStreaming();
+			berr = m_fp->HasError();
+
+			info.size = m_fp->Position() - info.pos;
+			info.marks = m_fp->Marks();
+		}
+		delete item.pRoot;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (berr) m_berror = true;
+			else m_tree.push_back(info);
+		}
+	}
+}
+
 bool PltArchive::Create(const char* szfile)
 {
 	// attempt to create the file
 	assert(m_fp == 0);
 	m_fp = new FileStream();
 	if (m_fp->Create(szfile) == false) return false;
+	m_berror = false;
+	m_tree.clear();
 
 	// write the root tag 
 	unsigned int ntag = 0x00464542;
@@ -328,6 +688,8 @@ bool PltArchive::Append(const char* szfile)
 	m_fp = new FileStream();
 	if (m_fp->Append(szfile) == false) return false;
 	m_bSaving = true;
+	m_berror = false;
+	m_tree.clear();
 	return true;
 }
 
@@ -397,6 +759,24 @@ void PltArchive::CloseChunk()
 	}
 }
 
+bool PltArchive::ReadBlockStream(vector<unsigned char>& data)
+{
+	if (m_Chunk.empty()) return false;
+	CHUNK* pc = m_Chunk.top();
+	if (pc->id != FileStream::BLOCK_STREAM_ID) return false;
+
+	// read the compressed data
+	vector<unsigned char> buf(pc->nsize);
+	if (buf.empty() || (m_fp->read(&buf[0], 1, buf.size()) != buf.size())) return false;
+
+	// inflate all the blocks
+	BlockStreamReader blocks;
+	if (blocks.Attach(&buf[0], buf.size()) == false) return false;
+	data.resize(blocks.Size());
+	if (data.empty()) return true;
+	return blocks.Read(0, data.size(), &data[0]);
+}
+
 unsigned int PltArchive::GetChunkID()
 {
 	CHUNK* pc = m_Chunk.top();
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FECore/Archive.h"
+#include "FECore/DataEncoding.h"
 #include <assert.h>
 #include <string>
 #include <string.h>
@@ -35,12 +36,56 @@ SOFTWARE.*/
 #include <list>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 using namespace std;
 
+// zlib stream (see zlib.h)
+struct z_stream_s;
+
 //-----------------------------------------------------------------------------
 //! helper class for writing buffered data to file
+//! The data can be written uncompressed, compressed as a single zlib stream, or 
+//! compressed in blocks. In the latter case, the data is collected in memory and
+//! split into blocks of BLOCK_SIZE bytes when streaming ends. The blocks are compressed
+//! independently (and in parallel) and written as a single chunk with layout:
+//!
+//!   BLOCK_STREAM_ID, chunk size, codec, uncompressed size, block size, number of blocks,
+//!   compressed size of each block, compressed data of each block
+//!
+//! (all values are unsigned ints). Since the blocks are independent, readers can inflate
+//! them in parallel, or only inflate the blocks that contain the data they need.
+//!
+//! The file stream also keeps track of the (uncompressed) stream position since streaming
+//! began, which is used to record marks of data that need to be found back later (see OMarkedLeaf).
 class FileStream
 {
+public:
+	// a mark of some data in the (uncompressed) stream
+	struct MARK
+	{
+		unsigned int	tag0, tag1;	// user tags
+		unsigned int	nid;		// ID of the chunk that contains the data
+		unsigned int	offset;		// offset of the data from the beginning of the stream
+		unsigned int	size;		// size of the data (in bytes)
+	};
+
+public:
+	// ID of the chunk that stores a block-compressed stream
+	enum { BLOCK_STREAM_ID = 0x03000000 };
+
+	// uncompressed size of the blocks
+	enum { BLOCK_SIZE = 1048576 };
+
+	// codecs for block compression
+	enum Block_Codec {
+		BLOCK_STORED = 0,		// blocks are not compressed (only used when zlib is not available)
+		BLOCK_ZLIB = 1,			// zlib, default compression level
+		BLOCK_ZLIB_FAST = 2		// zlib, fastest compression level
+	};
+
 public:
 	FileStream();
 	~FileStream();
@@ -64,13 +109,72 @@ public:
 
 	void SetCompression(int n) { m_ncompress = n; }
 
+	//! set the codec for block compression (0 = no block compression)
+	void SetBlockCompression(int ncodec) { m_ncodec = ncodec; }
+
+	//! returns true if writing to the file failed
+	bool HasError() const { return m_berror; }
+
+	//! file position of the next byte that will be written (only valid outside streaming)
+	long long Position();
+
+	//! number of (uncompressed) bytes written since streaming began
+	size_t StreamPosition() const { return m_rawPos; }
+
+	//! mark data in the stream
+	void AddMark(unsigned int tag0, unsigned int tag1, unsigned int nid, size_t offset, size_t size);
+
+	//! get the marks that were added since streaming began
+	const vector<MARK>& Marks() const { return m_marks; }
+
+	//! truncate a file (which must not be open)
+	static bool Truncate(const char* szfile, long long nsize);
+
+private:
+	void WriteBlocks();
+
 private:
 	FILE*	m_fp;
+	bool	m_berror;		//!< set when a write failed
 	size_t	m_bufsize;		//!< buffer size
 	size_t	m_current;		//!< current index
 	unsigned char*	m_buf;	//!< buffer
 	unsigned char*	m_pout;	//!< temp buffer when writing
 	int		m_ncompress;	//!< compression level
+	int		m_ncodec;		//!< block compression codec
+	size_t	m_rawPos;		//!< uncompressed stream position
+	z_stream_s*	m_strm;		//!< zlib stream (only used while streaming with compression)
+
+	vector<unsigned char>	m_raw;	//!< uncompressed data when block compression is used
+	vector<MARK>			m_marks;	//!< marks added since streaming began
+};
+
+//-----------------------------------------------------------------------------
+//! Helper class for reading a block-compressed stream (see FileStream). After the 
+//! block table is read, any part of the uncompressed stream can be extracted. Only 
+//! the blocks that overlap the requested range are inflated, which is done in parallel.
+class BlockStreamReader
+{
+public:
+	BlockStreamReader();
+
+	//! attach to the data of a block stream chunk (i.e. the data following the chunk header).
+	//! The data is not copied, so it must remain valid while this object is used.
+	bool Attach(const unsigned char* pd, size_t nsize);
+
+	//! size of the uncompressed stream
+	size_t Size() const { return m_rawSize; }
+
+	//! extract part of the uncompressed stream
+	bool Read(size_t noff, size_t nsize, unsigned char* pout) const;
+
+private:
+	const unsigned char*	m_pd;			//!< compressed data of first block
+	int						m_ncodec;		//!< codec
+	size_t					m_rawSize;		//!< size of uncompressed stream
+	size_t					m_blockSize;	//!< (uncompressed) block size
+	vector<size_t>			m_off;			//!< offset of each block into compressed data
+	vector<unsigned int>	m_size;			//!< compressed size of each block
 };
 
 class OBranch;
@@ -231,10 +335,90 @@ protected:
 	int		m_nsize;
 };
 
+//-----------------------------------------------------------------------------
+//! A leaf with float data that is stored with the given encoding (see DataEncoding).
+//! The data is encoded when the leaf is written, i.e. on the background writer thread.
+class OEncodedLeaf : public OChunk
+{
+public:
+	OEncodedLeaf(unsigned int nid, vector<float>& a, int nenc) : OChunk(nid), m_data(a), m_nenc(nenc) {}
+
+	int Size() { return (int)DataEncoding::Size(m_nenc, m_data.size()); }
+
+	void Write(FileStream* fp)
+	{
+		fp->Write(&m_nID, sizeof(unsigned int), 1);
+		unsigned int nsize = Size();
+		fp->Write(&nsize, sizeof(unsigned int), 1);
+		if (nsize == 0) return;
+		if (m_nenc == DataEncoding::FP32) fp->Write(&m_data[0], sizeof(float), m_data.size());
+		else
+		{
+			vector<unsigned char> buf(nsize);
+			DataEncoding::Encode(m_nenc, &m_data[0], m_data.size(), &buf[0]);
+			fp->Write(&buf[0], 1, nsize);
+		}
+	}
+
+protected:
+	vector<float>	m_data;
+	int				m_nenc;
+};
+
+//-----------------------------------------------------------------------------
+//! A data leaf whose position in the stream is recorded when it is written. 
+//! This is used to build an index of the data in a plot file.
+class OMarkedLeaf : public OEncodedLeaf
+{
+public:
+	OMarkedLeaf(unsigned int nid, vector<float>& a, unsigned int tag0, unsigned int tag1, int nenc = DataEncoding::FP32) : OEncodedLeaf(nid, a, nenc)
+	{
+		m_tag0 = tag0;
+		m_tag1 = tag1;
+	}
+
+	void Write(FileStream* fp)
+	{
+		// the data follows the chunk ID and size
+		fp->AddMark(m_tag0, m_tag1, m_nID, fp->StreamPosition() + 2*sizeof(unsigned int), Size());
+		OEncodedLeaf::Write(fp);
+	}
+
+protected:
+	unsigned int	m_tag0, m_tag1;
+};
+
 //-----------------------------------------------------------------------------
 //! Implementation of an archiving class. Will be used by the FEBioPlotFile class.
+//! When writing, the chunks are collected in a tree, which is written to file when
+//! the root chunk is closed. The serialization, compression and file output of the
+//! tree is done on a background thread, so that the caller can continue while the
+//! data is written. At most MAX_QUEUE trees can be waiting to be written, after which
+//! the caller blocks until the writer catches up. Close() waits for all data to be written.
 class PltArchive : public Archive
 {
+	enum { MAX_QUEUE = 2 };
+
+	// a tree that is waiting to be written
+	struct QUEUE_ITEM
+	{
+		OBranch*	pRoot;		// the chunk tree
+		int			ncompress;	// compression level
+		int			ncodec;		// block compression codec
+	};
+
+public:
+	// Describes where a tree was written to the file
+	struct TREE_INFO
+	{
+		unsigned int	id;			// ID of the root chunk
+		long long		pos;		// file position
+		long long		size;		// size in the file
+		int				ncompress;	// compression level
+		int				ncodec;		// block compression codec
+		vector<FileStream::MARK>	marks;	// marked data (offsets are relative to the uncompressed tree)
+	};
+
 protected:
 	// CHUNK data structure for reading
 	struct CHUNK
@@ -300,6 +484,23 @@ public:
 		WriteChunk(nid, data);
 	}
 
+	// write data with reduced precision (see DataEncoding)
+	void WriteData(int nid, std::vector<float>& data, int nenc)
+	{
+		if (nenc == DataEncoding::FP32) WriteChunk(nid, data);
+		else m_pChunk->AddChild(new OEncodedLeaf(nid, data, nenc));
+	}
+
+	// same as WriteData, but the position of the data is recorded in the tree info
+	void WriteMarkedData(int nid, std::vector<float>& data, unsigned int tag0, unsigned int tag1, int nenc = DataEncoding::FP32)
+	{
+		m_pChunk->AddChild(new OMarkedLeaf(nid, data, tag0, tag1, nenc));
+	}
+
+	// get the info of all the trees that were written since the file was created or opened
+	// for appending. This waits until the background writer is done.
+	void GetTreeInfo(vector<TREE_INFO>& info);
+
 
 public:
 	// --- Reading ---
@@ -342,13 +543,40 @@ public:
 		return IO_OK;
 	}
 
-	void SetCompression(int n);
+	// read a block-compressed stream, i.e. the data of a BLOCK_STREAM_ID chunk (which must be open)
+	bool ReadBlockStream(vector<unsigned char>& data);
+
+	// set the compression. If ncodec is not zero, block compression is used (see FileStream).
+	void SetCompression(int n, int ncodec = 0);
 
 	bool IsValid() const { return (m_fp != 0); }
 
+	bool IsSaving() const { return m_bSaving; }
+
+	//! returns true if the background writer failed to write to the file
+	bool HasWriteError();
+
+protected:
+	// wait until all trees were written and stop the writer thread
+	void StopWriter();
+
+	// the function run by the writer thread
+	void WriterThread();
+
 protected:
 	FileStream*	m_fp;		// pointer to file stream
 	bool		m_bSaving;	// read or write mode?
+	int			m_ncompress;	// compression level for the next trees
+	int			m_ncodec;		// block compression codec for the next trees
+
+	// background writer
+	std::thread				m_writer;	// writer thread
+	std::mutex				m_mutex;	// protects the data below
+	std::condition_variable	m_cv;		// signals changes to the queue
+	deque<QUEUE_ITEM>		m_queue;	// trees waiting to be written
+	bool					m_bstop;	// tells the writer to stop
+	bool					m_berror;	// the writer failed writing to the file
+	vector<TREE_INFO>		m_tree;		// info of the trees that were written
 
 	// write data
 	OBranch*	m_pRoot;	// chunk tree root
@@ -0,0 +1,591 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "PltReader.h"
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_ZLIB
+#include "zlib.h"
+#endif
+
+//-----------------------------------------------------------------------------
+// read the header of the chunk at position p. Returns false if the chunk does not end before end.
+static bool read_chunk(const unsigned char* pd, size_t p, size_t end, unsigned int& id, size_t& size)
+{
+	if (p + 2*sizeof(unsigned int) > end) return false;
+	unsigned int hdr[2];
+	memcpy(hdr, pd + p, sizeof(hdr));
+	id = hdr[0];
+	size = hdr[1];
+	return (p + sizeof(hdr) + size <= end);
+}
+
+//-----------------------------------------------------------------------------
+// read a value from a leaf chunk
+template <typename T> static bool read_value(const unsigned char* pd, size_t size, T& v)
+{
+	if (size != sizeof(T)) return false;
+	memcpy(&v, pd, sizeof(T));
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Inflate a zlib stream. If nmax is not zero, the inflation stops once nmax bytes are inflated.
+// Otherwise, the entire stream is inflated and nused returns the size of the compressed stream.
+static bool inflate_stream(const unsigned char* pd, size_t nsize, size_t nmax, vector<unsigned char>& out, size_t& nused)
+{
+#ifdef HAVE_ZLIB
+	z_stream strm;
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	strm.avail_in = 0;
+	strm.next_in = Z_NULL;
+	if (inflateInit(&strm) != Z_OK) return false;
+
+	const size_t CHUNK = 262144;
+	out.resize(nmax > 0 ? nmax : CHUNK);
+	size_t nout = 0;
+	size_t nin = 0;
+	int ret = Z_OK;
+	do
+	{
+		// provide the input in parts, since avail_in is only 32 bits
+		if ((strm.avail_in == 0) && (nin < nsize))
+		{
+			size_t n = nsize - nin; if (n > CHUNK) n = CHUNK;
+			strm.next_in = (Bytef*)(pd + nin);
+			strm.avail_in = (uInt)n;
+			nin += n;
+		}
+
+		if (nout == out.size()) out.resize(2 * out.size());
+		size_t n = out.size() - nout; if (n > CHUNK) n = CHUNK;
+		strm.next_out = &out[0] + nout;
+		strm.avail_out = (uInt)n;
+
+		ret = inflate(&strm, Z_NO_FLUSH);
+		nout += n - strm.avail_out;
+
+		if ((ret != Z_OK) && (ret != Z_STREAM_END) && (ret != Z_BUF_ERROR)) break;
+		if ((ret == Z_BUF_ERROR) && (strm.avail_in == 0) && (nin == nsize)) break;
+	}
+	while ((ret != Z_STREAM_END) && ((nmax == 0) || (nout < nmax)));
+
+	nused = nin - strm.avail_in;
+	inflateEnd(&strm);
+
+	out.resize(nout);
+	if (nmax > 0) return (nout >= nmax);
+	return (ret == Z_STREAM_END);
+#else
+	return false;
+#endif
+}
+
+//=============================================================================
+PltReader::PltReader()
+{
+	m_pd = 0;
+	m_size = 0;
+#ifdef WIN32
+	m_hfile = INVALID_HANDLE_VALUE;
+	m_hmap = 0;
+#else
+	m_fd = -1;
+#endif
+	m_ncompress = 0;
+	m_ncodec = 0;
+	m_rootEnd = 0;
+	m_dataEnd = 0;
+	m_bhasIndex = false;
+	m_cacheState = -1;
+}
+
+//-----------------------------------------------------------------------------
+PltReader::~PltReader()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+bool PltReader::Open(const char* szfile)
+{
+	Close();
+
+	// map the file
+	if (Map(szfile) == false) return false;
+
+	// check the file tag
+	unsigned int ntag = 0;
+	if ((size_t)m_size >= sizeof(ntag)) memcpy(&ntag, m_pd, sizeof(ntag));
+	if (ntag != 0x00464542) { Close(); return false; }
+
+	// read the header and dictionary
+	if (ReadRoot() == false) { Close(); return false; }
+
+	// read the index, or rebuild it if the file doesn't have one
+	m_bhasIndex = ReadIndex();
+	if (m_bhasIndex == false)
+	{
+		if (BuildIndex() == false) { Close(); return false; }
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void PltReader::Close()
+{
+	Unmap();
+	m_ncompress = 0;
+	m_ncodec = 0;
+	m_rootEnd = 0;
+	m_dataEnd = 0;
+	m_bhasIndex = false;
+	m_var.clear();
+	m_state.clear();
+	m_cacheState = -1;
+	m_cache.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool PltReader::Map(const char* szfile)
+{
+#ifdef WIN32
+	HANDLE hfile = CreateFileA(szfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hfile == INVALID_HANDLE_VALUE) return false;
+	m_hfile = hfile;
+
+	LARGE_INTEGER size;
+	if ((GetFileSizeEx(hfile, &size) == FALSE) || (size.QuadPart == 0)) { Unmap(); return false; }
+	m_size = size.QuadPart;
+
+	m_hmap = CreateFileMappingA(hfile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (m_hmap == 0) { Unmap(); return false; }
+
+	m_pd = (const unsigned char*)MapViewOfFile((HANDLE)m_hmap, FILE_MAP_READ, 0, 0, 0);
+	if (m_pd == 0) { Unmap(); return false; }
+#else
+	m_fd = open(szfile, O_RDONLY);
+	if (m_fd < 0) return false;
+
+	struct stat st;
+	if ((fstat(m_fd, &st) != 0) || (st.st_size == 0)) { Unmap(); return false; }
+	m_size = st.st_size;
+
+	void* pd = mmap(0, (size_t)m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+	if (pd == MAP_FAILED) { Unmap(); return false; }
+	m_pd = (const unsigned char*)pd;
+#endif
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void PltReader::Unmap()
+{
+#ifdef WIN32
+	if (m_pd) UnmapViewOfFile(m_pd);
+	if (m_hmap) CloseHandle((HANDLE)m_hmap);
+	if (m_hfile != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)m_hfile);
+	m_hmap = 0;
+	m_hfile = INVALID_HANDLE_VALUE;
+#else
+	if (m_pd) munmap((void*)m_pd, (size_t)m_size);
+	if (m_fd >= 0) close(m_fd);
+	m_fd = -1;
+#endif
+	m_pd = 0;
+	m_size = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Read the header and the dictionary
+bool PltReader::ReadRoot()
+{
+	unsigned int id;
+	size_t size;
+	size_t p0 = sizeof(unsigned int);
+	if ((read_chunk(m_pd, p0, (size_t)m_size, id, size) == false) || (id != FEBioPlotFile::PLT_ROOT)) return false;
+	size_t end = p0 + 2*sizeof(unsigned int) + size;
+	m_rootEnd = end;
+
+	for (size_t p = p0 + 8; read_chunk(m_pd, p, end, id, size); p += 8 + size)
+	{
+		size_t end1 = p + 8 + size;
+		if (id == FEBioPlotFile::PLT_HEADER)
+		{
+			unsigned int id2; size_t size2;
+			for (size_t q = p + 8; read_chunk(m_pd, q, end1, id2, size2); q += 8 + size2)
+			{
+				if      (id2 == FEBioPlotFile::PLT_HDR_COMPRESSION      ) read_value(m_pd + q + 8, size2, m_ncompress);
+				else if (id2 == FEBioPlotFile::PLT_HDR_BLOCK_COMPRESSION) read_value(m_pd + q + 8, size2, m_ncodec);
+			}
+		}
+		else if (id == FEBioPlotFile::PLT_DICTIONARY)
+		{
+			unsigned int id2; size_t size2;
+			for (size_t q = p + 8; read_chunk(m_pd, q, end1, id2, size2); q += 8 + size2)
+			{
+				unsigned int nsection = 0;
+				switch (id2)
+				{
+				case FEBioPlotFile::PLT_DIC_NODAL  : nsection = FEBioPlotFile::PLT_NODE_DATA; break;
+				case FEBioPlotFile::PLT_DIC_DOMAIN : nsection = FEBioPlotFile::PLT_ELEMENT_DATA; break;
+				case FEBioPlotFile::PLT_DIC_SURFACE: nsection = FEBioPlotFile::PLT_FACE_DATA; break;
+				default:
+					continue;
+				}
+
+				// the variable IDs are the one-based positions in the list
+				int nvar = 0;
+				size_t end2 = q + 8 + size2;
+				unsigned int id3; size_t size3;
+				for (size_t r = q + 8; read_chunk(m_pd, r, end2, id3, size3); r += 8 + size3)
+				{
+					if (id3 != FEBioPlotFile::PLT_DIC_ITEM) continue;
+					Variable v;
+					v.section = nsection;
+					v.id = ++nvar;
+					v.encoding = DataEncoding::FP32;
+
+					size_t end3 = r + 8 + size3;
+					unsigned int id4; size_t size4;
+					for (size_t t = r + 8; read_chunk(m_pd, t, end3, id4, size4); t += 8 + size4)
+					{
+						if (id4 == FEBioPlotFile::PLT_DIC_ITEM_NAME)
+						{
+							const char* sz = (const char*)(m_pd + t + 8);
+							v.name.assign(sz, strnlen(sz, size4));
+						}
+						else if (id4 == FEBioPlotFile::PLT_DIC_ITEM_ENCODING) read_value(m_pd + t + 8, size4, v.encoding);
+					}
+					m_var.push_back(v);
+				}
+			}
+		}
+	}
+
+	// for block compression the compression flag is zero
+	if (m_ncodec) m_ncompress = 1;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Read the index. Returns false if the file does not have a (valid) index.
+bool PltReader::ReadIndex()
+{
+	// the index position is stored in the last chunk of the file
+	const size_t ntrailer = 4*sizeof(unsigned int) + sizeof(long long);
+	size_t nsize = (size_t)m_size;
+	if (nsize < m_rootEnd + ntrailer) return false;
+
+	unsigned int id;
+	size_t size;
+	size_t p0 = nsize - ntrailer;
+	if ((read_chunk(m_pd, p0, nsize, id, size) == false) || (id != FEBioPlotFile::PLT_INDEX_END)) return false;
+	if ((read_chunk(m_pd, p0 + 8, nsize, id, size) == false) || (id != FEBioPlotFile::PLT_INDEX_END_POS)) return false;
+	long long npos = 0;
+	if (read_value(m_pd + p0 + 16, size, npos) == false) return false;
+
+	// the index must end where the trailer starts
+	if ((npos < m_rootEnd) || (npos >= (long long)p0)) return false;
+	size_t pi = (size_t)npos;
+	if ((read_chunk(m_pd, pi, p0, id, size) == false) || (id != FEBioPlotFile::PLT_INDEX) || (pi + 8 + size != p0)) return false;
+
+	vector<IndexState> index;
+	for (size_t p = pi + 8; read_chunk(m_pd, p, p0, id, size); p += 8 + size)
+	{
+		if (id != FEBioPlotFile::PLT_INDEX_STATE) continue;
+
+		IndexState s;
+		s.time = 0.f;
+		s.pos = s.size = 0;
+		s.compression = IndexState::RAW;
+
+		size_t end = p + 8 + size;
+		unsigned int id2; size_t size2;
+		for (size_t q = p + 8; read_chunk(m_pd, q, end, id2, size2); q += 8 + size2)
+		{
+			const unsigned char* pd = m_pd + q + 8;
+			switch (id2)
+			{
+			case FEBioPlotFile::PLT_INDEX_TIME       : read_value(pd, size2, s.time); break;
+			case FEBioPlotFile::PLT_INDEX_POS        : read_value(pd, size2, s.pos); break;
+			case FEBioPlotFile::PLT_INDEX_SIZE       : read_value(pd, size2, s.size); break;
+			case FEBioPlotFile::PLT_INDEX_COMPRESSION: read_value(pd, size2, s.compression); break;
+			case FEBioPlotFile::PLT_INDEX_FIELDS:
+				{
+					int nfields = (int)(size2 / sizeof(IndexField));
+					s.fields.resize(nfields);
+					if (nfields > 0) memcpy(&s.fields[0], pd, nfields*sizeof(IndexField));
+				}
+				break;
+			}
+		}
+
+		// make sure the state is inside the data section
+		if ((s.pos < m_rootEnd) || (s.pos + s.size > npos)) return false;
+
+		index.push_back(s);
+	}
+
+	m_state = index;
+	m_dataEnd = npos;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Build the index by scanning the file. This stops at the first incomplete state, which
+// happens when the run was aborted while writing the file.
+bool PltReader::BuildIndex()
+{
+	m_state.clear();
+	m_dataEnd = m_rootEnd;
+
+	size_t nsize = (size_t)m_size;
+	size_t p = (size_t)m_rootEnd;
+	vector<unsigned char> buf;
+	while (p < nsize)
+	{
+		unsigned int id;
+		size_t size;
+
+		// Stop when we reach an index. This can happen when an index was not completely
+		// written, or was not removed when appending.
+		if (p + sizeof(unsigned int) > nsize) break;
+		memcpy(&id, m_pd + p, sizeof(unsigned int));
+		if ((id == FEBioPlotFile::PLT_INDEX) || (id == FEBioPlotFile::PLT_INDEX_END)) break;
+
+		IndexState s;
+		s.pos = p;
+		bool bstate = false;
+		if ((id == FEBioPlotFile::PLT_MESH) || (id == FEBioPlotFile::PLT_STATE))
+		{
+			// uncompressed tree (the first mesh section is never compressed)
+			if (read_chunk(m_pd, p, nsize, id, size) == false) break;
+			if (id == FEBioPlotFile::PLT_STATE)
+			{
+				s.compression = IndexState::RAW;
+				if (ParseState(m_pd + p, size + 8, s) == false) break;
+				bstate = true;
+			}
+			size += 8;
+		}
+		else if (id == FileStream::BLOCK_STREAM_ID)
+		{
+			// block-compressed tree
+			if (read_chunk(m_pd, p, nsize, id, size) == false) break;
+
+			BlockStreamReader blocks;
+			if (blocks.Attach(m_pd + p + 8, size) == false) break;
+			unsigned int nid = 0;
+			if ((blocks.Size() >= sizeof(nid)) && (blocks.Read(0, sizeof(nid), (unsigned char*)&nid) == false)) break;
+
+			if (nid == FEBioPlotFile::PLT_STATE)
+			{
+				buf.resize(blocks.Size());
+				if (blocks.Read(0, buf.size(), &buf[0]) == false) break;
+				s.compression = IndexState::BLOCKS;
+				if (ParseState(&buf[0], buf.size(), s) == false) break;
+				bstate = true;
+			}
+			size += 8;
+		}
+		else if (m_ncompress)
+		{
+			// the tree is stored as a zlib stream, so we need to inflate it to find its end
+			if (inflate_stream(m_pd + p, nsize - p, 0, buf, size) == false) break;
+
+			if ((buf.size() >= sizeof(unsigned int)) && (*(unsigned int*)&buf[0] == FEBioPlotFile::PLT_STATE))
+			{
+				s.compression = IndexState::ZLIB_STREAM;
+				if (ParseState(&buf[0], buf.size(), s) == false) break;
+				bstate = true;
+			}
+		}
+		else break;
+
+		s.size = size;
+		if (bstate) m_state.push_back(s);
+
+		p += size;
+		m_dataEnd = p;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Find the time and the data of the variables in an (uncompressed) state
+bool PltReader::ParseState(const unsigned char* pd, size_t nsize, IndexState& s)
+{
+	unsigned int id;
+	size_t size;
+	if ((read_chunk(pd, 0, nsize, id, size) == false) || (id != FEBioPlotFile::PLT_STATE)) return false;
+
+	s.time = 0.f;
+	s.fields.clear();
+
+	size_t end = 8 + size;
+	for (size_t p = 8; read_chunk(pd, p, end, id, size); p += 8 + size)
+	{
+		size_t end1 = p + 8 + size;
+		unsigned int id1; size_t size1;
+		if (id == FEBioPlotFile::PLT_STATE_HEADER)
+		{
+			for (size_t q = p + 8; read_chunk(pd, q, end1, id1, size1); q += 8 + size1)
+			{
+				if (id1 == FEBioPlotFile::PLT_STATE_HDR_TIME) read_value(pd + q + 8, size1, s.time);
+			}
+		}
+		else if (id == FEBioPlotFile::PLT_STATE_DATA)
+		{
+			// loop over the node, element and face data sections
+			for (size_t q = p + 8; read_chunk(pd, q, end1, id1, size1); q += 8 + size1)
+			{
+				unsigned int nsection = id1;
+				size_t end2 = q + 8 + size1;
+				unsigned int id2; size_t size2;
+				for (size_t r = q + 8; read_chunk(pd, r, end2, id2, size2); r += 8 + size2)
+				{
+					if (id2 != FEBioPlotFile::PLT_STATE_VARIABLE) continue;
+
+					unsigned int nvar = 0;
+					size_t end3 = r + 8 + size2;
+					unsigned int id3; size_t size3;
+					for (size_t t = r + 8; read_chunk(pd, t, end3, id3, size3); t += 8 + size3)
+					{
+						if (id3 == FEBioPlotFile::PLT_STATE_VAR_ID) read_value(pd + t + 8, size3, nvar);
+						else if (id3 == FEBioPlotFile::PLT_STATE_VAR_DATA)
+						{
+							// the data of each region is stored in a chunk with the region ID
+							size_t end4 = t + 8 + size3;
+							unsigned int id4; size_t size4;
+							for (size_t u = t + 8; read_chunk(pd, u, end4, id4, size4); u += 8 + size4)
+							{
+								IndexField f = { nsection, nvar, id4, (unsigned int)(u + 8), (unsigned int)size4 };
+								s.fields.push_back(f);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+int PltReader::FindVariable(const char* szname, unsigned int& nsection) const
+{
+	for (size_t i = 0; i < m_var.size(); ++i)
+	{
+		if (m_var[i].name == szname)
+		{
+			nsection = m_var[i].section;
+			return m_var[i].id;
+		}
+	}
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+bool PltReader::ReadField(int nstate, unsigned int nsection, int nvar, int nregion, vector<float>& data)
+{
+	if ((nstate < 0) || (nstate >= States())) return false;
+	const IndexState& s = m_state[nstate];
+
+	// find the field
+	const IndexField* pf = 0;
+	for (size_t i = 0; i < s.fields.size(); ++i)
+	{
+		const IndexField& f = s.fields[i];
+		if ((f.section == nsection) && (f.var == (unsigned int)nvar) && (f.region == (unsigned int)nregion)) { pf = &f; break; }
+	}
+	if (pf == 0) return false;
+
+	// find the encoding of the variable
+	int nenc = DataEncoding::FP32;
+	for (size_t i = 0; i < m_var.size(); ++i)
+	{
+		if ((m_var[i].section == nsection) && (m_var[i].id == nvar)) { nenc = m_var[i].encoding; break; }
+	}
+
+	data.clear();
+	size_t nsize = pf->size;
+	if (nsize == 0) return true;
+	m_buf.resize(nsize);
+	unsigned char* pout = &m_buf[0];
+
+	switch (s.compression)
+	{
+	case IndexState::RAW:
+		{
+			if (s.pos + pf->offset + nsize > (size_t)m_size) return false;
+			memcpy(pout, m_pd + s.pos + pf->offset, nsize);
+		}
+		break;
+	case IndexState::BLOCKS:
+		{
+			// skip the block stream chunk header
+			BlockStreamReader blocks;
+			if (blocks.Attach(m_pd + s.pos + 8, (size_t)s.size - 8) == false) return false;
+			if (blocks.Read(pf->offset, nsize, pout) == false) return false;
+		}
+		break;
+	case IndexState::ZLIB_STREAM:
+		{
+			// inflate the state up to the end of the data we need (unless it's already in the cache)
+			size_t nend = pf->offset + nsize;
+			if ((m_cacheState != nstate) || (m_cache.size() < nend))
+			{
+				size_t nused;
+				m_cacheState = -1;
+				if (inflate_stream(m_pd + s.pos, (size_t)s.size, nend, m_cache, nused) == false) return false;
+				m_cacheState = nstate;
+			}
+			memcpy(pout, &m_cache[0] + pf->offset, nsize);
+		}
+		break;
+	default:
+		return false;
+	}
+
+	return DataEncoding::Decode(nenc, pout, nsize, data);
+}
@@ -0,0 +1,132 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "FEBioPlotFile.h"
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Random-access reader for the state data of plot files.
+//! The file is memory-mapped, so only the parts of the file that are accessed
+//! are read from disk. If the file has an index (see FEBioPlotFile::SetIndex), the
+//! data of a plot variable in a state is located directly from the index. Otherwise,
+//! the index is rebuilt when the file is opened by scanning all the states, which
+//! requires reading (and inflating) the entire file.
+//!
+//! Uncompressed and block-compressed data is extracted directly. For states that
+//! are compressed as a single zlib stream the state is inflated up to the requested
+//! data, and the inflated data is cached for subsequent reads of the same state.
+class PltReader
+{
+public:
+	typedef FEBioPlotFile::IndexField	IndexField;
+	typedef FEBioPlotFile::IndexState	IndexState;
+
+	// a plot variable in the dictionary
+	struct Variable
+	{
+		std::string		name;		// variable name
+		unsigned int	section;	// PLT_NODE_DATA, PLT_ELEMENT_DATA, or PLT_FACE_DATA
+		int				id;			// variable ID (one-based)
+		int				encoding;	// data encoding (see DataEncoding)
+	};
+
+public:
+	PltReader();
+	~PltReader();
+
+	//! open a plot file
+	bool Open(const char* szfile);
+
+	//! close the file
+	void Close();
+
+	//! number of states
+	int States() const { return (int)m_state.size(); }
+
+	//! time of a state
+	float StateTime(int n) const { return m_state[n].time; }
+
+	//! the index entry of a state
+	const IndexState& State(int n) const { return m_state[n]; }
+
+	//! the index of all states
+	const std::vector<IndexState>& Index() const { return m_state; }
+
+	//! returns true if the index was read from the file (instead of rebuilt)
+	bool HasIndex() const { return m_bhasIndex; }
+
+	//! the plot variables in the dictionary
+	const std::vector<Variable>& Variables() const { return m_var; }
+
+	//! find a variable. Returns the variable ID and section, or -1 if the variable is not found.
+	int FindVariable(const char* szname, unsigned int& nsection) const;
+
+	//! read the data of a variable in a region for a state (reduced precision data is decoded)
+	bool ReadField(int nstate, unsigned int nsection, int nvar, int nregion, std::vector<float>& data);
+
+	//! end of the last complete state, mesh, or root section (i.e. before the index or any incomplete data)
+	long long DataEnd() const { return m_dataEnd; }
+
+	//! size of the file
+	long long FileSize() const { return m_size; }
+
+protected:
+	bool Map(const char* szfile);
+	void Unmap();
+
+	bool ReadRoot();
+	bool ReadIndex();
+	bool BuildIndex();
+	bool ParseState(const unsigned char* pd, size_t nsize, IndexState& s);
+
+protected:
+	const unsigned char*	m_pd;		// mapped file
+	long long				m_size;		// size of the file
+#ifdef WIN32
+	void*	m_hfile;	// file handle
+	void*	m_hmap;		// file mapping handle
+#else
+	int		m_fd;		// file descriptor
+#endif
+
+	int		m_ncompress;	// compression flag
+	int		m_ncodec;		// block compression codec
+
+	long long	m_rootEnd;		// end of the root section
+	long long	m_dataEnd;		// end of the state data
+	bool		m_bhasIndex;	// the index was read from file
+
+	std::vector<Variable>	m_var;		// dictionary
+	std::vector<IndexState>	m_state;	// state index
+
+	int							m_cacheState;	// state that is (partially) in the cache
+	std::vector<unsigned char>	m_cache;		// inflated data of a stream-compressed state
+	std::vector<unsigned char>	m_buf;			// encoded data of a field
+};
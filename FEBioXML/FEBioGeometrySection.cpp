@@ -1333,6 +1333,14 @@ void FEBioGeometrySection25::ParseElementSection(XMLTag& tag)
 		if (strcmp(szactive, "false") == 0) pdom->SetActive(false);
 	}
 
+	// reference geometry cache flag
+	const char* szcache = tag.AttributeValue("cache_geometry", true);
+	if (szcache && (strcmp(szcache, "true") == 0))
+	{
+		FESolidDomain* psd = dynamic_cast<FESolidDomain*>(pdom);
+		if (psd) psd->CacheReferenceGeometry(true);
+	}
+
 	// count elements
 	vector<FEModelBuilder::ELEMENT> elemList; elemList.reserve(512000);
 	++tag;
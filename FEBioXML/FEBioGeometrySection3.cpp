@@ -421,6 +421,14 @@ void FEBioGeometrySection3::ParseElementSection(XMLTag& tag)
 		if (strcmp(szactive, "false") == 0) pdom->SetActive(false);
 	}
 
+	// reference geometry cache flag
+	const char* szcache = tag.AttributeValue("cache_geometry", true);
+	if (szcache && (strcmp(szcache, "true") == 0))
+	{
+		FESolidDomain* psd = dynamic_cast<FESolidDomain*>(pdom);
+		if (psd) psd->CacheReferenceGeometry(true);
+	}
+
 	// count elements
 	int elems = tag.children();
 	assert(elems);
@@ -151,13 +151,15 @@ FEBioImport::PlotVariable::PlotVariable(const FEBioImport::PlotVariable& pv)
 	strcpy(m_szvar, pv.m_szvar);
     strcpy(m_szdom, pv.m_szdom);
 	m_item = pv.m_item;
+	m_nenc = pv.m_nenc;
 }
 
-FEBioImport::PlotVariable::PlotVariable(const std::string& var, vector<int>& item, const char* szdom)
+FEBioImport::PlotVariable::PlotVariable(const std::string& var, vector<int>& item, const char* szdom, int nenc)
 {
     strcpy(m_szvar, var.c_str());
     m_item = item;
     strcpy(m_szdom, szdom);
+	m_nenc = nenc;
 }
 
 //-----------------------------------------------------------------------------
@@ -267,6 +269,8 @@ bool FEBioImport::Load(FEModel& fem, const char* szfile)
 	m_szplot_type[0] = 0;
 	m_plot.clear();
 	m_nplot_compression = 0;
+	m_nplot_codec = 0;
+	m_bplot_index = false;
 
 	m_data.clear();
 
@@ -469,16 +473,23 @@ void FEBioImport::AddDataRecord(DataRecord* pd)
 }
 
 //-----------------------------------------------------------------------------
-void FEBioImport::AddPlotVariable(const char* szvar, vector<int>& item, const char* szdom)
+void FEBioImport::AddPlotVariable(const char* szvar, vector<int>& item, const char* szdom, int nenc)
 {
-    PlotVariable var(szvar, item, szdom);
+    PlotVariable var(szvar, item, szdom, nenc);
     m_plot.push_back(var);
 }
 
 //-----------------------------------------------------------------------------
-void FEBioImport::SetPlotCompression(int n)
+void FEBioImport::SetPlotCompression(int n, int ncodec)
 {
 	m_nplot_compression = n;
+	m_nplot_codec = ncodec;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioImport::SetPlotIndex(bool b)
+{
+	m_bplot_index = b;
 }
 
 //-----------------------------------------------------------------------------
@@ -145,12 +145,13 @@ public:
 	{
 	public:
 		PlotVariable(const PlotVariable& pv);
-        PlotVariable(const std::string& var, vector<int>& item, const char* szdom = "");
+        PlotVariable(const std::string& var, vector<int>& item, const char* szdom = "", int nenc = 0);
         
 	public:
 		char		m_szvar[128];	//!< name of output variable
         char        m_szdom[128];    //!< (optional) name of domain
 		vector<int>	m_item;			//!< (optional) list of items
+		int			m_nenc;			//!< data encoding (see DataEncoding in FECore/DataEncoding.h)
 	};
 
 public:
@@ -171,9 +172,11 @@ public:
 	void SetLogfileName (const char* sz);
 	void SetPlotfileName(const char* sz);
 
-    void AddPlotVariable(const char* szvar, vector<int>& item, const char* szdom = "");
+    void AddPlotVariable(const char* szvar, vector<int>& item, const char* szdom = "", int nenc = 0);
 
-	void SetPlotCompression(int n);
+	void SetPlotCompression(int n, int ncodec = 0);
+
+	void SetPlotIndex(bool b);
     
 	void AddDataRecord(DataRecord* pd);
 
@@ -196,6 +199,8 @@ public:
 	char					m_szplot_type[256];
 	vector<PlotVariable>	m_plot;
 	int						m_nplot_compression;
+	int						m_nplot_codec;
+	bool					m_bplot_index;
 
 	vector<DataRecord*>		m_data;
 };
@@ -34,6 +34,7 @@ SOFTWARE.*/
 #include "FECore/NLConstraintDataRecord.h"
 #include "FECore/FEModel.h"
 #include <FECore/FEModelData.h>
+#include <FECore/DataEncoding.h>
 
 //-----------------------------------------------------------------------------
 void FEBioOutputSection::Parse(XMLTag& tag)
@@ -318,6 +319,20 @@ void FEBioOutputSection::ParsePlotfile(XMLTag &tag)
 				vector<int> item;
 				if (tag.isempty() == false) tag.value(item);
 
+				// The optional precision attribute sets how the data is stored:
+				// "fp32" (default), "fp16" (half precision), or "q16" and "q8" (16-bit and 8-bit fixed point
+				// with a scale and offset that is stored with the data). See DataEncoding for the loss of precision.
+				int nenc = DataEncoding::FP32;
+				const char* szprec = tag.AttributeValue("precision", true);
+				if (szprec)
+				{
+					if      (strcmp(szprec, "fp32") == 0) nenc = DataEncoding::FP32;
+					else if (strcmp(szprec, "fp16") == 0) nenc = DataEncoding::FP16;
+					else if (strcmp(szprec, "q16" ) == 0) nenc = DataEncoding::Q16;
+					else if (strcmp(szprec, "q8"  ) == 0) nenc = DataEncoding::Q8;
+					else throw XMLReader::InvalidAttributeValue(tag, "precision", szprec);
+				}
+
                 // see if a surface is referenced
                 const char* szset = tag.AttributeValue("surface", true);
                 if (szset)
@@ -339,21 +354,42 @@ void FEBioOutputSection::ParsePlotfile(XMLTag &tag)
 
                         // Add the plot variable
                         const std::string& surfName = psurf->GetName();
-						GetFEBioImport()->AddPlotVariable(szt, item, surfName.c_str());
+						GetFEBioImport()->AddPlotVariable(szt, item, surfName.c_str(), nenc);
                     }
                     else throw XMLReader::InvalidAttributeValue(tag, "set", szset);
                 }
                 else
                 {
                     // Add the plot variable
-					GetFEBioImport()->AddPlotVariable(szt, item);
+					GetFEBioImport()->AddPlotVariable(szt, item, "", nenc);
                 }
 			}
 			else if (tag=="compression")
 			{
 				int ncomp;
 				tag.value(ncomp);
-				GetFEBioImport()->SetPlotCompression(ncomp);
+
+				// The optional type attribute selects how the states are compressed:
+				// "stream" compresses each state as one zlib stream (default), 
+				// "block" and "block_fast" split the states in blocks that are compressed in parallel.
+				int ncodec = 0;
+				const char* sztype = tag.AttributeValue("type", true);
+				if (sztype)
+				{
+					if      (strcmp(sztype, "stream"    ) == 0) ncodec = 0;
+					else if (strcmp(sztype, "block"     ) == 0) ncodec = 1;
+					else if (strcmp(sztype, "block_fast") == 0) ncodec = 2;
+					else throw XMLReader::InvalidAttributeValue(tag, "type", sztype);
+				}
+
+				GetFEBioImport()->SetPlotCompression(ncomp, ncodec);
+			}
+			else if (tag == "index")
+			{
+				// write an index of the states at the end of the plot file
+				bool bindex;
+				tag.value(bindex);
+				GetFEBioImport()->SetPlotIndex(bindex);
 			}
 			++tag;
 		}
@@ -85,13 +85,13 @@ FEModelBuilder* FEFileSection::GetBuilder() { return m_pim->GetBuilder(); }
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, int& n)
 {
-	n = atoi(tag.szvalue());
+	tag.value(n);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, double& g)
 {
-	g = atof(tag.szvalue());
+	tag.value(g);
 }
 
 //-----------------------------------------------------------------------------
@@ -103,32 +103,54 @@ void FEFileSection::value(XMLTag& tag, bool& b)
 	b = (n != 0);
 }
 
+//-----------------------------------------------------------------------------
+// Read n comma-separated numbers from the tag's value (as sscanf with the format
+// "%lg,%lg,...") and return the number of values that were read. The value is
+// read directly from the file buffer, so this is used for the (large) lists of
+// nodal coordinates.
+static int read_numbers(XMLTag& tag, double* v, int n)
+{
+	const char *sz, *se;
+	tag.view(sz, se);
+	for (int i = 0; i < n; ++i)
+	{
+		if (i > 0)
+		{
+			if ((sz == se) || (*sz != ',')) return i;
+			++sz;
+		}
+		const char* ch = xml_parse_double(sz, se, v[i]);
+		if (ch == sz) return i;
+		sz = ch;
+	}
+	return n;
+}
+
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, vec3d& v)
 {
-	const char* sz = tag.szvalue();
-	int n = sscanf(sz, "%lg,%lg,%lg", &v.x, &v.y, &v.z);
+	double d[3];
+	int n = read_numbers(tag, d, 3);
 	if (n != 3) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+	v = vec3d(d[0], d[1], d[2]);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, mat3d& m)
 {
-	const char* sz = tag.szvalue();
-	double xx, xy, xz, yx, yy, yz, zx, zy, zz;
-	int n = sscanf(sz, "%lg,%lg,%lg,%lg,%lg,%lg,%lg,%lg,%lg", &xx, &xy, &xz, &yx, &yy, &yz, &zx, &zy, &zz);
+	double d[9];
+	int n = read_numbers(tag, d, 9);
 	if (n != 9) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
-	m = mat3d(xx, xy, xz, yx, yy, yz, zx, zy, zz);
+	m = mat3d(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], d[8]);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, mat3ds& m)
 {
-	const char* sz = tag.szvalue();
-	double x, y, z, xy, yz, xz;
-	int n = sscanf(sz, "%lg,%lg,%lg,%lg,%lg,%lg", &x, &y, &z, &xy, &yz, &xz);
+	double d[6];
+	int n = read_numbers(tag, d, 6);
 	if (n != 6) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
-	m = mat3ds(x, y, z, xy, yz, xz);
+	m = mat3ds(d[0], d[1], d[2], d[3], d[4], d[5]);
 }
 
 //-----------------------------------------------------------------------------
@@ -215,37 +237,13 @@ void FEFileSection::value(XMLTag& tag, std::vector<double>& v)
 //-----------------------------------------------------------------------------
 int FEFileSection::value(XMLTag& tag, int* pi, int n)
 {
-	const char* sz = tag.szvalue();
-	int nr = 0;
-	for (int i = 0; i<n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pi[i] = atoi(sz);
-nr++;
-
-if (sze) sz = sze + 1;
-else break;
-	}
-	return nr;
+	return tag.value(pi, n);
 }
 
 //-----------------------------------------------------------------------------
 int FEFileSection::value(XMLTag& tag, double* pf, int n)
 {
-	const char* sz = tag.szvalue();
-	int nr = 0;
-	for (int i = 0; i < n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pf[i] = atof(sz);
-		nr++;
-
-		if (sze) sz = sze + 1;
-		else break;
-	}
-	return nr;
+	return tag.value(pf, n);
 }
 
 //-----------------------------------------------------------------------------
@@ -30,6 +30,134 @@ SOFTWARE.*/
 #include "XMLReader.h"
 #include <assert.h>
 #include <stdarg.h>
+#include <algorithm>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//=============================================================================
+// Number conversion
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Powers of ten that are exactly representable as doubles
+static const double exact_pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//-----------------------------------------------------------------------------
+//! Numbers with at most 19 significant digits are read as an integer mantissa m
+//! and a decimal exponent e. If m < 2^53 and |e| <= 22, both m and 10^|e| are exact
+//! doubles and v = m*10^e (or m/10^-e) is correctly rounded by a single floating
+//! point operation, so the result is identical to strtod. All other numbers
+//! (as well as inf, nan, and hexadecimal numbers) are converted with strtod.
+const char* xml_parse_double(const char* sz, const char* se, double& v)
+{
+	const char* ch = sz;
+	while ((ch < se) && isspace((unsigned char)*ch)) ++ch;
+	const char* start = ch;
+
+	bool neg = false;
+	if ((ch < se) && ((*ch == '-') || (*ch == '+'))) { neg = (*ch == '-'); ++ch; }
+
+	unsigned long long m = 0;
+	int ndigits = 0;	// significant digits in m
+	int nread = 0;		// digits that were read
+	int e = 0;
+	bool bfast = true;
+	while ((ch < se) && (*ch >= '0') && (*ch <= '9'))
+	{
+		if ((m != 0) || (*ch != '0'))
+		{
+			if (ndigits < 19) { m = 10*m + (*ch - '0'); ndigits++; }
+			else bfast = false;
+		}
+		++nread; ++ch;
+	}
+	if ((ch < se) && ((*ch == 'x') || (*ch == 'X'))) bfast = false;
+	if ((ch < se) && (*ch == '.'))
+	{
+		++ch;
+		while ((ch < se) && (*ch >= '0') && (*ch <= '9'))
+		{
+			if ((m != 0) || (*ch != '0'))
+			{
+				if (ndigits < 19) { m = 10*m + (*ch - '0'); ndigits++; }
+				else bfast = false;
+			}
+			--e; ++nread; ++ch;
+		}
+	}
+	if ((ch < se) && ((*ch == 'e') || (*ch == 'E')))
+	{
+		++ch;
+		bool eneg = false;
+		if ((ch < se) && ((*ch == '-') || (*ch == '+'))) { eneg = (*ch == '-'); ++ch; }
+		if ((ch < se) && (*ch >= '0') && (*ch <= '9'))
+		{
+			int ne = 0;
+			while ((ch < se) && (*ch >= '0') && (*ch <= '9'))
+			{
+				if (ne < 10000) ne = 10*ne + (*ch - '0');
+				++ch;
+			}
+			e += (eneg ? -ne : ne);
+		}
+		else bfast = false;
+	}
+
+	if (bfast && (nread > 0) && (m <= (1ull << 53)) && (e >= -22) && (e <= 22))
+	{
+		double d = (double) m;
+		if (e < 0) d /= exact_pow10[-e]; else d *= exact_pow10[e];
+		v = (neg ? -d : d);
+		return ch;
+	}
+
+	// use the standard conversion for everything else
+	char* end = 0;
+	v = strtod(start, &end);
+	return (end == start ? sz : end);
+}
+
+//-----------------------------------------------------------------------------
+const char* xml_parse_int(const char* sz, const char* se, int& n)
+{
+	const char* ch = sz;
+	while ((ch < se) && isspace((unsigned char)*ch)) ++ch;
+	const char* start = ch;
+
+	bool neg = false;
+	if ((ch < se) && ((*ch == '-') || (*ch == '+'))) { neg = (*ch == '-'); ++ch; }
+
+	// at most 18 digits are accumulated so that m cannot overflow
+	const char* digits = ch;
+	long long m = 0;
+	while ((ch < se) && (*ch >= '0') && (*ch <= '9') && (ch - digits < 18))
+	{
+		m = 10*m + (*ch - '0');
+		++ch;
+	}
+	if (ch == digits) return sz;
+
+	// leave longer numbers to strtol
+	if ((ch < se) && (*ch >= '0') && (*ch <= '9'))
+	{
+		while ((ch < se) && (*ch >= '0') && (*ch <= '9')) ++ch;
+		std::string s(start, ch);
+		n = (int)strtol(s.c_str(), 0, 10);
+		return ch;
+	}
+
+	n = (int)(neg ? -m : m);
+	return ch;
+}
 
 //=============================================================================
 // XMLAtt
@@ -67,6 +195,9 @@ XMLTag::XMLTag()
 
 	m_natt = 0;
 	for (int i=0; i<MAX_LEVEL; ++i) m_szroot[i][0] = 0;
+
+	m_pval = 0;
+	m_nval = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -75,6 +206,8 @@ void XMLTag::clear()
 {
 	m_sztag[0] = 0;
 	m_szval.clear();
+	m_pval = 0;
+	m_nval = 0;
 	m_natt = 0;
 	m_bend = false;
 	m_bleaf = true;
@@ -87,13 +220,14 @@ void XMLTag::clear()
 //!
 int XMLTag::value(double* pf, int n)
 {
-	const char* sz = m_szval.c_str();
+	const char *sz, *se;
+	view(sz, se);
 	int nr = 0;
 	for (int i=0; i<n; ++i)
 	{
-		const char* sze = strchr(sz, ',');
+		const char* sze = (const char*) memchr(sz, ',', se - sz);
 
-		pf[i] = atof(sz);
+		xml_parse_double(sz, se, pf[i]);
 		nr++;
 
 		if (sze) sz = sze+1;
@@ -108,13 +242,16 @@ int XMLTag::value(double* pf, int n)
 //!
 int XMLTag::value(float* pf, int n)
 {
-	const char* sz = m_szval.c_str();
+	const char *sz, *se;
+	view(sz, se);
 	int nr = 0;
 	for (int i=0; i<n; ++i)
 	{
-		const char* sze = strchr(sz, ',');
+		const char* sze = (const char*) memchr(sz, ',', se - sz);
 
-		pf[i] = (float) atof(sz);
+		double d;
+		xml_parse_double(sz, se, d);
+		pf[i] = (float) d;
 		nr++;
 
 		if (sze) sz = sze+1;
@@ -129,13 +266,14 @@ int XMLTag::value(float* pf, int n)
 //!
 int XMLTag::value(int* pi, int n)
 {
-	const char* sz = m_szval.c_str();
+	const char *sz, *se;
+	view(sz, se);
 	int nr = 0;
 	for (int i=0; i<n; ++i)
 	{
-		const char* sze = strchr(sz, ',');
+		const char* sze = (const char*) memchr(sz, ',', se - sz);
 
-		pi[i] = atoi(sz);
+		xml_parse_int(sz, se, pi[i]);
 		nr++;
 
 		if (sze) sz = sze+1;
@@ -144,6 +282,32 @@ int XMLTag::value(int* pi, int n)
 	return nr;
 }
 
+//-----------------------------------------------------------------------------
+void XMLTag::value(double& val)
+{
+	const char *sz, *se;
+	view(sz, se);
+	xml_parse_double(sz, se, val);
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::value(float& val)
+{
+	const char *sz, *se;
+	view(sz, se);
+	double d;
+	xml_parse_double(sz, se, d);
+	val = (float) d;
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::value(int& val)
+{
+	const char *sz, *se;
+	view(sz, se);
+	xml_parse_int(sz, se, val);
+}
+
 //-----------------------------------------------------------------------------
 int XMLTag::value(std::vector<string>& stringList, int n)
 {
@@ -151,7 +315,7 @@ int XMLTag::value(std::vector<string>& stringList, int n)
 
 	char tmp[256] = { 0 };
 
-	const char* sz = m_szval.c_str();
+	const char* sz = szvalue();
 	int nr = 0;
 	for (int i = 0; i<n; ++i)
 	{
@@ -177,19 +341,20 @@ int XMLTag::value(std::vector<string>& stringList, int n)
 void XMLTag::value(bool& val)
 { 
 	int n=0; 
-	sscanf(m_szval.c_str(), "%d", &n); 
+	sscanf(szvalue(), "%d", &n); 
 	val = (n != 0); 
 }
 
 //-----------------------------------------------------------------------------
 void XMLTag::value(char* szstr)
 {
-	strcpy(szstr, m_szval.c_str()); 
+	strcpy(szstr, szvalue()); 
 }
 
 //-----------------------------------------------------------------------------
 void XMLTag::value(std::string& val)
 {
+	szvalue();
 	val = m_szval;
 }
 
@@ -197,7 +362,7 @@ void XMLTag::value(std::string& val)
 void XMLTag::value(vector<int>& l)
 {
 	int i, n = 0, n0, n1, nn;
-	char* szval = strdup(m_szval.c_str());
+	char* szval = strdup(szvalue());
 	char* ch;
 	char* sz = szval;
 	int nread;
@@ -263,6 +428,40 @@ void XMLTag::value(vector<int>& l)
 	free(szval);
 }
 
+//-----------------------------------------------------------------------------
+//! Return the value as a zero-terminated string. If the value is a view of the
+//! mapped file, it is copied to m_szval first (without line breaks, as when the
+//! value is read through the file stream).
+const char* XMLTag::szvalue()
+{
+	if (m_pval)
+	{
+		m_szval.clear();
+		m_szval.reserve(m_nval + 1);
+		for (size_t i = 0; i < m_nval; ++i)
+			if (m_pval[i] != '\n') m_szval.push_back(m_pval[i]);
+		m_szval.push_back(0);
+		m_pval = 0;
+		m_nval = 0;
+	}
+	return m_szval.c_str();
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::view(const char*& sz, const char*& se)
+{
+	if (m_pval)
+	{
+		sz = m_pval;
+		se = m_pval + m_nval;
+	}
+	else
+	{
+		sz = m_szval.c_str();
+		se = sz + strlen(sz);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! Return the number of children of a tag
 int XMLTag::children()
@@ -333,7 +532,7 @@ bool XMLTag::AttributeValue(const char* szat, double& d, bool bopt)
 	const char* szv = AttributeValue(szat, bopt);
 	if (szv == 0) return false;
 
-	d = atof(szv);
+	xml_parse_double(szv, szv + strlen(szv), d);
 
 	return true;
 }
@@ -344,7 +543,7 @@ bool XMLTag::AttributeValue(const char* szat, int& n, bool bopt)
 	const char* szv = AttributeValue(szat, bopt);
 	if (szv == 0) return false;
 
-	n = atoi(szv);
+	xml_parse_int(szv, szv + strlen(szv), n);
 
 	return true;
 }
@@ -413,6 +612,15 @@ XMLReader::XMLReader()
 	m_bufSize = 0;
 	m_eof = false;
 	m_currentPos = 0;
+
+	m_pd = 0;
+	m_size = 0;
+#ifdef WIN32
+	m_hfile = INVALID_HANDLE_VALUE;
+	m_hmap = 0;
+#else
+	m_fd = -1;
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -428,6 +636,7 @@ void XMLReader::Close()
 	{
 		fclose(m_fp);
 	}
+	Unmap();
 
 	m_fp = 0;
 	m_nline = 0;
@@ -438,10 +647,24 @@ void XMLReader::Close()
 }
 
 //-----------------------------------------------------------------------------
-bool XMLReader::Open(const char* szfile)
+bool XMLReader::Open(const char* szfile, bool bmap)
 {
 	// make sure this reader has not been attached to a file yet
-	if (m_fp != 0) return false;
+	if ((m_fp != 0) || (m_pd != 0)) return false;
+
+	// try to map the file
+	if (bmap && Map(szfile))
+	{
+		// make sure it is an xml file
+		if ((m_size < 5) || (strncmp(m_pd, "<?xml", 5) != 0))
+		{
+			Close();
+			return false;
+		}
+
+		m_currentPos = 0;
+		return true;
+	}
 
 	// open the file
 	m_fp = fopen(szfile, "rb");
@@ -464,6 +687,59 @@ bool XMLReader::Open(const char* szfile)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+bool XMLReader::Map(const char* szfile)
+{
+#ifdef WIN32
+	HANDLE hfile = CreateFileA(szfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hfile == INVALID_HANDLE_VALUE) return false;
+	m_hfile = hfile;
+
+	LARGE_INTEGER size;
+	if ((GetFileSizeEx(hfile, &size) == FALSE) || (size.QuadPart == 0)) { Unmap(); return false; }
+	m_size = size.QuadPart;
+
+	m_hmap = CreateFileMappingA(hfile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (m_hmap == 0) { Unmap(); return false; }
+
+	m_pd = (const char*)MapViewOfFile((HANDLE)m_hmap, FILE_MAP_READ, 0, 0, 0);
+	if (m_pd == 0) { Unmap(); return false; }
+#else
+	m_fd = open(szfile, O_RDONLY);
+	if (m_fd < 0) return false;
+
+	struct stat st;
+	if ((fstat(m_fd, &st) != 0) || (st.st_size == 0)) { Unmap(); return false; }
+	m_size = st.st_size;
+
+	void* pd = mmap(0, (size_t)m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+	if (pd == MAP_FAILED) { Unmap(); return false; }
+	m_pd = (const char*)pd;
+
+	// the file is read sequentially
+	madvise(pd, (size_t)m_size, MADV_SEQUENTIAL);
+#endif
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void XMLReader::Unmap()
+{
+#ifdef WIN32
+	if (m_pd) UnmapViewOfFile(m_pd);
+	if (m_hmap) CloseHandle((HANDLE)m_hmap);
+	if (m_hfile != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)m_hfile);
+	m_hmap = 0;
+	m_hfile = INVALID_HANDLE_VALUE;
+#else
+	if (m_pd) munmap((void*)m_pd, (size_t)m_size);
+	if (m_fd >= 0) close(m_fd);
+	m_fd = -1;
+#endif
+	m_pd = 0;
+	m_size = 0;
+}
+
 //-----------------------------------------------------------------------------
 
 class XMLPath
@@ -578,7 +854,7 @@ private:
 bool XMLReader::FindTag(const char* xpath, XMLTag& tag)
 {
 	// go to the beginning of the file
-	fseek(m_fp, 0, SEEK_SET);
+	if (m_fp) fseek(m_fp, 0, SEEK_SET);
 	m_bufIndex = m_bufSize = 0;
 	m_currentPos = 0;
 
@@ -632,7 +908,7 @@ void XMLReader::NextTag(XMLTag& tag)
 	// set the current file position
 	if (m_currentPos != tag.m_fpos)
 	{
-		fseek(m_fp, tag.m_fpos, SEEK_SET);
+		if (m_fp) fseek(m_fp, tag.m_fpos, SEEK_SET);
 		m_currentPos = tag.m_fpos;
 		m_bufSize = m_bufIndex = 0;
 		m_eof = false;
@@ -795,6 +1071,23 @@ void XMLReader::ReadValue(XMLTag& tag)
 	char ch;
 	if (!tag.isend())
 	{
+		// When the file is mapped, the value is referenced directly in the file,
+		// unless it contains entity references that need to be replaced.
+		if (m_pd)
+		{
+			const char* sz = m_pd + m_currentPos;
+			const char* se = (const char*) memchr(sz, '<', (size_t)(m_size - m_currentPos));
+			if (se == 0) { m_currentPos = m_size; throw EndOfFile(); }
+			if (memchr(sz, '&', se - sz) == 0)
+			{
+				m_nline += (int) std::count(sz, se, '\n');
+				tag.m_pval = sz;
+				tag.m_nval = se - sz;
+				m_currentPos += (se - sz) + 1;
+				return;
+			}
+		}
+
 		tag.m_szval.clear();
 		tag.m_szval.reserve(256);
 		while ((ch=GetChar())!='<') 
@@ -867,6 +1160,12 @@ void XMLReader::ReadEndTag(XMLTag& tag)
 //-----------------------------------------------------------------------------
 char XMLReader::readNextChar()
 {
+	if (m_pd)
+	{
+		if (m_currentPos >= m_size) throw EndOfFile();
+		return m_pd[m_currentPos++];
+	}
+
 	if (m_bufIndex >= m_bufSize)
 	{
 		if (m_eof) throw EndOfFile();
@@ -889,6 +1188,12 @@ int64_t XMLReader::currentPos()
 //! move the file pointer
 void XMLReader::rewind(int64_t nstep)
 {
+	if (m_pd)
+	{
+		m_currentPos -= nstep;
+		return;
+	}
+
 	m_bufIndex -= nstep;
 	m_currentPos -= nstep;
 
@@ -902,7 +1207,7 @@ void XMLReader::rewind(int64_t nstep)
 
 //-----------------------------------------------------------------------------
 //! Read the next character in the file.
-char XMLReader::GetChar()
+char XMLReader::ReadChar()
 {
 	char ch;
 	while ((ch=readNextChar())=='\n') ++m_nline;
@@ -37,6 +37,17 @@ SOFTWARE.*/
 #include "febioxml_api.h"
 using namespace std;
 
+//-------------------------------------------------------------------------
+//! Convert the number at the beginning of the character range [sz, se) (after
+//! skipping whitespace). The result is the same as that of strtod and atoi
+//! respectively, but numbers are converted directly from the range without
+//! copying. The range must be followed by a character that cannot be part of a
+//! number (e.g. a delimiter or the terminating zero).
+//! Returns a pointer past the last character that was converted, or sz if no
+//! number was found (in which case the value is set to zero).
+FEBIOXML_API const char* xml_parse_double(const char* sz, const char* se, double& v);
+FEBIOXML_API const char* xml_parse_int(const char* sz, const char* se, int& n);
+
 //-------------------------------------------------------------------------
 // forward declaration
 class XMLReader;
@@ -83,6 +94,8 @@ public:
 public:
 	char		m_sztag[MAX_TAG];		// tag name
 	std::string m_szval;				// tag value
+	const char*	m_pval;					// tag value in the mapped file (zero if the value is stored in m_szval)
+	size_t		m_nval;					// length of m_pval
 
 	XMLAtt	m_att[MAX_ATT];				// attribute list
 	int		m_natt;						// nr of attributes
@@ -124,11 +137,11 @@ public:
 		
 	const char* Name() { return m_sztag; }
 
-	void value(double& val) { val = atof(m_szval.c_str()); } 
-	void value(float& val)  { val = (float) atof(m_szval.c_str()); }
-	void value(int& val) { val = atoi(m_szval.c_str()); }
-	void value(long& val) { val = (long) atoi(m_szval.c_str()); }
-	void value(short& val) { val = (short) atoi(m_szval.c_str()); }
+	void value(double& val);
+	void value(float& val);
+	void value(int& val);
+	void value(long& val) { int n; value(n); val = (long) n; }
+	void value(short& val) { int n; value(n); val = (short) n; }
 	int value(double* pf, int n);
 	int value(float* pf, int n);
 	int value(int* pi, int n);
@@ -138,7 +151,12 @@ public:
 	void value(std::string& val);
 	void value(vector<int>& l);
 
-	const char* szvalue() { return m_szval.c_str(); }
+	const char* szvalue();
+
+	//! Get the value as the character range [sz, se). When the file is memory-mapped
+	//! the range points directly into the file, so it remains valid until the reader is closed.
+	//! Note that, unlike szvalue, the range can contain line breaks.
+	void view(const char*& sz, const char*& se);
 };
 
 //-----------------------------------------------------------------------------
@@ -226,8 +244,13 @@ public:
 	XMLReader();
 	virtual ~XMLReader();
 
-	//! Open the xml file
-	bool Open(const char* szfile);
+	//! Open the xml file. By default the file is memory-mapped, so that tag values
+	//! can be accessed without copying them (see XMLTag::view). If the file cannot
+	//! be mapped, or bmap is false, the file is read through a buffered file stream.
+	bool Open(const char* szfile, bool bmap = true);
+
+	//! returns true if the file is memory-mapped
+	bool IsMapped() const { return (m_pd != 0); }
 
 	//! Close the xml file
 	void Close();
@@ -249,6 +272,9 @@ protected: // helper functions
 	//! Get the next character in the file
 	char GetChar();
 
+	//! Get the next character, processing line breaks and entity references
+	char ReadChar();
+
 	//! Read a tag
 	void ReadTag(XMLTag& tag);
 
@@ -267,6 +293,12 @@ protected: // helper functions
 	//! move the file pointer
     void rewind(int64_t nstep);
 
+	//! memory-map the file
+	bool Map(const char* szfile);
+
+	//! release the mapped file
+	void Unmap();
+
 protected:
 	FILE*	m_fp;			//!< the file pointer
 	int		m_nline;		//!< current line (used only as temp storage)
@@ -275,8 +307,30 @@ protected:
 	char	m_buf[BUF_SIZE];
     int64_t    m_bufIndex, m_bufSize;
 	bool	m_eof;
+
+	const char*	m_pd;		//!< the mapped file (zero if the file is read through m_fp)
+	int64_t		m_size;		//!< size of the mapped file
+#ifdef WIN32
+	void*	m_hfile;	//!< file handle
+	void*	m_hmap;		//!< file mapping handle
+#else
+	int		m_fd;		//!< file descriptor
+#endif
 };
 
 //-----------------------------------------------------------------------------
 // some inline functions
 inline void XMLTag::operator ++ () { m_preader->NextTag(*this); }
+
+//-----------------------------------------------------------------------------
+//! Read the next character in the file. Most characters can be read directly
+//! from the mapped file; all others are processed by ReadChar.
+inline char XMLReader::GetChar()
+{
+	if (m_pd && (m_currentPos < m_size))
+	{
+		char ch = m_pd[m_currentPos];
+		if ((ch != '\n') && (ch != '&')) { m_currentPos++; return ch; }
+	}
+	return ReadChar();
+}
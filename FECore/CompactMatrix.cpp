@@ -92,6 +92,51 @@ void CompactMatrix::alloc(int nr, int nc, int nz, double* pv, int* pi, int* pp,
 	int nn = (isRowBased() ? nr : nc) + 1;
 }
 
+//-----------------------------------------------------------------------------
+// FNV-1a hash of an integer array
+static unsigned long long hash_ints(const int* a, int n, unsigned long long h)
+{
+	const unsigned long long prime = 1099511628211ULL;
+	for (int i = 0; i < n; ++i)
+	{
+		unsigned int v = (unsigned int)a[i];
+		h = (h ^ (v & 0xFFFF)) * prime;
+		h = (h ^ (v >> 16)) * prime;
+	}
+	return h;
+}
+
+//-----------------------------------------------------------------------------
+//! calculate a hash of the sparsity pattern
+unsigned long long CompactMatrix::PatternHash() const
+{
+	const unsigned long long basis = 14695981039346656037ULL;
+	if ((m_ppointers == nullptr) || (m_pindices == nullptr)) return 0;
+
+	int head[4] = { m_nrow, m_ncol, m_nsize, m_offset };
+	int np = (const_cast<CompactMatrix*>(this)->isRowBased() ? m_nrow : m_ncol) + 1;
+	unsigned long long h = hash_ints(head, 4, basis);
+	h = hash_ints(m_ppointers, np, h);
+
+	// The indices are hashed in a fixed number of chunks (in parallel), 
+	// so that the result does not depend on the number of threads.
+	const int nchunks = 64;
+	unsigned long long hc[nchunks];
+	int nnz = m_nsize;
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nchunks; ++i)
+	{
+		int n0 = (int)(((long long)nnz*i) / nchunks);
+		int n1 = (int)(((long long)nnz*(i + 1)) / nchunks);
+		hc[i] = hash_ints(m_pindices + n0, n1 - n0, basis);
+	}
+	for (int i = 0; i < nchunks; ++i)
+	{
+		h = (h ^ hc[i]) * 1099511628211ULL;
+	}
+	return h;
+}
+
 //-----------------------------------------------------------------------------
 //! calculate bandwidth of matrix
 int CompactMatrix::bandWidth()
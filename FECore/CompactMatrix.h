@@ -83,6 +83,10 @@ public:
 	//! calculate bandwidth of matrix
 	int bandWidth();
 
+	//! calculate a hash of the sparsity pattern (i.e. of the size, pointers and indices)
+	//! This can be used by solvers to detect that the structure did not change.
+	unsigned long long PatternHash() const;
+
 protected:
 	double*	m_pd;			//!< matrix values
 	int*	m_pindices;		//!< indices
@@ -0,0 +1,225 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "DataEncoding.h"
+#include <string.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// convert a float to a half precision float (rounds to nearest even)
+static unsigned short float_to_half(float f)
+{
+	unsigned int x;
+	memcpy(&x, &f, sizeof(x));
+	unsigned int sign = (x >> 16) & 0x8000;
+	int e = (int)((x >> 23) & 0xFF);
+	unsigned int m = x & 0x7FFFFF;
+
+	// infinity and NaN
+	if (e == 0xFF) return (unsigned short)(sign | 0x7C00 | (m ? 0x200 : 0));
+
+	// overflow
+	e = e - 127 + 15;
+	if (e >= 31) return (unsigned short)(sign | 0x7C00);
+
+	unsigned int h, rem, half;
+	if (e <= 0)
+	{
+		// subnormal (or zero)
+		if (e < -10) return (unsigned short)sign;
+		m |= 0x800000;
+		int shift = 14 - e;
+		h = m >> shift;
+		rem = m & ((1u << shift) - 1);
+		half = 1u << (shift - 1);
+	}
+	else
+	{
+		h = ((unsigned int)e << 10) | (m >> 13);
+		rem = m & 0x1FFF;
+		half = 0x1000;
+	}
+
+	// round (a carry into the exponent gives the correct result)
+	if ((rem > half) || ((rem == half) && (h & 1))) h++;
+	return (unsigned short)(sign | h);
+}
+
+//-----------------------------------------------------------------------------
+// convert a half precision float to a float
+static float half_to_float(unsigned short h)
+{
+	unsigned int sign = ((unsigned int)h & 0x8000) << 16;
+	int e = (h >> 10) & 0x1F;
+	unsigned int m = h & 0x3FF;
+	unsigned int x;
+	if (e == 0)
+	{
+		if (m == 0) x = sign;
+		else
+		{
+			// subnormal, so normalize it
+			e = 1;
+			while ((m & 0x400) == 0) { m <<= 1; e--; }
+			m &= 0x3FF;
+			x = sign | ((unsigned int)(e + 112) << 23) | (m << 13);
+		}
+	}
+	else if (e == 31) x = sign | 0x7F800000 | (m << 13);
+	else x = sign | ((unsigned int)(e + 112) << 23) | (m << 13);
+
+	float f;
+	memcpy(&f, &x, sizeof(f));
+	return f;
+}
+
+//=============================================================================
+// DataEncoding
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+size_t DataEncoding::Size(int nenc, size_t n)
+{
+	switch (nenc)
+	{
+	case FP16: return n*sizeof(unsigned short);
+	case Q16 : return 2*sizeof(float) + n*sizeof(unsigned short);
+	case Q8  : return 2*sizeof(float) + n*sizeof(unsigned char);
+	}
+	return n*sizeof(float);
+}
+
+//-----------------------------------------------------------------------------
+void DataEncoding::Encode(int nenc, const float* pd, size_t n, unsigned char* pout)
+{
+	switch (nenc)
+	{
+	case FP16:
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				unsigned short h = float_to_half(pd[i]);
+				memcpy(pout + i*sizeof(h), &h, sizeof(h));
+			}
+		}
+		break;
+	case Q16:
+	case Q8:
+		{
+			// find the range of the (finite) data
+			float fmin = 0.f, fmax = 0.f;
+			bool bfirst = true;
+			for (size_t i = 0; i < n; ++i)
+			{
+				float f = pd[i];
+				if (isfinite(f) == false) continue;
+				if (bfirst) { fmin = fmax = f; bfirst = false; }
+				else if (f < fmin) fmin = f;
+				else if (f > fmax) fmax = f;
+			}
+
+			double qmax = (nenc == Q16 ? 65535.0 : 255.0);
+			double range = (double)fmax - (double)fmin;
+			float hdr[2] = { fmin, (float)(range / qmax) };
+			memcpy(pout, hdr, sizeof(hdr));
+			pout += sizeof(hdr);
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				double f = pd[i];
+				double q = 0.0;
+				if ((range > 0.0) && isfinite(f))
+				{
+					q = floor((f - fmin) / range * qmax + 0.5);
+					if (q < 0.0) q = 0.0; else if (q > qmax) q = qmax;
+				}
+
+				if (nenc == Q16)
+				{
+					unsigned short qi = (unsigned short)q;
+					memcpy(pout + i*sizeof(qi), &qi, sizeof(qi));
+				}
+				else pout[i] = (unsigned char)q;
+			}
+		}
+		break;
+	default:
+		memcpy(pout, pd, n*sizeof(float));
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool DataEncoding::Decode(int nenc, const unsigned char* pd, size_t nsize, std::vector<float>& out)
+{
+	switch (nenc)
+	{
+	case FP32:
+		{
+			if (nsize % sizeof(float)) return false;
+			out.resize(nsize / sizeof(float));
+			if (nsize > 0) memcpy(&out[0], pd, nsize);
+		}
+		break;
+	case FP16:
+		{
+			if (nsize % sizeof(unsigned short)) return false;
+			out.resize(nsize / sizeof(unsigned short));
+			for (size_t i = 0; i < out.size(); ++i)
+			{
+				unsigned short h;
+				memcpy(&h, pd + i*sizeof(h), sizeof(h));
+				out[i] = half_to_float(h);
+			}
+		}
+		break;
+	case Q16:
+	case Q8:
+		{
+			float hdr[2];
+			if (nsize < sizeof(hdr)) return false;
+			memcpy(hdr, pd, sizeof(hdr));
+			pd += sizeof(hdr);
+			nsize -= sizeof(hdr);
+
+			size_t nq = (nenc == Q16 ? sizeof(unsigned short) : sizeof(unsigned char));
+			if (nsize % nq) return false;
+			out.resize(nsize / nq);
+			for (size_t i = 0; i < out.size(); ++i)
+			{
+				unsigned int q;
+				if (nenc == Q16) { unsigned short qi; memcpy(&qi, pd + i*nq, nq); q = qi; }
+				else q = pd[i];
+				out[i] = (float)((double)hdr[0] + (double)hdr[1] * (double)q);
+			}
+		}
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
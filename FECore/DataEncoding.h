@@ -0,0 +1,60 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <stddef.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Encodings for storing float data with reduced precision.
+//!
+//!   FP32    : 32-bit floats (no loss of precision)
+//!   FP16    : IEEE 754 half precision floats. The relative error is at most 2^-11 (about 0.05%)
+//!             for magnitudes between 6.1e-5 and 65504. Larger values are stored as infinity. 
+//!             Smaller values are stored with an absolute error of at most 3e-8 (values below 3e-8 become zero).
+//!   Q16, Q8 : fixed-point. The values are stored as 16-bit (or 8-bit) integers, preceded by 
+//!             an offset and scale (two floats) that map the integers to the range of the data.
+//!             Apart from round-off, the absolute error is at most (max - min)/131070 (or (max - min)/510), 
+//!             where min and max are the smallest and largest value of the data in the chunk (i.e. for one 
+//!             state and region).
+//!             Non-finite values are stored as the minimum.
+class FECORE_API DataEncoding
+{
+public:
+	enum { FP32, FP16, Q16, Q8 };
+
+	//! size (in bytes) of n encoded values
+	static size_t Size(int nenc, size_t n);
+
+	//! encode n values (pout must be Size(nenc, n) bytes)
+	static void Encode(int nenc, const float* pd, size_t n, unsigned char* pout);
+
+	//! decode the data of size nsize (in bytes)
+	static bool Decode(int nenc, const unsigned char* pd, size_t nsize, std::vector<float>& out);
+};
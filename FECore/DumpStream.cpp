@@ -34,6 +34,7 @@ DumpStream::DumpStream(FEModel& fem) : m_fem(fem)
 {
 	m_bsave = false;
 	m_bshallow = false;
+	m_bstate = false;
 	m_bytes_serialized = 0;
 	m_ptr_lock = false;
 }
@@ -50,6 +51,14 @@ bool DumpStream::IsLoading() const { return !m_bsave; }
 //! See if shallow flag is set
 bool DumpStream::IsShallow() const { return m_bshallow; }
 
+//-----------------------------------------------------------------------------
+//! See if only the solution state is serialized
+bool DumpStream::IsStateOnly() const { return m_bstate; }
+
+//-----------------------------------------------------------------------------
+//! Derived classes call this to turn the stream into a state-only stream.
+void DumpStream::SetStateOnly(bool b) { m_bstate = b; }
+
 //-----------------------------------------------------------------------------
 DumpStream::~DumpStream()
 {
@@ -74,6 +83,10 @@ void DumpStream::Open(bool bsave, bool bshallow)
 //-----------------------------------------------------------------------------
 void DumpStream::check()
 {
+	// The layout of a state-only stream is fixed between saving and loading,
+	// so we don't spend the extra bytes on consistency checks.
+	if (m_bstate) return;
+
 	if (IsSaving())
 	{
 		write(&m_bytes_serialized, sizeof(m_bytes_serialized), 1);
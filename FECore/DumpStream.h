@@ -74,6 +74,11 @@ public:
 	//! See if shallow flag is set
 	bool IsShallow() const;
 
+	//! See if only the mutable solution state needs to be serialized.
+	//! A state-only stream is always shallow, so components that do not check
+	//! this flag will still serialize correctly.
+	bool IsStateOnly() const;
+
 	// open the stream
 	virtual void Open(bool bsave, bool bshallow);
 
@@ -94,6 +99,9 @@ public:
 	void LockPointerTable();
 	void UnlockPointerTable();
 
+protected:
+	void SetStateOnly(bool b);
+
 public:
 	// input-output operators (will call correct operator depending on input or output mode)
 	template <typename T> DumpStream& operator & (T& o);
@@ -140,6 +148,7 @@ private:
 private:
 	bool		m_bsave;	//!< true if output stream, false for input stream
 	bool		m_bshallow;	//!< if true only shallow data needs to be serialized
+	bool		m_bstate;	//!< if true only the solution state needs to be serialized
 	FEModel&	m_fem;		//!< the FE Model that is being serialized
 
 	size_t	m_bytes_serialized;	//!< number or bytes serialized
@@ -168,7 +177,10 @@ template <typename T> inline DumpStream& DumpStream::operator & (T& o)
 
 template <typename T> inline DumpStream& DumpStream::operator << (T& o)
 {
-	AddPointer((void*)&o);
+	// State-only streams don't track objects that are stored by value (e.g. nodes
+	// and material points), since there can be millions of them. Pointers are
+	// still tracked, which is needed to break cycles in the object graph.
+	if (m_bstate == false) AddPointer((void*)&o);
 	o.Serialize(*this);
 	check();
 	return *this;
@@ -191,7 +203,7 @@ template <> inline DumpStream& DumpStream::operator << (matrix&   o) { return wr
 
 template <typename T> inline DumpStream& DumpStream::operator >> (T& o)
 {
-	AddPointer((void*)&o);
+	if (m_bstate == false) AddPointer((void*)&o);
 	o.Serialize(*this);
 	check();
 	return *this;
@@ -41,6 +41,7 @@ FEClosestPointProjection::FEClosestPointProjection(FESurface& s) : m_surf(s)
 	m_bspecial = false;
 	m_projectBoundary = false;
 	m_handleQuads = false;
+	m_bvh = nullptr;
 
 	// calculate node-element list
 	m_NEL.Create(m_surf);
@@ -51,9 +52,11 @@ FEClosestPointProjection::FEClosestPointProjection(FESurface& s) : m_surf(s)
 //! Initialization of data structures
 bool FEClosestPointProjection::Init()
 {
-	// initialize the nearest neighbor search
-	m_SNQ.Attach(&m_surf);
-	m_SNQ.Init();
+	// initialize the nearest neighbor search.
+	// The BVH is owned by the surface, so it only needs to be refitted
+	// if it was already built by a previous projection.
+	m_bvh = m_surf.GetBVH();
+	m_bvh->Update();
 
 	return true;
 }
@@ -84,7 +87,8 @@ FESurfaceElement* FEClosestPointProjection::Project(vec3d& x, vec3d& q, vec2d& r
 	FEMesh& mesh = *m_surf.GetMesh();
 
 	// let's find the closest node
-	int mn = m_SNQ.Find(x);
+	int mn = m_bvh->FindClosestNode(x);
+	if (mn < 0) return 0;
 
 	// mn is a local index, so get the global node number too
 	int m = m_surf.NodeIndex(mn);
@@ -300,30 +304,10 @@ FESurfaceElement* FEClosestPointProjection::Project(int n, vec3d& q, vec2d& r)
 	// get the node's position
 	vec3d x = mesh.Node(n).m_rt;
 	
-	// see if we need to initialize the NQ structure
-//	if (binit_nq) m_SNQ.Init();
-	
-	// let's find the closest node
-//	int mn = m_SNQ.Find(x);
+	// let's find the closest node (that is not the node itself)
+	int mn = m_bvh->FindClosestNode(x, n, m_rad);
+	if (mn < 0) return 0;
 
-	// do it the hard way
-	int mn = -1;
-	double d0;
-	int N = m_surf.Nodes();
-	for (int i=0; i<N; ++i)
-	{
-		if (m_surf.NodeIndex(i) != n)
-		{
-			vec3d r = m_surf.Node(i).m_rt;
-			double d = (r - x)*(r - x);
-			if ((mn == -1) || (d < d0))
-			{
-				d0 = d;
-				mn = i;
-			}
-		}
-	}
-	
 	// mn is a local index, so get the global node number too
 	int m = m_surf.NodeIndex(mn);
 	
@@ -28,7 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FESurface.h"
-#include "FENNQuery.h"
+#include "FESurfaceBVH.h"
 #include "FEElemElemList.h"
 #include "FENodeElemList.h"
 
@@ -41,10 +41,13 @@ public:
 	//! constructor
 	FEClosestPointProjection(FESurface& s);
 
-	//! Initialization
+	//! Initialization. This updates the surface's bounding volume hierarchy
+	//! to the current configuration, so it must be called after the nodes moved.
 	bool Init();
 
-	//! Project a point onto surface
+	//! Project a point onto surface.
+	//! The projection functions do not modify any data, so after Init() was called
+	//! they can be called from multiple threads at once.
 	FESurfaceElement* Project(vec3d& x, vec3d& q, vec2d& r);
 
 	//! Project a node onto a surface
@@ -78,7 +81,7 @@ protected:
 
 protected:
 	FESurface&		m_surf;		//!< reference to surface
-	FENNQuery		m_SNQ;		//!< used to find the nearest neighbour
+	FESurfaceBVH*	m_bvh;		//!< used to find the nearest neighbour
 	FENodeElemList	m_NEL;		//!< node-element tree
 	FEElemElemList	m_EEL;		//!< element neighbor list
 };
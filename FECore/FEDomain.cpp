@@ -29,11 +29,13 @@ SOFTWARE.*/
 #include "DumpStream.h"
 #include "FEMesh.h"
 #include "FEGlobalMatrix.h"
+#include "FELinearSystem.h"
+#include "FENodeElemList.h"
 
 //-----------------------------------------------------------------------------
 FEDomain::FEDomain(int nclass, FEModel* fem) : FEMeshPartition(nclass, fem)
 {
-
+	m_scatterStamp = -1;
 }
 
 //-----------------------------------------------------------------------------
@@ -43,6 +45,40 @@ void FEDomain::SetMaterial(FEMaterial* pm)
 	if (pm) pm->AddDomain(this);
 }
 
+//-----------------------------------------------------------------------------
+bool FEDomain::Init()
+{
+	// The element colors and scatter maps depend on the connectivity, which
+	// may have changed (e.g. after remeshing), so they are rebuilt when needed.
+	m_colors.clear();
+	m_scatter.clear();
+	m_scatterStamp = -1;
+
+	// build the type lookup tables of the material points
+	BuildMaterialPointSlots();
+
+	return FEMeshPartition::Init();
+}
+
+//-----------------------------------------------------------------------------
+// Build the slot tables of all material points, so that the material point data
+// can be found without dynamic_casts. 
+void FEDomain::BuildMaterialPointSlots()
+{
+	int NE = Elements();
+	#pragma omp parallel for
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int nint = el.GaussPoints();
+		for (int n = 0; n < nint; ++n)
+		{
+			FEMaterialPoint* mp = el.GetMaterialPoint(n);
+			if (mp) mp->BuildSlotTable();
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FEDomain::SetMatID(int mid)
 {
@@ -127,6 +163,8 @@ void FEDomain::Serialize(DumpStream& ar)
 					el.GetMaterialPoint(j)->Serialize(ar);
 				}
 			}
+
+			BuildMaterialPointSlots();
 		}
 	}
 }
@@ -194,3 +232,91 @@ void FEDomain::Activate(const FEDofList& dof)
 		}
 	}
 }
+
+//-----------------------------------------------------------------------------
+// Greedy coloring of the elements. Two elements that share a node will be assigned
+// a different color, so that all elements of one color can be assembled concurrently.
+const std::vector< std::vector<int> >& FEDomain::ElementColors()
+{
+	const int NE = Elements();
+	if (m_colors.empty() && (NE > 0))
+	{
+		FENodeElemList NEL;
+		NEL.Create(*this);
+
+		// color of each element (-1 = not colored yet)
+		vector<int> color(NE, -1);
+
+		// tag[c] == i if color c is used by a neighbor of element i
+		vector<int> tag;
+		int ncolors = 0;
+		for (int i = 0; i < NE; ++i)
+		{
+			FEElement& el = ElementRef(i);
+			for (int j = 0; j < el.Nodes(); ++j)
+			{
+				int n = el.m_node[j];
+				int nval = NEL.Valence(n);
+				int* eli = NEL.ElementIndexList(n);
+				for (int k = 0; k < nval; ++k)
+				{
+					int ck = color[eli[k]];
+					if (ck >= 0) tag[ck] = i;
+				}
+			}
+
+			// find the first color that is not used by any of the neighbors
+			int c = 0;
+			while ((c < ncolors) && (tag[c] == i)) ++c;
+			if (c == ncolors) { tag.push_back(-1); ncolors++; }
+			color[i] = c;
+		}
+
+		// group the elements by color
+		m_colors.resize(ncolors);
+		for (int i = 0; i < NE; ++i) m_colors[color[i]].push_back(i);
+	}
+	return m_colors;
+}
+
+//-----------------------------------------------------------------------------
+void FEDomain::AssembleElements(FELinearSystem& LS, std::function<void(int iel)> f)
+{
+	// The scatter maps are only valid for the matrix profile they were built for,
+	// so they are cleared when the profile changes and rebuilt during the assembly.
+	if (LS.CacheScatterMaps())
+	{
+		int stamp = LS.ProfileStamp();
+		if ((stamp != m_scatterStamp) || ((int)m_scatter.size() != Elements()))
+		{
+			m_scatter.assign(Elements(), std::vector<int>());
+			m_scatterStamp = stamp;
+		}
+	}
+	else if (m_scatter.empty() == false)
+	{
+		m_scatter.clear();
+		m_scatterStamp = -1;
+	}
+
+	if (LS.ColoredAssembly())
+	{
+		const std::vector< std::vector<int> >& colors = ElementColors();
+
+		LS.SetAtomicAssembly(false);
+		for (size_t c = 0; c < colors.size(); ++c)
+		{
+			const std::vector<int>& eli = colors[c];
+			int NE = (int)eli.size();
+			#pragma omp parallel for shared(NE)
+			for (int i = 0; i < NE; ++i) f(eli[i]);
+		}
+		LS.SetAtomicAssembly(true);
+	}
+	else
+	{
+		int NE = Elements();
+		#pragma omp parallel for shared(NE)
+		for (int i = 0; i < NE; ++i) f(i);
+	}
+}
@@ -31,6 +31,7 @@ SOFTWARE.*/
 
 // forward declaration of material class
 class FEMaterial;
+class FELinearSystem;
 
 // Base class for solid and shell parts. Domains can also have materials assigned.
 class FECORE_API FEDomain : public FEMeshPartition
@@ -47,6 +48,12 @@ public:
 	//! set the material ID of all elements
 	void SetMatID(int mid);
 
+	//! initialize domain
+	bool Init() override;
+
+	//! build the type lookup tables of the material points
+	void BuildMaterialPointSlots();
+
 	//! Allocate material point data for the elements
 	//! This is called after elements get read in from the input file.
 	//! And must be called before material point data can be accessed.
@@ -74,10 +81,32 @@ public:
 	//! Activate the domain
 	virtual void Activate();
 
+	//! This is called when the reference nodal coordinates were changed after the domain was initialized
+	virtual void ReferenceGeometryChanged() {}
+
+public:
+	//! Get the element colors. Elements of the same color do not share any nodes.
+	//! The coloring is created the first time this function is called.
+	const std::vector< std::vector<int> >& ElementColors();
+
+	//! Loop over all elements in parallel and call f with the element index.
+	//! If the linear system requests colored assembly, the elements are processed
+	//! one color at a time and the global matrix is updated without atomics.
+	void AssembleElements(FELinearSystem& LS, std::function<void(int iel)> f);
+
+	//! Get the scatter map cache of element iel, or null if scatter maps are not cached.
+	//! This is only valid inside AssembleElements.
+	std::vector<int>* ElementScatterMap(int iel) { return (m_scatter.empty() ? nullptr : &m_scatter[iel]); }
+
 protected:
 	// helper function for activating dof lists
 	void Activate(const FEDofList& dof);
 
 	// helper function for unpacking element dofs
 	void UnpackLM(FEElement& el, const FEDofList& dof, vector<int>& lm);
+
+private:
+	std::vector< std::vector<int> >	m_colors;	//!< element indices, grouped by color
+	std::vector< std::vector<int> >	m_scatter;	//!< cached scatter maps of elements
+	int	m_scatterStamp;		//!< profile stamp of the cached scatter maps
 };
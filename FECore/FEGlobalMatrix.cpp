@@ -36,6 +36,7 @@ SOFTWARE.*/
 FEElementMatrix::FEElementMatrix(const FEElement& el)
 {
 	m_node = el.m_node;
+	m_map = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -44,6 +45,7 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke) : matrix(ke)
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_map = ke.m_map;
 }
 
 //-----------------------------------------------------------------------------
@@ -52,6 +54,7 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke, double scale)
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_map = ke.m_map;
 	matrix& T = *this;
 	const matrix& K = ke;
 	T = (scale == 1.0 ? K : K*scale);
@@ -63,6 +66,7 @@ FEElementMatrix::FEElementMatrix(const FEElement& el, const vector<int>& lmi) :
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmi;
+	m_map = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -71,6 +75,7 @@ FEElementMatrix::FEElementMatrix(const FEElement& el, vector<int>& lmi, vector<i
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmj;
+	m_map = nullptr;
 };
 
 //-----------------------------------------------------------------------------
@@ -90,6 +95,9 @@ FEGlobalMatrix::FEGlobalMatrix(SparseMatrix* pK, bool del)
 	m_pMP = 0;
 	m_nlm = 0;
 	m_delA = del;
+	m_nstamp = 0;
+	m_brecord = false;
+	m_bcollect = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -133,6 +141,10 @@ void FEGlobalMatrix::build_add(vector<int>& lm)
 {
 	if (lm.empty() == false)
 	{
+		// keep track of the dynamic elements
+		if (m_brecord) m_LMd.push_back(lm);
+		if (m_bcollect) return;
+
 		m_LM[m_nlm++] = lm;
 		if (m_nlm >= MAX_LM_SIZE) build_flush();
 	}
@@ -169,6 +181,10 @@ void FEGlobalMatrix::build_end()
 {
 	if (m_nlm > 0) build_flush();
 	m_pA->Create(*m_pMP);
+
+	// assign a new stamp so that cached scatter maps get rebuilt
+	static int nstamp = 0;
+	m_nstamp = ++nstamp;
 }
 
 //-----------------------------------------------------------------------------
@@ -211,7 +227,12 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 		}
 
 		// Add the "dynamic" profile
+		// We keep a copy of the dynamic elements so that
+		// we can see later if the profile needs to change.
+		m_LMd.clear();
+		m_brecord = true;
 		pfem->BuildMatrixProfile(*this, false);
+		m_brecord = false;
 	}
 	// All done! We can now finish building the profile and create 
 	// the actual sparse matrix. This is done in the following function
@@ -220,6 +241,52 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! When only the "dynamic" elements (e.g. contact) can change, this function checks if the
+//! current sparse matrix can be kept. The dynamic elements are collected and compared to the 
+//! ones that were used to build the current profile. If they are the same, or if they still fit in
+//! the current profile, the sparse matrix does not need to be rebuilt and this function returns true.
+//! Otherwise, it returns false and the matrix must be rebuilt by calling Create.
+bool FEGlobalMatrix::UpdateDynamicProfile(FEModel* pfem, int neq)
+{
+	// make sure we have a profile to compare to
+	if ((m_pMP == nullptr) || (m_pMP->Rows() != neq) || (m_pA->Rows() != neq)) return false;
+
+	// collect the new dynamic elements
+	vector< vector<int> > LMd;
+	LMd.swap(m_LMd);
+	m_brecord = m_bcollect = true;
+	pfem->BuildMatrixProfile(*this, false);
+	m_brecord = m_bcollect = false;
+
+	// if nothing changed, we can keep the matrix
+	if (m_LMd == LMd) return true;
+
+	// see if all the new elements fit in the current profile
+	const SparseMatrixProfile& MP = *m_pMP;
+	vector<int> lm;
+	for (size_t i = 0; i < m_LMd.size(); ++i)
+	{
+		// prescribed dofs also get storage (see build_flush)
+		lm = m_LMd[i];
+		for (size_t j = 0; j < lm.size(); ++j) if (lm[j] < -1) lm[j] = -lm[j] - 2;
+
+		int n = (int)lm.size();
+		for (int j = 0; j < n; ++j)
+		{
+			if (lm[j] < 0) continue;
+			for (int k = 0; k < n; ++k)
+			{
+				if ((lm[k] >= 0) && (MP.HasEntry(lm[k], lm[j]) == false)) return false;
+			}
+		}
+	}
+
+	// The new elements fit, so we keep the matrix.
+	// Note that the profile may now contain some entries that will remain zero.
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Constructs the stiffness matrix from a FEMesh object. 
 bool FEGlobalMatrix::Create(FEMesh& mesh, int neq)
@@ -316,5 +383,19 @@ bool FEGlobalMatrix::Create(const FESurface& surf, const std::vector<int>& equat
 
 void FEGlobalMatrix::Assemble(const FEElementMatrix& ke)
 {
+	// see if we can use a cached scatter map
+	std::vector<int>* map = ke.ScatterMap();
+	if (map)
+	{
+		// the first time this element is assembled, we need to build the map
+		if (map->empty()) m_pA->ScatterMap(ke.RowIndices(), ke.ColumnsIndices(), ke.rows(), ke.columns(), *map);
+
+		if (map->empty() == false)
+		{
+			m_pA->ScatterAdd(ke, *map);
+			return;
+		}
+	}
+
 	m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
 }
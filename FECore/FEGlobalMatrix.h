@@ -45,8 +45,8 @@ class FECORE_API FEElementMatrix : public matrix
 {
 public:
 	// default constructor
-	FEElementMatrix(){}
-	FEElementMatrix(int nr, int nc) : matrix(nr, nc) {}
+	FEElementMatrix() : m_map(nullptr) {}
+	FEElementMatrix(int nr, int nc) : matrix(nr, nc), m_map(nullptr) {}
 	FEElementMatrix(const FEElement& el);
 
 	// constructor for symmetric matrices
@@ -82,10 +82,18 @@ public:
 	// get the nodes
 	const std::vector<int>& Nodes() const { return m_node; }
 
+	// Set the scatter map cache of this element matrix (see SparseMatrix::ScatterMap)
+	// If the map is empty, it will be filled the first time the matrix is assembled.
+	void SetScatterMap(std::vector<int>* map) { m_map = map; }
+
+	// get the scatter map cache (can be null)
+	std::vector<int>* ScatterMap() const { return m_map; }
+
 private:
 	std::vector<int>	m_node;	//!< node indices
 	std::vector<int>	m_lmi;	//!< row indices
 	std::vector<int>	m_lmj;	//!< column indices
+	std::vector<int>*	m_map;	//!< scatter map cache (not owned)
 };
 
 //-----------------------------------------------------------------------------
@@ -116,6 +124,9 @@ public:
 	//! construct the stiffness matrix from a FEM object
 	bool Create(FEModel* pfem, int neq, bool breset);
 
+	//! see if the sparse matrix can be kept after the "dynamic" part of the profile changed
+	bool UpdateDynamicProfile(FEModel* pfem, int neq);
+
 	//! construct the stiffness matrix from a mesh
 	bool Create(FEMesh& mesh, int neq);
 
@@ -153,6 +164,10 @@ public:
 	//! get the sparse matrix profile
 	SparseMatrixProfile* GetSparseMatrixProfile() { return m_pMP; }
 
+	//! Returns a number that uniquely identifies the current matrix profile.
+	//! This changes each time the sparse matrix is (re)created.
+	int ProfileStamp() const { return m_nstamp; }
+
 public:
 	void build_begin(int neq);
 	void build_add(std::vector<int>& lm);
@@ -170,4 +185,9 @@ protected:
 	SparseMatrixProfile		m_MPs;		//!< the "static" part of the matrix profile
 	vector< vector<int> >	m_LM;		//!< used for building the stiffness matrix
 	int	m_nlm;				//!< nr of elements in m_LM array
+
+	vector< vector<int> >	m_LMd;		//!< the "dynamic" elements of the current profile
+	bool	m_brecord;		//!< record elements in m_LMd
+	bool	m_bcollect;		//!< only collect elements (without updating the profile)
+	int	m_nstamp;			//!< identifies the current profile
 };
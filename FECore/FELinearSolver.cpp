@@ -206,6 +206,7 @@ bool FELinearSolver::SolveStep()
 	vector<double> u(m_neq);
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE_SCOPE("backsolve", m_pls);
 		if (m_pls->BackSolve(u, m_R) == false)
 			throw LinearSolverFailed();
 	}
@@ -262,6 +263,7 @@ bool FELinearSolver::ReformStiffness()
 	// factorize the stiffness matrix
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE_SCOPE("factor", m_pls);
 		m_pls->Factor();
 	}
 
@@ -300,6 +302,7 @@ bool FELinearSolver::CreateStiffness()
 	// Do the preprocessing of the solver
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE_SCOPE("preprocess", m_pls);
 		if (!m_pls->PreProcess()) throw FatalError();
 	}
 
@@ -451,6 +454,7 @@ void FELinearSolver::Update(vector<double>& u)
 	for (int i=0; i<mesh.Domains(); ++i)
 	{
 		FEDomain& dom = mesh.Domain(i);
+		FE_PROFILE_DOMAIN("update", &dom);
 		dom.Update(tp);
 	}
 }
@@ -57,6 +57,41 @@ FESolver* FELinearSystem::GetSolver()
 	return m_solver;
 }
 
+//-----------------------------------------------------------------------------
+// See if elements can be assembled one color at a time. Linear constraints can couple
+// the dofs of different elements, so in that case we always use atomic assembly.
+bool FELinearSystem::ColoredAssembly()
+{
+	if ((m_solver == nullptr) || (m_solver->m_bcolorAssembly == false)) return false;
+
+	FEModel* fem = m_solver->GetFEModel();
+	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+	return (LCM.LinearConstraints() == 0);
+}
+
+//-----------------------------------------------------------------------------
+// Turn atomic updates of the global matrix and RHS on or off
+void FELinearSystem::SetAtomicAssembly(bool b)
+{
+	SparseMatrix* K = m_K.GetSparseMatrixPtr();
+	if (K) K->SetAtomicAssembly(b);
+}
+
+//-----------------------------------------------------------------------------
+// See if element scatter maps should be cached
+bool FELinearSystem::CacheScatterMaps()
+{
+	return (m_solver && m_solver->m_bscatterMaps);
+}
+
+//-----------------------------------------------------------------------------
+// Get the profile stamp of the global matrix. Cached scatter maps are only valid
+// as long as this value does not change.
+int FELinearSystem::ProfileStamp() const
+{
+	return m_K.ProfileStamp();
+}
+
 //-----------------------------------------------------------------------------
 //! assemble global stiffness matrix
 void FELinearSystem::Assemble(const FEElementMatrix& ke)
@@ -68,6 +103,7 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 
 	// check the prescribed contributions
 	SparseMatrix& K = m_K;
+	bool batomic = K.AtomicAssembly();
 	int N = ke.rows();
 	int neq = m_K.Rows();
 
@@ -88,8 +124,12 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 				if (I >= 0)
 				{
 					// dof i is not a prescribed degree of freedom
+					if (batomic)
+					{
 #pragma omp atomic
-					m_F[I] -= ke[i][j] * m_u[J];
+						m_F[I] -= ke[i][j] * m_u[J];
+					}
+					else m_F[I] -= ke[i][j] * m_u[J];
 				}
 			}
 
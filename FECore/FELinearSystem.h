@@ -56,6 +56,18 @@ public:
 	// Get the solver that is using this linear system
 	FESolver* GetSolver();
 
+	// See if elements can be assembled one color at a time (i.e. without atomics)
+	virtual bool ColoredAssembly();
+
+	// Turn atomic updates of the global matrix and RHS on or off
+	void SetAtomicAssembly(bool b);
+
+	// See if element scatter maps should be cached
+	bool CacheScatterMaps();
+
+	// Get the profile stamp of the global matrix
+	int ProfileStamp() const;
+
 public:
 	// Assembly routine
 	// This assembles the element stiffness matrix ke into the global matrix.
@@ -62,6 +62,14 @@ mat3d FEMaterial::GetLocalCS(const FEMaterialPoint& mp)
 	else return m_Q(mp);
 }
 
+//-----------------------------------------------------------------------------
+bool FEMaterial::HasUniformLocalCS()
+{
+	if (m_Q.isConst() == false) return false;
+	FEMaterial* parent = dynamic_cast<FEMaterial*>(GetParent());
+	return (parent ? parent->HasUniformLocalCS() : true);
+}
+
 //-----------------------------------------------------------------------------
 //! Initial material.
 bool FEMaterial::Init()
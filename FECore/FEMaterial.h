@@ -67,6 +67,9 @@ public:
 	// evaluate local coordinate system at material point
 	mat3d GetLocalCS(const FEMaterialPoint& mp);
 
+	// returns true if the local coordinate system is the same at all material points
+	bool HasUniformLocalCS();
+
 public:
 	//! Assign a domain to this material
 	void AddDomain(FEDomain* dom);
@@ -31,6 +31,56 @@ SOFTWARE.*/
 #include "DumpStream.h"
 #include <string.h>
 
+//-----------------------------------------------------------------------------
+// The registered slots. The count is only increased after the cast function is stored,
+// so that the slots below the count can be read without locking.
+static FEMaterialPointSlots::CastFunction	slot_cast[FEMaterialPointSlots::MAX_SLOTS];
+static int	slot_count = 0;
+
+int FEMaterialPointSlots::Register(CastFunction f)
+{
+	int slot = MAX_SLOTS;
+	#pragma omp critical (FEMaterialPointSlots)
+	{
+		int n = Slots();
+		if (n < MAX_SLOTS)
+		{
+			slot_cast[n] = f;
+			slot = n;
+			#pragma omp atomic write
+			slot_count = n + 1;
+		}
+	}
+	return slot;
+}
+
+int FEMaterialPointSlots::Slots()
+{
+	int n;
+	#pragma omp atomic read
+	n = slot_count;
+	return n;
+}
+
+FEMaterialPointSlots::CastFunction FEMaterialPointSlots::GetCastFunction(int slot)
+{
+	return slot_cast[slot];
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointSlotTable::Build(FEMaterialPoint* pt)
+{
+	m_data.clear();
+	int N = FEMaterialPointSlots::Slots();
+	for (int i = 0; i < N; ++i)
+	{
+		void* p = pt->FindSlotData(i);
+		if (p) m_data.push_back(pair<int, void*>(i, p));
+	}
+	m_nslots = N;
+}
+
+//-----------------------------------------------------------------------------
 FEMaterialPoint::FEMaterialPoint(FEMaterialPoint* ppt)
 {
 	m_pPrev = 0;
@@ -47,16 +97,84 @@ FEMaterialPoint::~FEMaterialPoint()
 
 void FEMaterialPoint::SetPrev(FEMaterialPoint* pt)
 {
+	InvalidateSlotTables();
 	m_pPrev = pt;
 }
 
 // TODO: What if the next pointer is already assigned?
 void FEMaterialPoint::SetNext(FEMaterialPoint* pt)
 {
+	InvalidateSlotTables();
+	pt->InvalidateSlotTables();
 	m_pNext = pt;
 	pt->m_pPrev = this;
 }
 
+//-----------------------------------------------------------------------------
+// This does the same search as ExtractData, but for a registered slot.
+void* FEMaterialPoint::FindSlotData(int slot)
+{
+	FEMaterialPointSlots::CastFunction cast = FEMaterialPointSlots::GetCastFunction(slot);
+
+	// first see if this is the correct type
+	void* p = cast(this);
+	if (p) return p;
+
+	// check all the child classes 
+	FEMaterialPoint* pt = this;
+	while (pt->m_pNext)
+	{
+		pt = pt->m_pNext;
+		p = cast(pt);
+		if (p) return p;
+	}
+
+	// search up
+	pt = this;
+	while (pt->m_pPrev)
+	{
+		pt = pt->m_pPrev;
+		p = cast(pt);
+		if (p) return p;
+	}
+
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPoint::BuildSlotTable()
+{
+	m_slots.Build(this);
+	for (int i = 0; i < Components(); ++i)
+	{
+		FEMaterialPoint* pi = GetPointData(i);
+		if (pi && (pi != this)) pi->BuildSlotTable();
+	}
+	if (m_pNext) m_pNext->BuildSlotTable();
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPoint::ClearSlotTable()
+{
+	m_slots.Clear();
+	for (int i = 0; i < Components(); ++i)
+	{
+		FEMaterialPoint* pi = GetPointData(i);
+		if (pi && (pi != this)) pi->ClearSlotTable();
+	}
+	if (m_pNext) m_pNext->ClearSlotTable();
+}
+
+//-----------------------------------------------------------------------------
+// The lookups of all points in the list depend on the list's structure, so when 
+// the structure changes, the tables of all points are cleared. 
+void FEMaterialPoint::InvalidateSlotTables()
+{
+	FEMaterialPoint* pt = this;
+	while (pt->m_pPrev) pt = pt->m_pPrev;
+	pt->ClearSlotTable();
+}
+
 void FEMaterialPoint::Init()
 {
 	if (m_pNext) m_pNext->Init();
@@ -85,6 +203,7 @@ FEMaterialPointArray::FEMaterialPointArray(FEMaterialPoint* ppt) : FEMaterialPoi
 //-----------------------------------------------------------------------------
 void FEMaterialPointArray::AddMaterialPoint(FEMaterialPoint* pt)
 {
+	pt->ClearSlotTable();
 	m_mp.push_back(pt);
 	pt->SetPrev(this);
 }
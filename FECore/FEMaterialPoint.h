@@ -34,6 +34,75 @@ SOFTWARE.*/
 using namespace std;
 
 class FEElement;
+class FEMaterialPoint;
+
+//-----------------------------------------------------------------------------
+//! Registry of the material point types that are retrieved with FEMaterialPoint::ExtractData.
+//! Each type is assigned a slot the first time it is requested. 
+class FECORE_API FEMaterialPointSlots
+{
+public:
+	enum { MAX_SLOTS = 256 };
+
+	typedef void* (*CastFunction)(FEMaterialPoint* pt);
+
+public:
+	//! register a new type and return its slot (returns MAX_SLOTS if the registry is full)
+	static int Register(CastFunction f);
+
+	//! number of registered slots
+	static int Slots();
+
+	//! return the cast function of a slot
+	static CastFunction GetCastFunction(int slot);
+};
+
+//-----------------------------------------------------------------------------
+//! Slot of a particular material point type
+template <class T> class FEMaterialPointSlot
+{
+public:
+	static int Index()
+	{
+		static int slot = FEMaterialPointSlots::Register(&FEMaterialPointSlot<T>::Cast);
+		return slot;
+	}
+
+	static void* Cast(FEMaterialPoint* pt) { return dynamic_cast<T*>(pt); }
+};
+
+//-----------------------------------------------------------------------------
+//! Table that stores the result of the type lookups of a material point, so that
+//! ExtractData does not need to walk the material point list with dynamic_casts.
+//! The table is not copied, since it refers to the material point list it was built for.
+class FECORE_API FEMaterialPointSlotTable
+{
+public:
+	FEMaterialPointSlotTable() : m_nslots(0) {}
+	FEMaterialPointSlotTable(const FEMaterialPointSlotTable&) : m_nslots(0) {}
+	void operator = (const FEMaterialPointSlotTable&) { Clear(); }
+
+	//! number of slots that were evaluated when the table was built
+	int Slots() const { return m_nslots; }
+
+	//! find the data for a slot (only valid if slot < Slots())
+	void* Find(int slot) const
+	{
+		for (size_t i = 0; i < m_data.size(); ++i)
+			if (m_data[i].first == slot) return m_data[i].second;
+		return nullptr;
+	}
+
+	//! build the table for a material point
+	void Build(FEMaterialPoint* pt);
+
+	//! clear the table
+	void Clear() { m_data.clear(); m_nslots = 0; }
+
+private:
+	vector< pair<int, void*> >	m_data;		//!< slots for which the material point has data
+	int							m_nslots;	//!< number of slots evaluated
+};
 
 //-----------------------------------------------------------------------------
 //! Material point class
@@ -77,6 +146,16 @@ public:
 	template <class T> T* ExtractData();
 	template <class T> const T* ExtractData() const;
 
+	//! Find the data for a slot by walking the material point list
+	void* FindSlotData(int slot);
+
+	//! Build the slot tables of this point and all its child points. This should be 
+	//! called after the material point data was created. 
+	void BuildSlotTable();
+
+	//! Clear the slot tables of this point and all its child points
+	void ClearSlotTable();
+
 	// assign the previous pointer
 	void SetPrev(FEMaterialPoint* pt);
 
@@ -98,14 +177,25 @@ public:
 	// pointer to element's shape function values
 	double*		m_shape;
 
+protected:
+	//! clear the slot tables of the entire material point list that this point belongs to
+	void InvalidateSlotTables();
+
 protected:
 	FEMaterialPoint*	m_pNext;	//<! next data in the list
 	FEMaterialPoint*	m_pPrev;	//<! previous data in the list
+
+private:
+	FEMaterialPointSlotTable	m_slots;	//!< cached results of type lookups
 };
 
 //-----------------------------------------------------------------------------
 template <class T> inline T* FEMaterialPoint::ExtractData()
 {
+	// use the slot table if it's available
+	int slot = FEMaterialPointSlot<T>::Index();
+	if (slot < m_slots.Slots()) return static_cast<T*>(m_slots.Find(slot));
+
 	// first see if this is the correct type
 	T* p = dynamic_cast<T*>(this);
 	if (p) return p;
@@ -135,6 +225,10 @@ template <class T> inline T* FEMaterialPoint::ExtractData()
 //-----------------------------------------------------------------------------
 template <class T> inline const T* FEMaterialPoint::ExtractData() const
 {
+	// use the slot table if it's available
+	int slot = FEMaterialPointSlot<T>::Index();
+	if (slot < m_slots.Slots()) return static_cast<const T*>(m_slots.Find(slot));
+
 	// first see if this is the correct type
 	const T* p = dynamic_cast<const T*>(this);
 	if (p) return p;
@@ -43,6 +43,7 @@ SOFTWARE.*/
 #include "FESurfaceMap.h"
 #include "FENodeDataMap.h"
 #include "DumpStream.h"
+#include "FEProfiler.h"
 #include <algorithm>
 
 //-----------------------------------------------------------------------------
@@ -290,6 +291,12 @@ void FEMesh::UpdateBox()
 	else m_box = FEBoundingBox(vec3d(0,0,0));
 }
 
+//-----------------------------------------------------------------------------
+void FEMesh::ReferenceGeometryChanged()
+{
+	for (int i = 0; i < Domains(); ++i) Domain(i).ReferenceGeometryChanged();
+}
+
 //-----------------------------------------------------------------------------
 //  Counts the number of shell elements in the mesh
 //
@@ -870,7 +877,11 @@ void FEMesh::Update(const FETimeInfo& tp)
 	for (int i = 0; i<Domains(); ++i)
 	{
 		FEDomain& dom = Domain(i);
-		if (dom.IsActive()) dom.Update(tp);
+		if (dom.IsActive())
+		{
+			FE_PROFILE_DOMAIN("update", &dom);
+			dom.Update(tp);
+		}
 	}
 }
 
@@ -109,6 +109,10 @@ public:
 	//! retrieve the bounding box
 	FEBoundingBox& GetBoundingBox() { return m_box; }
 
+	//! This must be called when the reference nodal coordinates are changed after the domains
+	//! were initialized, so that the domains can update any data that depends on them.
+	void ReferenceGeometryChanged();
+
 	//! remove isolated vertices
 	int RemoveIsolatedVertices();
 
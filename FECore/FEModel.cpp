@@ -57,6 +57,7 @@ SOFTWARE.*/
 #include "LinearSolver.h"
 #include "FETimeStepController.h"
 #include "Timer.h"
+#include "FEProfiler.h"
 #include <stdarg.h>
 using namespace std;
 
@@ -575,7 +576,11 @@ void FEModel::Update()
 	for (int i = 0; i < SurfacePairConstraints(); ++i)
 	{
 		FESurfacePairConstraint* psc = SurfacePairConstraint(i);
-		if (psc && psc->IsActive()) psc->Update();
+		if (psc && psc->IsActive())
+		{
+			FE_PROFILE_SCOPE("contact", psc);
+			psc->Update();
+		}
 	}
 
 	// update all constraints
@@ -1924,6 +1929,15 @@ Timer* FEModel::GetTimer(int i)
 	return &(m_imp->m_timers[i]);
 }
 
+//-----------------------------------------------------------------------------
+const char* FEModel::GetTimerName(int i)
+{
+	// this must match the TimerID enum
+	static const char* szname[] = { "update", "solve", "reform", "residual", "stiffness", "QN update" };
+	const int N = sizeof(szname) / sizeof(const char*);
+	return ((i >= 0) && (i < N) ? szname[i] : "timer");
+}
+
 //-----------------------------------------------------------------------------
 //! return number of mesh adaptors
 int FEModel::MeshAdaptors()
@@ -416,6 +416,9 @@ public:
 	// return a timer by index
 	Timer* GetTimer(int i);
 
+	// return the name of a timer (used by the profiler)
+	static const char* GetTimerName(int i);
+
 protected:
 	FEParamValue GetMeshParameter(const ParamString& paramString);
 
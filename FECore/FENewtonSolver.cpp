@@ -54,6 +54,7 @@ BEGIN_FECORE_CLASS(FENewtonSolver, FESolver)
 	ADD_PARAMETER(m_breformAugment      , "reform_augment");
 	ADD_PARAMETER(m_bdivreform          , "diverge_reform");
 	ADD_PARAMETER(m_bdoreforms          , "do_reforms"  );
+	ADD_PARAMETER(m_breuseProfile       , "reuse_profile");
 	ADD_PARAMETER(m_Etol                , "etol"        );
 	ADD_PARAMETER(m_Rtol                , "rtol"        );
 	ADD_PARAMETER(m_Rmin, FE_RANGE_GREATER_OR_EQUAL(0.0), "min_residual");
@@ -100,6 +101,7 @@ FENewtonSolver::FENewtonSolver(FEModel* pfem) : FESolver(pfem)
 	m_bforceReform = true;
 	m_bdivreform = true;
 	m_bdoreforms = true;
+	m_breuseProfile = false;
 
 	m_bzero_diagonal = false;
 	m_zero_tol = 0.0;
@@ -227,6 +229,7 @@ bool FENewtonSolver::ReformStiffness()
     {
         {
 			TRACK_TIME(TimerID::Timer_Solve);
+			FE_PROFILE_SCOPE("factor", m_plinsolve);
 			// factorize the stiffness matrix
 			if (m_plinsolve->Factor() == false)
 			{
@@ -264,6 +267,19 @@ void FENewtonSolver::GetSolutionVector(std::vector<double>& U)
 //! \todo Can we move this to the FEGlobalMatrix::Create function?
 bool FENewtonSolver::CreateStiffness(bool breset)
 {
+	// If only the dynamic part of the profile (e.g. contact) can change, see if we
+	// can keep the current matrix. In that case, the linear solver does not need
+	// to be destroyed and we can skip its preprocessing (i.e. symbolic analysis).
+	if ((breset == false) && m_breuseProfile)
+	{
+		TRACK_TIME(TimerID::Timer_Reform);
+		if (m_pK->UpdateDynamicProfile(GetFEModel(), m_neq))
+		{
+			feLog("===== stiffness matrix profile unchanged\n");
+			return true;
+		}
+	}
+
 	{
 		TRACK_TIME(TimerID::Timer_Reform);
 		// clean up the solver
@@ -302,6 +318,7 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 	// Do the preprocessing of the solver
 	{
 		TRACK_TIME(TimerID::Timer_Solve);
+		FE_PROFILE_SCOPE("preprocess", m_plinsolve);
 		if (!m_plinsolve->PreProcess())
 		{
 			feLogError("An error occurred during preprocessing of linear solver");
@@ -772,6 +789,7 @@ bool FENewtonSolver::CheckConvergence(int niter, const vector<double>& ui, doubl
 void FENewtonSolver::SolveLinearSystem(vector<double>& x, vector<double>& R)
 {
 	// solve the equations
+	FE_PROFILE_SCOPE("backsolve", m_plinsolve);
 	if (m_plinsolve->BackSolve(x, R) == false)
 		throw LinearSolverFailed();
 }
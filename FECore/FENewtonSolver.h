@@ -229,6 +229,7 @@ public:
 	bool				m_bforceReform;		//!< forces a reform in QNInit
 	bool				m_bdivreform;		//!< reform when diverging
 	bool				m_bdoreforms;		//!< do reformations
+	bool				m_breuseProfile;	//!< keep the matrix profile when the dynamic profile fits
 
 	// counters
 	int		m_nref;			//!< nr of stiffness retormations
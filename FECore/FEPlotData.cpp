@@ -39,6 +39,7 @@ FEPlotData::FEPlotData(FEModel* fem) : FECoreBase(fem)
 	m_nregion = FE_REGION_NODE;
 
 	m_arraySize = 0;
+	m_bthreadSafe = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -49,6 +50,7 @@ FEPlotData::FEPlotData(FEModel* fem, Region_Type R, Var_Type t, Storage_Fmt s) :
     m_nregion = R;
 
 	m_arraySize = 0;
+	m_bthreadSafe = false;
 }
 
 //-----------------------------------------------------------------------------
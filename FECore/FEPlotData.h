@@ -91,10 +91,17 @@ public:
     void SetDomainName(const char* szdom);
 	const char* GetDomainName() { return m_szdom;  }
 
+	// The plot file evaluates the plot variables of a state in parallel, but only those that set this flag.
+	// This is safe as long as Save() only reads the model data. Plot variables that evaluate the material
+	// (e.g. the tangent), which may modify the material point data, must not set it. Variables that don't
+	// set the flag are evaluated serially.
+	bool IsThreadSafe() const { return m_bthreadSafe; }
+
 protected:
 	void SetRegionType(Region_Type rt) { m_nregion = rt; }
 	void SetVarType(Var_Type vt) { m_ntype = vt; }
 	void SetStorageFormat(Storage_Fmt sf) { m_sfmt = sf; }
+	void SetThreadSafe(bool b) { m_bthreadSafe = b; }
 
 public: // override one of these functions depending on the Region_Type
 	virtual bool Save(FEMesh&    m, FEDataStream& a) { return false; }		// for FE_REGION_NODE
@@ -117,6 +124,8 @@ private:
 
 	int				m_arraySize;	//!< size of arrays (used by arrays)
 	vector<string>	m_arrayNames;	//!< optional names of array components (used by arrays)
+
+	bool			m_bthreadSafe;	//!< Save() can be called in parallel with other plot variables
 };
 
 //-----------------------------------------------------------------------------
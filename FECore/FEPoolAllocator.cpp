@@ -0,0 +1,99 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEPoolAllocator.h"
+#include <new>
+
+//-----------------------------------------------------------------------------
+FEPoolAllocator::FEPoolAllocator(size_t blockSize, size_t blocksPerChunk)
+{
+	// round up the block size so that all blocks are properly aligned
+	const size_t align = 16;
+	m_size = blockSize;
+	m_blockSize = ((blockSize + align - 1) / align)*align;
+	if (m_blockSize < sizeof(void*)) m_blockSize = sizeof(void*);
+
+	m_chunkBlocks = (blocksPerChunk > 0 ? blocksPerChunk : 1);
+	m_used = m_chunkBlocks;
+	m_free = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEPoolAllocator::~FEPoolAllocator()
+{
+	for (size_t i = 0; i < m_chunk.size(); ++i) ::operator delete(m_chunk[i]);
+	m_chunk.clear();
+}
+
+//-----------------------------------------------------------------------------
+void* FEPoolAllocator::Allocate(size_t size)
+{
+	if (size != m_size) return ::operator new(size);
+
+	void* p = nullptr;
+	#pragma omp critical (FEPoolAllocator)
+	{
+		if (m_free)
+		{
+			// reuse a released block
+			p = m_free;
+			m_free = *((void**)m_free);
+		}
+		else
+		{
+			// allocate a new chunk if the last one is full
+			if (m_used == m_chunkBlocks)
+			{
+				m_chunk.push_back((char*) ::operator new(m_chunkBlocks*m_blockSize));
+				m_used = 0;
+			}
+			p = m_chunk.back() + m_used*m_blockSize;
+			m_used++;
+		}
+	}
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+void FEPoolAllocator::Deallocate(void* p, size_t size)
+{
+	if (p == nullptr) return;
+	if (size != m_size) { ::operator delete(p); return; }
+
+	#pragma omp critical (FEPoolAllocator)
+	{
+		*((void**)p) = m_free;
+		m_free = p;
+	}
+}
+
+//-----------------------------------------------------------------------------
+size_t FEPoolAllocator::Reserved() const
+{
+	return m_chunk.size()*m_chunkBlocks*m_blockSize;
+}
@@ -0,0 +1,66 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <stddef.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Allocator for many small objects of the same size (e.g. material point data).
+//! The objects are allocated from large contiguous chunks, which reduces the number
+//! of heap allocations and keeps objects that are created together close in memory.
+//! Released objects are kept in a free list and reused. The chunks are only 
+//! returned to the heap when the allocator is deleted. 
+class FECORE_API FEPoolAllocator
+{
+public:
+	FEPoolAllocator(size_t blockSize, size_t blocksPerChunk = 4096);
+	~FEPoolAllocator();
+
+	//! allocate an object. If the size does not match the block size, the global heap is used.
+	void* Allocate(size_t size);
+
+	//! release an object that was allocated with Allocate
+	void Deallocate(void* p, size_t size);
+
+	//! return the number of bytes reserved by this allocator
+	size_t Reserved() const;
+
+private:
+	FEPoolAllocator(const FEPoolAllocator&) {}
+	void operator = (const FEPoolAllocator&) {}
+
+private:
+	size_t	m_size;			//!< requested object size
+	size_t	m_blockSize;	//!< size of a block (object size rounded up for alignment)
+	size_t	m_chunkBlocks;	//!< number of blocks per chunk
+	size_t	m_used;			//!< number of blocks used in the last chunk
+	void*	m_free;			//!< free list
+
+	std::vector<char*>	m_chunk;	//!< allocated chunks
+};
@@ -0,0 +1,257 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEProfiler.h"
+#include "FECoreBase.h"
+#include "FEDomain.h"
+#include "FEMaterial.h"
+#include "sys.h"
+#include <chrono>
+#include <stdio.h>
+
+typedef std::chrono::steady_clock profile_clock;
+
+//-----------------------------------------------------------------------------
+// data recorded by each thread
+struct FEProfileThread
+{
+	FEProfileNode	m_root;
+	FEProfileNode*	m_current;
+	std::vector<profile_clock::time_point>	m_start;
+
+	FEProfileThread() { m_current = &m_root; }
+};
+
+bool FEProfiler::m_benabled = false;
+static std::vector<FEProfileThread*> profile_threads;
+
+//-----------------------------------------------------------------------------
+double FEProfileNode::SelfTime() const
+{
+	double t = m_time;
+	for (size_t i = 0; i < m_child.size(); ++i) t -= m_child[i]->m_time;
+	return (t > 0.0 ? t : 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Enable(bool b)
+{
+	if (b)
+	{
+		Reset();
+		int nt = omp_get_max_threads();
+		if (nt < 1) nt = 1;
+		for (int i = 0; i < nt; ++i) profile_threads.push_back(new FEProfileThread);
+	}
+	m_benabled = b;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Reset()
+{
+	for (size_t i = 0; i < profile_threads.size(); ++i) delete profile_threads[i];
+	profile_threads.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::Enter(const char* szcat, const std::string& name)
+{
+	// scopes of threads that were not allocated are not recorded
+	int tid = omp_get_thread_num();
+	if ((tid < 0) || (tid >= (int)profile_threads.size())) return false;
+	FEProfileThread& td = *profile_threads[tid];
+
+	// find the child node
+	FEProfileNode* node = td.m_current;
+	FEProfileNode* child = nullptr;
+	for (size_t i = 0; i < node->m_child.size(); ++i)
+	{
+		FEProfileNode* ci = node->m_child[i];
+		if ((ci->m_cat == szcat) && (ci->m_name == name)) { child = ci; break; }
+	}
+
+	// add a new one if it does not exist yet
+	if (child == nullptr)
+	{
+		child = new FEProfileNode;
+		child->m_cat = szcat;
+		child->m_name = name;
+		child->m_parent = node;
+		node->m_child.push_back(child);
+	}
+
+	td.m_current = child;
+	td.m_start.push_back(profile_clock::now());
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Leave()
+{
+	int tid = omp_get_thread_num();
+	if ((tid < 0) || (tid >= (int)profile_threads.size())) return;
+	FEProfileThread& td = *profile_threads[tid];
+	if (td.m_start.empty()) return;
+
+	std::chrono::duration<double> dt = profile_clock::now() - td.m_start.back();
+	td.m_start.pop_back();
+
+	FEProfileNode* node = td.m_current;
+	node->m_time += dt.count();
+	node->m_calls++;
+	td.m_current = node->m_parent;
+}
+
+//-----------------------------------------------------------------------------
+static std::string node_label(const FEProfileNode& node)
+{
+	if (node.m_name.empty()) return node.m_cat;
+	return node.m_cat + ":" + node.m_name;
+}
+
+//-----------------------------------------------------------------------------
+static void write_json_string(FILE* fp, const std::string& s)
+{
+	fputc('"', fp);
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		char c = s[i];
+		if ((c == '"') || (c == '\\')) { fputc('\\', fp); fputc(c, fp); }
+		else if ((unsigned char)c < 0x20) fputc(' ', fp);
+		else fputc(c, fp);
+	}
+	fputc('"', fp);
+}
+
+//-----------------------------------------------------------------------------
+static void write_json_node(FILE* fp, const FEProfileNode& node, int level)
+{
+	std::string tab(2*level, ' ');
+	fprintf(fp, "%s{\"name\": ", tab.c_str());
+	write_json_string(fp, node_label(node));
+	fprintf(fp, ", \"time\": %.6lf, \"self\": %.6lf, \"calls\": %lld, \"children\": [", node.m_time, node.SelfTime(), node.m_calls);
+	if (node.m_child.empty() == false)
+	{
+		fprintf(fp, "\n");
+		for (size_t i = 0; i < node.m_child.size(); ++i)
+		{
+			write_json_node(fp, *node.m_child[i], level + 1);
+			fprintf(fp, (i + 1 < node.m_child.size() ? ",\n" : "\n"));
+		}
+		fprintf(fp, "%s", tab.c_str());
+	}
+	fprintf(fp, "]}");
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::WriteJSON(const char* szfile)
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	fprintf(fp, "{\"threads\": [\n");
+	bool bfirst = true;
+	for (size_t i = 0; i < profile_threads.size(); ++i)
+	{
+		const FEProfileNode& root = profile_threads[i]->m_root;
+		if (root.m_child.empty()) continue;
+
+		if (bfirst == false) fprintf(fp, ",\n");
+		bfirst = false;
+
+		fprintf(fp, "  {\"thread\": %d, \"scopes\": [\n", (int)i);
+		for (size_t j = 0; j < root.m_child.size(); ++j)
+		{
+			write_json_node(fp, *root.m_child[j], 2);
+			fprintf(fp, (j + 1 < root.m_child.size() ? ",\n" : "\n"));
+		}
+		fprintf(fp, "  ]}");
+	}
+	fprintf(fp, "\n]}\n");
+	fclose(fp);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Each line contains the call stack (separated by semi-colons) and the 
+// time spent in the last scope (in microseconds)
+static void write_folded_node(FILE* fp, const FEProfileNode& node, const std::string& path)
+{
+	std::string label = node_label(node);
+	for (size_t i = 0; i < label.size(); ++i) if ((label[i] == ';') || (label[i] == ' ')) label[i] = '_';
+	std::string stack = path + ";" + label;
+
+	long long usec = (long long)(node.SelfTime()*1e6 + 0.5);
+	if (usec > 0) fprintf(fp, "%s %lld\n", stack.c_str(), usec);
+
+	for (size_t i = 0; i < node.m_child.size(); ++i) write_folded_node(fp, *node.m_child[i], stack);
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::WriteFlameGraph(const char* szfile)
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	for (size_t i = 0; i < profile_threads.size(); ++i)
+	{
+		const FEProfileNode& root = profile_threads[i]->m_root;
+		char szthread[32];
+		sprintf(szthread, "thread_%d", (int)i);
+		for (size_t j = 0; j < root.m_child.size(); ++j) write_folded_node(fp, *root.m_child[j], szthread);
+	}
+	fclose(fp);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+static bool FEProfileScope_Enter(const char* szcat, FECoreBase* pc)
+{
+	if (pc == nullptr) return FEProfiler::Enter(szcat, std::string());
+	const std::string& name = pc->GetName();
+	if (name.empty() == false) return FEProfiler::Enter(szcat, name);
+	const char* sztype = pc->GetTypeStr();
+	return FEProfiler::Enter(szcat, (sztype ? std::string(sztype) : std::string()));
+}
+
+bool FEProfileScope::Enter(const char* szcat, FECoreBase* pc)
+{
+	return FEProfileScope_Enter(szcat, pc);
+}
+
+//-----------------------------------------------------------------------------
+int FEDomainProfileScope::Enter(const char* szcat, FEDomain* dom)
+{
+	int n = 0;
+	FEMaterial* mat = (dom ? dom->GetMaterial() : nullptr);
+	if (mat && FEProfileScope_Enter("material", mat)) n++;
+	if (FEProfileScope_Enter(szcat, dom)) n++;
+	return n;
+}
@@ -0,0 +1,139 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <string>
+#include <vector>
+
+class FECoreBase;
+class FEDomain;
+
+//-----------------------------------------------------------------------------
+//! A node in the profiler's call tree.
+struct FEProfileNode
+{
+	std::string		m_cat;		//!< category (e.g. "domain", "contact")
+	std::string		m_name;		//!< name of the object that was profiled
+	double			m_time;		//!< accumulated time (in seconds)
+	long long		m_calls;	//!< number of calls
+
+	FEProfileNode*					m_parent;
+	std::vector<FEProfileNode*>		m_child;
+
+	FEProfileNode() : m_time(0.0), m_calls(0), m_parent(nullptr) {}
+	~FEProfileNode() { for (size_t i = 0; i < m_child.size(); ++i) delete m_child[i]; }
+
+	//! time spent in this node, but not in any of its children
+	double SelfTime() const;
+};
+
+//-----------------------------------------------------------------------------
+//! The profiler records the time spent in nested scopes, such as the calls to the domains, 
+//! materials, contact interfaces, and linear solvers. Each thread records its own
+//! call tree. When the profiler is disabled (the default), opening a scope
+//! only tests a flag.
+class FECORE_API FEProfiler
+{
+public:
+	//! enable or disable the profiler. Enabling the profiler clears all previous data.
+	static void Enable(bool b);
+
+	//! see if the profiler is enabled
+	static bool IsEnabled() { return m_benabled; }
+
+	//! clear all recorded data
+	static void Reset();
+
+	//! enter a scope on the calling thread. Returns false if the scope was not recorded.
+	static bool Enter(const char* szcat, const std::string& name);
+
+	//! leave the current scope of the calling thread
+	static void Leave();
+
+	//! write the report as a JSON file
+	static bool WriteJSON(const char* szfile);
+
+	//! write the report in the folded stack format used by flame graph tools
+	static bool WriteFlameGraph(const char* szfile);
+
+private:
+	static bool	m_benabled;
+};
+
+//-----------------------------------------------------------------------------
+//! Helper class that records the time until the end of the current scope.
+class FECORE_API FEProfileScope
+{
+public:
+	FEProfileScope(const char* szcat) : m_bactive(false)
+	{
+		if (FEProfiler::IsEnabled()) m_bactive = FEProfiler::Enter(szcat, std::string());
+	}
+
+	FEProfileScope(const char* szcat, const std::string& name) : m_bactive(false)
+	{
+		if (FEProfiler::IsEnabled()) m_bactive = FEProfiler::Enter(szcat, name);
+	}
+
+	//! The object's name (or its type string if it has no name) is used to label the scope
+	FEProfileScope(const char* szcat, FECoreBase* pc) : m_bactive(false)
+	{
+		if (FEProfiler::IsEnabled()) m_bactive = Enter(szcat, pc);
+	}
+
+	~FEProfileScope() { if (m_bactive) FEProfiler::Leave(); }
+
+private:
+	static bool Enter(const char* szcat, FECoreBase* pc);
+
+private:
+	bool	m_bactive;
+};
+
+//-----------------------------------------------------------------------------
+//! Helper class for profiling domain calls. The time is recorded in a scope for the 
+//! domain, which is nested in a scope for the domain's material.
+class FECORE_API FEDomainProfileScope
+{
+public:
+	FEDomainProfileScope(const char* szcat, FEDomain* dom) : m_nlevels(0)
+	{
+		if (FEProfiler::IsEnabled()) m_nlevels = Enter(szcat, dom);
+	}
+
+	~FEDomainProfileScope() { for (int i = 0; i < m_nlevels; ++i) FEProfiler::Leave(); }
+
+private:
+	static int Enter(const char* szcat, FEDomain* dom);
+
+private:
+	int	m_nlevels;
+};
+
+#define FE_PROFILE_SCOPE(cat, obj) FEProfileScope _profileScope(cat, obj)
+#define FE_PROFILE_DOMAIN(cat, dom) FEDomainProfileScope _profileDomain(cat, dom)
@@ -41,11 +41,16 @@ FESolidDomain::FESolidDomain(FEModel* pfem) : FEDomain(FE_DOMAIN_SOLID, pfem), m
     m_dofSU.AddDof(pfem->GetDOFIndex("sx"));
 	m_dofSU.AddDof(pfem->GetDOFIndex("sy"));
 	m_dofSU.AddDof(pfem->GetDOFIndex("sz"));
+
+	m_bcache = false;
 }
 
 //-----------------------------------------------------------------------------
 void FESolidDomain::Create(int nsize, int elemType)
 {
+	// the cached geometry is no longer valid
+	ClearReferenceCache();
+
 	// allocate elements
     m_Elem.resize(nsize);
 	for (int i = 0; i < nsize; ++i)
@@ -81,6 +86,10 @@ void FESolidDomain::CopyFrom(FEMeshPartition* pd)
     FESolidDomain* psd = dynamic_cast<FESolidDomain*>(pd);
     m_Elem = psd->m_Elem;
 	ForEachElement([=](FEElement& el) { el.SetMeshPartition(this); });
+
+	// the cache is rebuilt in Init
+	m_bcache = psd->m_bcache;
+	ClearReferenceCache();
 }
 
 //-----------------------------------------------------------------------------
@@ -90,6 +99,9 @@ bool FESolidDomain::Init()
 	// base class first
 	if (FEDomain::Init() == false) return false;
 
+	// the reference geometry may have changed, so clear the cache
+	ClearReferenceCache();
+
 	// init solid element data
 	// TODO: In principle I could parallelize this, but right now this cannot be done
 	//       because of the try block. 
@@ -130,9 +142,103 @@ bool FESolidDomain::Init()
 		return false;
 	}
 
+	// build the reference geometry cache
+	if (m_bcache)
+	{
+		BuildReferenceCache();
+		feLog("Reference geometry cache for domain %s: %.2lf MB\n", GetName().c_str(), ReferenceCacheSize() / 1048576.0);
+	}
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void FESolidDomain::ClearReferenceCache()
+{
+	m_cacheIP.clear();
+	m_cacheGH.clear();
+	for (int i = 0; i < 9; ++i) m_cacheJ0i[i].clear();
+	m_cacheDetJ0.clear();
+	for (int i = 0; i < 3; ++i) m_cacheGradH[i].clear();
+}
+
+//-----------------------------------------------------------------------------
+void FESolidDomain::ReferenceGeometryChanged()
+{
+	if (m_cacheDetJ0.empty()) return;
+	ClearReferenceCache();
+	BuildReferenceCache();
+}
+
+//-----------------------------------------------------------------------------
+size_t FESolidDomain::ReferenceCacheSize() const
+{
+	size_t nsize = (m_cacheIP.capacity() + m_cacheGH.capacity())*sizeof(int);
+	for (int i = 0; i < 9; ++i) nsize += m_cacheJ0i[i].capacity()*sizeof(double);
+	nsize += m_cacheDetJ0.capacity()*sizeof(double);
+	for (int i = 0; i < 3; ++i) nsize += m_cacheGradH[i].capacity()*sizeof(double);
+	return nsize;
+}
+
+//-----------------------------------------------------------------------------
+// Evaluate the reference geometry at all integration points. Note that this
+// must be called when the cache is empty, since otherwise invjac0 would return the cached values.
+void FESolidDomain::BuildReferenceCache()
+{
+	assert(m_cacheDetJ0.empty());
+	int NE = Elements();
+
+	// count integration points and shape gradients
+	vector<int> IP(NE + 1), GH(NE + 1);
+	IP[0] = GH[0] = 0;
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		IP[i + 1] = IP[i] + el.GaussPoints();
+		GH[i + 1] = GH[i] + el.GaussPoints()*el.Nodes();
+	}
+	int nip = IP[NE];
+	int ngh = GH[NE];
+
+	vector<double> J0i[9], detJ0(nip), GradH[3];
+	for (int i = 0; i < 9; ++i) J0i[i].resize(nip);
+	for (int i = 0; i < 3; ++i) GradH[i].resize(ngh);
+
+	#pragma omp parallel for
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		int neln = el.Nodes();
+		int nint = el.GaussPoints();
+		vec3d G[FEElement::MAX_NODES];
+		double Ji[3][3];
+		for (int n = 0; n < nint; ++n)
+		{
+			int k = IP[i] + n;
+			detJ0[k] = invjac0(el, Ji, n);
+			for (int a = 0; a < 3; ++a)
+				for (int b = 0; b < 3; ++b) J0i[3*a + b][k] = Ji[a][b];
+
+			ShapeGradient0(el, n, G);
+			int l = GH[i] + n*neln;
+			for (int j = 0; j < neln; ++j)
+			{
+				GradH[0][l + j] = G[j].x;
+				GradH[1][l + j] = G[j].y;
+				GradH[2][l + j] = G[j].z;
+			}
+		}
+	}
+
+	// store the cache
+	// (this is done last, so that the functions above don't use the cache)
+	m_cacheIP.swap(IP);
+	m_cacheGH.swap(GH);
+	for (int i = 0; i < 9; ++i) m_cacheJ0i[i].swap(J0i[i]);
+	m_cacheDetJ0.swap(detJ0);
+	for (int i = 0; i < 3; ++i) m_cacheGradH[i].swap(GradH[i]);
+}
+
 //-----------------------------------------------------------------------------
 // Reset data
 void FESolidDomain::Reset()
@@ -1023,6 +1129,16 @@ double FESolidDomain::defgradp(FESolidElement &el, mat3d &F, int n)
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjac0(const FESolidElement& el, double Ji[3][3], int n)
 {
+	// see if we can use the cached values
+	if (IsCached(el))
+	{
+		int k = m_cacheIP[el.GetLocalID()] + n;
+		Ji[0][0] = m_cacheJ0i[0][k]; Ji[0][1] = m_cacheJ0i[1][k]; Ji[0][2] = m_cacheJ0i[2][k];
+		Ji[1][0] = m_cacheJ0i[3][k]; Ji[1][1] = m_cacheJ0i[4][k]; Ji[1][2] = m_cacheJ0i[5][k];
+		Ji[2][0] = m_cacheJ0i[6][k]; Ji[2][1] = m_cacheJ0i[7][k]; Ji[2][2] = m_cacheJ0i[8][k];
+		return m_cacheDetJ0[k];
+	}
+
     // nodal coordinates
     vec3d r0[FEElement::MAX_NODES];
 	GetReferenceNodalCoordinates(el, r0);
@@ -1756,6 +1872,9 @@ double FESolidDomain::detJt(FESolidElement &el, int n, const double alpha)
 //! Calculate jacobian with respect to reference frame
 double FESolidDomain::detJ0(FESolidElement &el, int n)
 {
+	// see if we can use the cached value
+	if (IsCached(el)) return m_cacheDetJ0[m_cacheIP[el.GetLocalID()] + n];
+
     // nodal coordinates
     vec3d r0[FEElement::MAX_NODES];
 	GetReferenceNodalCoordinates(el, r0);
@@ -2244,6 +2363,18 @@ double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH, con
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient0(FESolidElement& el, int n, vec3d* GradH)
 {
+	// see if we can use the cached values
+	if (IsCached(el))
+	{
+		int ne = el.Nodes();
+		int l = m_cacheGH[el.GetLocalID()] + n*ne;
+		const double* Gx = &m_cacheGradH[0][l];
+		const double* Gy = &m_cacheGradH[1][l];
+		const double* Gz = &m_cacheGradH[2][l];
+		for (int i = 0; i < ne; ++i) GradH[i] = vec3d(Gx[i], Gy[i], Gz[i]);
+		return m_cacheDetJ0[m_cacheIP[el.GetLocalID()] + n];
+	}
+
     // calculate jacobian
     double Ji[3][3];
     double detJ0 = invjac0(el, Ji, n);
@@ -233,6 +233,27 @@ public:
 	//! calculate the volume of an element
 	double Volume(FESolidElement& el);
 
+public:
+	//! Turn the reference geometry cache on or off. When turned on, the inverse reference Jacobians,
+	//! their determinants and the reference shape gradients are evaluated once in Init and stored.
+	void CacheReferenceGeometry(bool b) { m_bcache = b; }
+
+	//! clear the reference geometry cache (e.g. when the mesh changes)
+	void ClearReferenceCache();
+
+	//! return the memory used by the reference geometry cache (in bytes)
+	size_t ReferenceCacheSize() const;
+
+	//! rebuilds the reference geometry cache (if it is used)
+	void ReferenceGeometryChanged() override;
+
+protected:
+	//! evaluate and store the reference geometry of all integration points
+	void BuildReferenceCache();
+
+	//! see if the reference geometry of this element is cached
+	bool IsCached(const FESolidElement& el) const { return (m_cacheDetJ0.empty() == false) && (el.GetMeshPartition() == this); }
+
 public:
 	//! get the current nodal coordinates
 	void GetCurrentNodalCoordinates(const FESolidElement& el, vec3d* rt);
@@ -272,4 +293,13 @@ protected:
 
 	FEDofList	m_dofU;
 	FEDofList	m_dofSU;
+
+private:
+	// reference geometry cache (stored as structure-of-arrays)
+	bool			m_bcache;			//!< cache the reference geometry
+	vector<int>		m_cacheIP;			//!< index of first integration point of each element
+	vector<int>		m_cacheGH;			//!< index of first shape gradient of each element
+	vector<double>	m_cacheJ0i[9];		//!< inverse reference Jacobians (row-major components)
+	vector<double>	m_cacheDetJ0;		//!< reference Jacobian determinants
+	vector<double>	m_cacheGradH[3];	//!< reference shape gradients (x, y, z components)
 };
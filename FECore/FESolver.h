@@ -170,6 +170,8 @@ public: //TODO Move these parameters elsewhere
 	int					m_msymm;		//!< matrix symmetry flag for linear solver allocation
 	int					m_eq_scheme;	//!< equation number scheme (used in InitEquations)
 	int					m_eq_order;		//!< normal or reverse ordering
+	bool				m_bcolorAssembly;	//!< assemble elements by color (without atomics)
+	bool				m_bscatterMaps;		//!< cache element scatter maps for assembly
 	int					m_neq;			//!< number of equations
 	std::vector<int>	m_part;			//!< partitions of linear system
 	std::vector<int>	m_dofMap;		//!< array stores for each equation the corresponding dof index
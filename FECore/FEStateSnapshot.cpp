@@ -0,0 +1,151 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FEStateSnapshot.h"
+#include "FEModel.h"
+#include <assert.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+FEStateSnapshot::FEStateSnapshot(FEModel& fem, bool bstateOnly) : DumpStream(fem)
+{
+	m_pb = nullptr;
+	m_npos = 0;
+	m_nsize = 0;
+	m_nreserved = 0;
+	m_bvalid = false;
+
+	SetStateOnly(bstateOnly);
+}
+
+//-----------------------------------------------------------------------------
+FEStateSnapshot::~FEStateSnapshot()
+{
+	clear();
+}
+
+//-----------------------------------------------------------------------------
+//! This releases the buffer.
+void FEStateSnapshot::clear()
+{
+	delete [] m_pb;
+	m_pb = nullptr;
+	m_npos = 0;
+	m_nsize = 0;
+	m_nreserved = 0;
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+void FEStateSnapshot::reserve(size_t l)
+{
+	if (l <= m_nreserved) return;
+
+	char* pnew = new char[l];
+	if (m_pb)
+	{
+		memcpy(pnew, m_pb, m_npos);
+		delete [] m_pb;
+	}
+	m_pb = pnew;
+	m_nreserved = l;
+}
+
+//-----------------------------------------------------------------------------
+void FEStateSnapshot::Save()
+{
+	FEModel& fem = GetFEModel();
+
+	// we write over the previous snapshot, but keep the buffer
+	Open(true, true);
+	m_npos = 0;
+	m_bvalid = false;
+
+	fem.Serialize(*this);
+
+	m_nsize = m_npos;
+	m_bvalid = true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEStateSnapshot::Restore()
+{
+	if (m_bvalid == false) return false;
+
+	FEModel& fem = GetFEModel();
+
+	Open(false, true);
+	m_npos = 0;
+
+	fem.Serialize(*this);
+
+	// make sure we read back exactly what was written
+	assert(m_npos == m_nsize);
+	return (m_npos == m_nsize);
+}
+
+//-----------------------------------------------------------------------------
+void FEStateSnapshot::CopyTo(std::vector<char>& buf) const
+{
+	if (m_bvalid == false) { buf.clear(); return; }
+	buf.assign(m_pb, m_pb + m_nsize);
+}
+
+//-----------------------------------------------------------------------------
+void FEStateSnapshot::CopyFrom(const std::vector<char>& buf)
+{
+	m_nsize = buf.size();
+	reserve(m_nsize);
+	if (m_nsize > 0) memcpy(m_pb, &buf[0], m_nsize);
+	m_bvalid = (m_nsize > 0);
+}
+
+//-----------------------------------------------------------------------------
+size_t FEStateSnapshot::write(const void* pd, size_t size, size_t count)
+{
+	assert(IsSaving());
+	size_t nsize = count*size;
+	if (m_npos + nsize > m_nreserved) reserve(2*(m_npos + nsize));
+	memcpy(m_pb + m_npos, pd, nsize);
+	m_npos += nsize;
+	return count;
+}
+
+//-----------------------------------------------------------------------------
+size_t FEStateSnapshot::read(void* pd, size_t size, size_t count)
+{
+	assert(IsLoading());
+	size_t nsize = count*size;
+	assert(m_npos + nsize <= m_nsize);
+	memcpy(pd, m_pb + m_npos, nsize);
+	m_npos += nsize;
+	return count;
+}
@@ -0,0 +1,88 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "DumpStream.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! A state snapshot records the mutable solution state of a model (nodal values,
+//! material point history, contact data, solver vectors) so that the model can be 
+//! rolled back, e.g. when a time step needs to be retried. 
+//! Unlike the DumpMemStream, this stream is state-only (see DumpStream::IsStateOnly)
+//! and its buffer is kept between snapshots, so that after the first snapshot no 
+//! memory needs to be allocated.
+//! A snapshot that is not state-only records the full shallow state instead (like
+//! the DumpMemStream). This is needed when a state is restored in another copy of 
+//! the model, since the state-only data assumes that the model it is restored in
+//! already has the data that is skipped.
+class FECORE_API FEStateSnapshot : public DumpStream
+{
+public:
+	FEStateSnapshot(FEModel& fem, bool bstateOnly = true);
+	~FEStateSnapshot();
+
+	//! record the current state of the model
+	void Save();
+
+	//! restore the model to the last saved state
+	bool Restore();
+
+	//! copy the last snapshot to a buffer
+	void CopyTo(std::vector<char>& buf) const;
+
+	//! replace the snapshot by the data in the buffer. The data must have been recorded 
+	//! from a model with the same structure as this model (e.g. a copy of this model).
+	void CopyFrom(const std::vector<char>& buf);
+
+	//! see if a state was saved
+	bool IsValid() const { return m_bvalid; }
+
+	//! size (in bytes) of the last snapshot
+	size_t size() const { return m_nsize; }
+
+	//! size (in bytes) of the allocated buffer
+	size_t reserved() const { return m_nreserved; }
+
+public: // overloaded from base class
+	size_t write(const void* pd, size_t size, size_t count) override;
+	size_t read(void* pd, size_t size, size_t count) override;
+	void clear() override;
+
+private:
+	void reserve(size_t l);
+
+private:
+	char*	m_pb;			//!< the buffer
+	size_t	m_npos;			//!< current read/write position
+	size_t	m_nsize;		//!< size of the last snapshot
+	size_t	m_nreserved;	//!< size of the allocated buffer
+	bool	m_bvalid;		//!< true if the buffer contains a snapshot
+};
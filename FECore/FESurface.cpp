@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FEMesh.h"
 #include "FESolidDomain.h"
 #include "FEElemElemList.h"
+#include "FESurfaceBVH.h"
 #include "DumpStream.h"
 #include "matrix.h"
 
@@ -41,12 +42,20 @@ FESurface::FESurface(FEModel* fem) : FEMeshPartition(FE_DOMAIN_SURFACE, fem)
 	m_bitfc = false;
 	m_alpha = 1;
 	m_bshellb = false;
+	m_bvh = nullptr;
 }
 
 //-----------------------------------------------------------------------------
 FESurface::~FESurface()
 {
+	delete m_bvh;
+}
 
+//-----------------------------------------------------------------------------
+FESurfaceBVH* FESurface::GetBVH()
+{
+	if (m_bvh == nullptr) m_bvh = new FESurfaceBVH(this);
+	return m_bvh;
 }
 
 //-----------------------------------------------------------------------------
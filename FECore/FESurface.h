@@ -40,6 +40,7 @@ class FEMesh;
 class FENodeSet;
 class FEFacetSet;
 class FELinearSystem;
+class FESurfaceBVH;
 
 //-----------------------------------------------------------------------------
 class FECORE_API FESurfaceMaterialPoint : public FEMaterialPoint
@@ -243,6 +244,10 @@ public:
 	//! Get the facet set that created this surface
 	FEFacetSet* GetFacetSet() { return m_surf; }
 
+	//! Get the bounding volume hierarchy of the surface's facets. 
+	//! This is allocated on first use, but not updated (see FESurfaceBVH::Update)
+	FESurfaceBVH* GetBVH();
+
 public:
 	// Get nodal reference coordinates 
 	void GetReferenceNodalCoordinates(FESurfaceElement& el, vec3d* r0);
@@ -288,4 +293,5 @@ protected:
     bool                        m_bitfc;    //!< interface status
     double                      m_alpha;    //!< intermediate time fraction
 	bool						m_bshellb;	//!< true if this surface is the bottom of a shell domain
+	FESurfaceBVH*				m_bvh;		//!< bounding volume hierarchy for spatial searches
 };
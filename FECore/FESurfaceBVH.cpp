@@ -0,0 +1,384 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FESurfaceBVH.h"
+#include "FESurface.h"
+#include "FEMesh.h"
+#include <algorithm>
+#include <float.h>
+using namespace std;
+
+// max number of facets in a leaf
+#define BVH_LEAF_SIZE	4
+
+// The tree is rebuilt when refitting has increased its cost by this factor
+#define BVH_REBUILD_FACTOR	2.0
+
+//-----------------------------------------------------------------------------
+// squared distance of a point to a box
+static inline double box_distance2(const vec3d& r0, const vec3d& r1, const vec3d& x)
+{
+	double dx = (x.x < r0.x ? r0.x - x.x : (x.x > r1.x ? x.x - r1.x : 0.0));
+	double dy = (x.y < r0.y ? r0.y - x.y : (x.y > r1.y ? x.y - r1.y : 0.0));
+	double dz = (x.z < r0.z ? r0.z - x.z : (x.z > r1.z ? x.z - r1.z : 0.0));
+	return dx*dx + dy*dy + dz*dz;
+}
+
+//-----------------------------------------------------------------------------
+// squared distance between two boxes
+static inline double box_box_distance2(const vec3d& a0, const vec3d& a1, const vec3d& b0, const vec3d& b1)
+{
+	double dx = (a1.x < b0.x ? b0.x - a1.x : (b1.x < a0.x ? a0.x - b1.x : 0.0));
+	double dy = (a1.y < b0.y ? b0.y - a1.y : (b1.y < a0.y ? a0.y - b1.y : 0.0));
+	double dz = (a1.z < b0.z ? b0.z - a1.z : (b1.z < a0.z ? a0.z - b1.z : 0.0));
+	return dx*dx + dy*dy + dz*dz;
+}
+
+//-----------------------------------------------------------------------------
+// see if two boxes overlap
+static inline bool box_overlap(const vec3d& a0, const vec3d& a1, const vec3d& b0, const vec3d& b1)
+{
+	return ((a0.x <= b1.x) && (b0.x <= a1.x) &&
+			(a0.y <= b1.y) && (b0.y <= a1.y) &&
+			(a0.z <= b1.z) && (b0.z <= a1.z));
+}
+
+//-----------------------------------------------------------------------------
+FESurfaceBVH::FESurfaceBVH(FESurface* ps) : m_ps(ps)
+{
+	m_cost0 = 0.0;
+	m_nbuild = 0;
+	m_nrefit = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Attach(FESurface* ps)
+{
+	m_ps = ps;
+	m_node.clear();
+	m_facet.clear();
+	m_fbox.clear();
+}
+
+//-----------------------------------------------------------------------------
+// calculate the bounding boxes of all facets from the current nodal positions
+void FESurfaceBVH::UpdateFacetBoxes()
+{
+	FESurface& s = *m_ps;
+	int NF = s.Elements();
+	m_fbox.resize(2*NF);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < NF; ++i)
+	{
+		FESurfaceElement& el = s.Element(i);
+		int ne = el.Nodes();
+		vec3d r0 = s.Node(el.m_lnode[0]).m_rt;
+		vec3d r1 = r0;
+		for (int j = 1; j < ne; ++j)
+		{
+			vec3d rj = s.Node(el.m_lnode[j]).m_rt;
+			box_add(r0, r1, rj, rj);
+		}
+		m_fbox[2*i    ] = r0;
+		m_fbox[2*i + 1] = r1;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Build()
+{
+	assert(m_ps);
+	UpdateFacetBoxes();
+
+	int NF = Facets();
+	m_facet.resize(NF);
+	m_fc.resize(NF);
+	for (int i = 0; i < NF; ++i)
+	{
+		m_facet[i] = i;
+		m_fc[i] = (m_fbox[2*i] + m_fbox[2*i + 1])*0.5;
+	}
+
+	// a binary tree with at most BVH_LEAF_SIZE facets per leaf needs fewer than 2*NF nodes
+	m_node.clear();
+	m_node.reserve(2*(NF / BVH_LEAF_SIZE + 1));
+	if (NF > 0) BuildNode(0, NF);
+
+	m_fc.clear();
+	m_cost0 = Cost();
+	m_nbuild++;
+}
+
+//-----------------------------------------------------------------------------
+// Build the node for the facets in [i0, i1). Returns the index of the node.
+int FESurfaceBVH::BuildNode(int i0, int i1)
+{
+	int nid = (int)m_node.size();
+	m_node.push_back(NODE());
+
+	// calculate the box and the bounds of the centroids
+	vec3d r0 = m_fbox[2*m_facet[i0]], r1 = m_fbox[2*m_facet[i0] + 1];
+	vec3d c0 = m_fc[m_facet[i0]], c1 = c0;
+	for (int i = i0 + 1; i < i1; ++i)
+	{
+		int fi = m_facet[i];
+		box_add(r0, r1, m_fbox[2*fi], m_fbox[2*fi + 1]);
+		box_add(c0, c1, m_fc[fi], m_fc[fi]);
+	}
+	m_node[nid].rmin = r0;
+	m_node[nid].rmax = r1;
+
+	if (i1 - i0 <= BVH_LEAF_SIZE)
+	{
+		m_node[nid].right = -1;
+		m_node[nid].first = i0;
+		m_node[nid].count = i1 - i0;
+		return nid;
+	}
+
+	// split at the median along the largest extent of the centroids
+	vec3d dc = c1 - c0;
+	int axis = ((dc.x >= dc.y) && (dc.x >= dc.z) ? 0 : (dc.y >= dc.z ? 1 : 2));
+	const vector<vec3d>& fc = m_fc;
+	int im = (i0 + i1) / 2;
+	nth_element(m_facet.begin() + i0, m_facet.begin() + im, m_facet.begin() + i1, [&fc, axis](int a, int b) {
+		double va = (axis == 0 ? fc[a].x : (axis == 1 ? fc[a].y : fc[a].z));
+		double vb = (axis == 0 ? fc[b].x : (axis == 1 ? fc[b].y : fc[b].z));
+		return (va < vb) || ((va == vb) && (a < b));
+	});
+
+	// the left child is always stored right after its parent
+	BuildNode(i0, im);
+	int right = BuildNode(im, i1);
+
+	m_node[nid].right = right;
+	m_node[nid].first = -1;
+	m_node[nid].count = 0;
+
+	return nid;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Refit()
+{
+	UpdateFacetBoxes();
+
+	// since children are always stored after their parent, we can update
+	// the tree bottom-up in one pass over the nodes in reverse order.
+	for (int n = (int)m_node.size() - 1; n >= 0; --n)
+	{
+		NODE& node = m_node[n];
+		if (node.count > 0)
+		{
+			int fi = m_facet[node.first];
+			vec3d r0 = m_fbox[2*fi], r1 = m_fbox[2*fi + 1];
+			for (int i = 1; i < node.count; ++i)
+			{
+				fi = m_facet[node.first + i];
+				box_add(r0, r1, m_fbox[2*fi], m_fbox[2*fi + 1]);
+			}
+			node.rmin = r0;
+			node.rmax = r1;
+		}
+		else
+		{
+			const NODE& nl = m_node[n + 1];
+			const NODE& nr = m_node[node.right];
+			node.rmin = nl.rmin; node.rmax = nl.rmax;
+			box_add(node.rmin, node.rmax, nr.rmin, nr.rmax);
+		}
+	}
+	m_nrefit++;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Update()
+{
+	if (m_node.empty() || (Facets() != m_ps->Elements())) Build();
+	else
+	{
+		Refit();
+		if (Cost() > BVH_REBUILD_FACTOR*m_cost0) Build();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// The cost of the tree is estimated as the total surface area of the internal nodes,
+// which is proportional to the expected number of nodes visited by a query.
+double FESurfaceBVH::Cost() const
+{
+	double c = 0.0;
+	for (size_t n = 0; n < m_node.size(); ++n)
+	{
+		const NODE& node = m_node[n];
+		if (node.count == 0)
+		{
+			vec3d d = node.rmax - node.rmin;
+			c += d.x*d.y + d.y*d.z + d.z*d.x;
+		}
+	}
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+int FESurfaceBVH::FindClosestNode(const vec3d& x, int nexclude, double rmax) const
+{
+	if (m_node.empty()) return -1;
+
+	FESurface& s = *m_ps;
+	int imin = -1;
+	double dmin = (rmax > 0.0 ? rmax*rmax : DBL_MAX);
+
+	// the depth of the tree is about log2(facets), so this is plenty
+	struct { int n; double d; } stack[128];
+	int ns = 0;
+	stack[ns].n = 0; stack[ns].d = box_distance2(m_node[0].rmin, m_node[0].rmax, x); ns++;
+	while (ns > 0)
+	{
+		--ns;
+		int n = stack[ns].n;
+		if (stack[ns].d > dmin) continue;
+
+		const NODE& node = m_node[n];
+		if (node.count > 0)
+		{
+			for (int i = 0; i < node.count; ++i)
+			{
+				const FESurfaceElement& el = s.Element(m_facet[node.first + i]);
+				int ne = el.Nodes();
+				for (int j = 0; j < ne; ++j)
+				{
+					int lj = el.m_lnode[j];
+					if (el.m_node[j] == nexclude) continue;
+
+					vec3d r = s.Node(lj).m_rt - x;
+					double d = r*r;
+					if ((d < dmin) || ((d == dmin) && ((imin == -1) || (lj < imin))))
+					{
+						dmin = d;
+						imin = lj;
+					}
+				}
+			}
+		}
+		else
+		{
+			int nl = n + 1;
+			int nr = node.right;
+			double dl = box_distance2(m_node[nl].rmin, m_node[nl].rmax, x);
+			double dr = box_distance2(m_node[nr].rmin, m_node[nr].rmax, x);
+
+			// push the farthest child first, so that we visit the nearest one first
+			if (dl <= dr)
+			{
+				if (dr <= dmin) { stack[ns].n = nr; stack[ns].d = dr; ns++; }
+				if (dl <= dmin) { stack[ns].n = nl; stack[ns].d = dl; ns++; }
+			}
+			else
+			{
+				if (dl <= dmin) { stack[ns].n = nl; stack[ns].d = dl; ns++; }
+				if (dr <= dmin) { stack[ns].n = nr; stack[ns].d = dr; ns++; }
+			}
+			assert(ns < 128);
+		}
+	}
+
+	return imin;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::FindFacets(const vec3d& r0, const vec3d& r1, std::vector<int>& facetList) const
+{
+	facetList.clear();
+	if (m_node.empty()) return;
+
+	int stack[128];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		const NODE& node = m_node[stack[--ns]];
+		if (box_overlap(node.rmin, node.rmax, r0, r1) == false) continue;
+
+		if (node.count > 0)
+		{
+			for (int i = 0; i < node.count; ++i)
+			{
+				int fi = m_facet[node.first + i];
+				if (box_overlap(m_fbox[2*fi], m_fbox[2*fi + 1], r0, r1)) facetList.push_back(fi);
+			}
+		}
+		else
+		{
+			int n = (int)(&node - &m_node[0]);
+			stack[ns++] = node.right;
+			stack[ns++] = n + 1;
+			assert(ns < 128);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+double FESurfaceBVH::BoxDistance(const vec3d& r0, const vec3d& r1, double dmax) const
+{
+	if (m_node.empty()) return dmax;
+
+	double dmin = dmax*dmax;
+
+	int stack[128];
+	int ns = 0;
+	stack[ns++] = 0;
+	while ((ns > 0) && (dmin > 0.0))
+	{
+		int n = stack[--ns];
+		const NODE& node = m_node[n];
+		if (box_box_distance2(node.rmin, node.rmax, r0, r1) >= dmin) continue;
+
+		if (node.count > 0)
+		{
+			for (int i = 0; i < node.count; ++i)
+			{
+				int fi = m_facet[node.first + i];
+				double d = box_box_distance2(m_fbox[2*fi], m_fbox[2*fi + 1], r0, r1);
+				if (d < dmin) dmin = d;
+			}
+		}
+		else
+		{
+			stack[ns++] = node.right;
+			stack[ns++] = n + 1;
+			assert(ns < 128);
+		}
+	}
+
+	return sqrt(dmin);
+}
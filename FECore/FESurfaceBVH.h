@@ -0,0 +1,120 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "vec3d.h"
+#include <vector>
+#include "fecore_api.h"
+
+class FESurface;
+
+//-----------------------------------------------------------------------------
+//! grow the box [r0, r1] so that it contains the box [a0, a1]
+inline void box_add(vec3d& r0, vec3d& r1, const vec3d& a0, const vec3d& a1)
+{
+	if (a0.x < r0.x) r0.x = a0.x;
+	if (a0.y < r0.y) r0.y = a0.y;
+	if (a0.z < r0.z) r0.z = a0.z;
+	if (a1.x > r1.x) r1.x = a1.x;
+	if (a1.y > r1.y) r1.y = a1.y;
+	if (a1.z > r1.z) r1.z = a1.z;
+}
+
+//-----------------------------------------------------------------------------
+//! Bounding volume hierarchy (BVH) of axis-aligned boxes over the facets of a surface.
+//! The hierarchy is built once and then refitted to the current nodal positions,
+//! which is much cheaper than rebuilding it. It is only rebuilt when refitting 
+//! has degraded the quality of the tree too much (e.g. after large deformations).
+//! Queries do not modify the tree, so they can be done in parallel.
+class FECORE_API FESurfaceBVH
+{
+	struct NODE
+	{
+		vec3d	rmin, rmax;		//!< bounding box
+		int		right;			//!< index of right child (left child is next node)
+		int		first;			//!< first facet (leaves only)
+		int		count;			//!< number of facets (0 for internal nodes)
+	};
+
+public:
+	FESurfaceBVH(FESurface* ps = nullptr);
+
+	//! attach to a surface
+	void Attach(FESurface* ps);
+
+	//! build the hierarchy from the current nodal positions
+	void Build();
+
+	//! update the bounding boxes for the current nodal positions
+	void Refit();
+
+	//! Refit the hierarchy, or build it if it wasn't built yet or if refitting degraded it
+	void Update();
+
+	//! Find the closest surface node to x. Returns the local node index, or -1 if no node was found.
+	//! The node with global index nexclude is skipped. If rmax > 0 only nodes within that distance are considered.
+	//! If more nodes are at the same distance, the one with the lowest index is returned.
+	int FindClosestNode(const vec3d& x, int nexclude = -1, double rmax = 0.0) const;
+
+	//! Find all facets whose bounding box overlaps the box [r0, r1]
+	void FindFacets(const vec3d& r0, const vec3d& r1, std::vector<int>& facetList) const;
+
+	//! Find the distance between the box [r0, r1] and the closest facet bounding box.
+	//! Since facets lie inside their boxes, this is a lower bound of the distance to the surface.
+	//! The search stops when the distance is known to be at least dmax, in which case dmax is returned.
+	double BoxDistance(const vec3d& r0, const vec3d& r1, double dmax) const;
+
+public:
+	//! number of facets
+	int Facets() const { return (int) m_fbox.size() / 2; }
+
+	//! bounding box of a facet
+	const vec3d& FacetMin(int i) const { return m_fbox[2*i]; }
+	const vec3d& FacetMax(int i) const { return m_fbox[2*i + 1]; }
+
+	//! number of times the hierarchy was built and refitted
+	int Builds() const { return m_nbuild; }
+	int Refits() const { return m_nrefit; }
+
+private:
+	void UpdateFacetBoxes();
+	int BuildNode(int i0, int i1);
+	double Cost() const;
+
+private:
+	FESurface*			m_ps;		//!< the surface
+	std::vector<NODE>	m_node;		//!< tree nodes (depth-first order)
+	std::vector<int>	m_facet;	//!< facet indices, sorted so that each leaf references a range
+	std::vector<vec3d>	m_fbox;		//!< facet bounding boxes (min, max)
+	std::vector<vec3d>	m_fc;		//!< facet centroids (only used during build)
+	double				m_cost0;	//!< cost of the tree when it was built
+	int					m_nbuild;
+	int					m_nrefit;
+};
@@ -325,6 +325,6 @@ void FETimeStepController::Serialize(DumpStream& ar)
 	ar & m_nmust;
 	ar & m_next_must;
 	ar & m_ddt & m_dtp;
-	ar & m_step;
+	if (ar.IsShallow() == false) ar & m_step;
 	ar & m_must_points;
 }
@@ -95,6 +95,8 @@ void LinearSolver::ResetStats()
 {
 	m_stats.backsolves = 0;
 	m_stats.iterations = 0;
+	m_stats.factorizations = 0;
+	m_stats.symbolic_reuse = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -104,6 +106,13 @@ void LinearSolver::UpdateStats(int iterations)
 	m_stats.iterations += iterations;
 }
 
+//-----------------------------------------------------------------------------
+void LinearSolver::UpdateFactorStats(bool symbolicReused)
+{
+	m_stats.factorizations++;
+	if (symbolicReused) m_stats.symbolic_reuse++;
+}
+
 //-----------------------------------------------------------------------------
 void LinearSolver::Destroy()
 {
@@ -40,6 +40,8 @@ struct FECORE_API LinearSolverStats
 {
 	int		backsolves;		// number of times backsolve was called
 	int		iterations;		// total number of iterations
+	int		factorizations;	// number of (numerical) factorizations
+	int		symbolic_reuse;	// number of factorizations that reused a previous symbolic factorization
 };
 
 //-----------------------------------------------------------------------------
@@ -122,6 +124,10 @@ protected:
 	// Should be called after each backsolve. Will increment backsolves by one and add iterations
 	void UpdateStats(int iterations);
 
+	// used by direct solvers to update the factorization stats.
+	// Should be called after each factorization.
+	void UpdateFactorStats(bool symbolicReused);
+
 protected:
 	std::vector<int>	m_part;		//!< partitions of linear system.
 
@@ -0,0 +1,349 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "MCompiledExpression.h"
+#include <map>
+#include <functional>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// evaluate a single instruction
+static inline double apply(int op, double a, double b, FUNCPTR f1, FUNC2PTR f2)
+{
+	switch (op)
+	{
+	case MCompiledExpression::OP_NEG: return -a;
+	case MCompiledExpression::OP_ADD: return a + b;
+	case MCompiledExpression::OP_SUB: return a - b;
+	case MCompiledExpression::OP_MUL: return a * b;
+	case MCompiledExpression::OP_DIV: return a / b;
+	case MCompiledExpression::OP_SQR: return a * a;
+	case MCompiledExpression::OP_POW: return pow(a, b);
+	case MCompiledExpression::OP_F1D: return f1(a);
+	case MCompiledExpression::OP_F2D: return f2(a, b);
+	default:
+		assert(false);
+		return 0.0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Helper class for building the expression graph. Each distinct (sub)expression
+// becomes a single node in the graph, so that common subexpressions are shared.
+// Since a node is only created after its operands, the nodes are in evaluation order.
+class MExpressionGraph
+{
+public:
+	enum { NODE_VAR = -1, NODE_CONST = -2 };
+
+	struct Node
+	{
+		int			op;		// op code, NODE_VAR, or NODE_CONST
+		int			a, b;	// operand nodes (or variable index for NODE_VAR)
+		double		v;		// value of NODE_CONST
+		FUNCPTR		f1;
+		FUNC2PTR	f2;
+
+		bool operator < (const Node& n) const
+		{
+			if (op != n.op) return (op < n.op);
+			if (a != n.a) return (a < n.a);
+			if (b != n.b) return (b < n.b);
+			if (op == NODE_CONST)
+			{
+				// compare the bits, so that this also works for nan
+				unsigned long long u, un;
+				memcpy(&u, &v, sizeof(u));
+				memcpy(&un, &n.v, sizeof(un));
+				return (u < un);
+			}
+			if (f1 != n.f1) return std::less<FUNCPTR>()(f1, n.f1);
+			return std::less<FUNC2PTR>()(f2, n.f2);
+		}
+	};
+
+public:
+	MExpressionGraph(int nvar) : m_nvar(nvar) {}
+
+	// add an expression to the graph and return its node, or -1 if the expression cannot be compiled.
+	int Add(const MItem* pi);
+
+	bool IsConst(int n) const { return (m_node[n].op == NODE_CONST); }
+
+public:
+	std::vector<Node>	m_node;
+
+private:
+	int AddNode(int op, int a, int b, double v = 0.0, FUNCPTR f1 = 0, FUNC2PTR f2 = 0);
+	int Constant(double v) { return AddNode(NODE_CONST, -1, -1, v); }
+	int Operation(int op, int a, int b, FUNCPTR f1 = 0, FUNC2PTR f2 = 0);
+
+private:
+	int						m_nvar;
+	std::map<Node, int>		m_map;
+};
+
+//-----------------------------------------------------------------------------
+int MExpressionGraph::AddNode(int op, int a, int b, double v, FUNCPTR f1, FUNC2PTR f2)
+{
+	Node n;
+	n.op = op; n.a = a; n.b = b; n.v = v; n.f1 = f1; n.f2 = f2;
+
+	// see if we already have this node
+	std::map<Node, int>::iterator it = m_map.find(n);
+	if (it != m_map.end()) return it->second;
+
+	int id = (int)m_node.size();
+	m_node.push_back(n);
+	m_map[n] = id;
+	return id;
+}
+
+//-----------------------------------------------------------------------------
+int MExpressionGraph::Operation(int op, int a, int b, FUNCPTR f1, FUNC2PTR f2)
+{
+	// evaluate constant expressions
+	if (IsConst(a) && ((b < 0) || IsConst(b)))
+	{
+		double vb = (b >= 0 ? m_node[b].v : 0.0);
+		return Constant(apply(op, m_node[a].v, vb, f1, f2));
+	}
+
+	// order the operands of commutative operations so that a+b and b+a are the same node
+	if (((op == MCompiledExpression::OP_ADD) || (op == MCompiledExpression::OP_MUL)) && (b < a))
+	{
+		int t = a; a = b; b = t;
+	}
+
+	return AddNode(op, a, b, 0.0, f1, f2);
+}
+
+//-----------------------------------------------------------------------------
+int MExpressionGraph::Add(const MItem* pi)
+{
+	if (pi == 0) return -1;
+
+	switch (pi->Type())
+	{
+	case MCONST:
+	case MFRAC :
+	case MNAMED:
+		return Constant(mnumber(pi)->value());
+	case MVAR:
+		{
+			int n = mvar(pi)->index();
+			if ((n < 0) || (n >= m_nvar)) return -1;
+			return AddNode(NODE_VAR, n, -1);
+		}
+	case MNEG:
+		{
+			int a = Add(munary(pi)->Item()); if (a < 0) return -1;
+			return Operation(MCompiledExpression::OP_NEG, a, -1);
+		}
+	case MADD:
+	case MSUB:
+	case MMUL:
+	case MDIV:
+	case MPOW:
+		{
+			int a = Add(mbinary(pi)->LeftItem() ); if (a < 0) return -1;
+			int b = Add(mbinary(pi)->RightItem()); if (b < 0) return -1;
+			switch (pi->Type())
+			{
+			case MADD: return Operation(MCompiledExpression::OP_ADD, a, b);
+			case MSUB: return Operation(MCompiledExpression::OP_SUB, a, b);
+			case MMUL: return Operation(MCompiledExpression::OP_MUL, a, b);
+			case MDIV: return Operation(MCompiledExpression::OP_DIV, a, b);
+			default:
+				if (IsConst(b) && (m_node[b].v == 2.0)) return Operation(MCompiledExpression::OP_SQR, a, -1);
+				return Operation(MCompiledExpression::OP_POW, a, b);
+			}
+		}
+	case MF1D:
+		{
+			int a = Add(munary(pi)->Item()); if (a < 0) return -1;
+			return Operation(MCompiledExpression::OP_F1D, a, -1, mfnc1d(pi)->funcptr(), 0);
+		}
+	case MF2D:
+		{
+			int a = Add(mbinary(pi)->LeftItem() ); if (a < 0) return -1;
+			int b = Add(mbinary(pi)->RightItem()); if (b < 0) return -1;
+			return Operation(MCompiledExpression::OP_F2D, a, b, 0, mfnc2d(pi)->funcptr());
+		}
+	case MSFNC:
+		return Add(msfncnd(pi)->Value());
+	default:
+		return -1;
+	}
+}
+
+//=============================================================================
+// MCompiledExpression
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+MCompiledExpression::MCompiledExpression()
+{
+	m_nvar = 0;
+	m_nreg = 0;
+}
+
+//-----------------------------------------------------------------------------
+void MCompiledExpression::Clear()
+{
+	m_nvar = 0;
+	m_nreg = 0;
+	m_bound.clear();
+	m_const.clear();
+	m_code.clear();
+	m_out.clear();
+}
+
+//-----------------------------------------------------------------------------
+void MCompiledExpression::BindVariable(int n, const double* pv)
+{
+	assert((n >= 0) && (n < m_nvar));
+	m_bound[n] = pv;
+}
+
+//-----------------------------------------------------------------------------
+bool MCompiledExpression::Compile(const std::vector<const MSimpleExpression*>& expr)
+{
+	Clear();
+	if (expr.empty()) return false;
+
+	// build the expression graph
+	int nvar = expr[0]->Variables();
+	MExpressionGraph G(nvar);
+	std::vector<int> out;
+	for (size_t i = 0; i < expr.size(); ++i)
+	{
+		if (expr[i]->Variables() != nvar) return false;
+		int n = G.Add(expr[i]->GetExpression().ItemPtr());
+		if (n < 0) return false;
+		out.push_back(n);
+	}
+
+	// find the last use of each node. Outputs are used until the end.
+	const std::vector<MExpressionGraph::Node>& node = G.m_node;
+	const int N = (int)node.size();
+	std::vector<int> lastUse(N, -1);
+	for (size_t i = 0; i < out.size(); ++i) lastUse[out[i]] = N;
+	for (int i = N - 1; i >= 0; --i)
+	{
+		const MExpressionGraph::Node& ni = node[i];
+		if ((lastUse[i] < 0) || (ni.op < 0)) continue;
+		if (lastUse[ni.a] < i) lastUse[ni.a] = i;
+		if ((ni.b >= 0) && (lastUse[ni.b] < i)) lastUse[ni.b] = i;
+	}
+
+	// the variables and constants are stored at the start of the registers
+	std::vector<int> reg(N, -1);
+	for (int i = 0; i < N; ++i)
+	{
+		if ((lastUse[i] < 0) || (node[i].op != MExpressionGraph::NODE_CONST)) continue;
+		reg[i] = nvar + (int)m_const.size();
+		m_const.push_back(node[i].v);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		if (node[i].op == MExpressionGraph::NODE_VAR) reg[i] = node[i].a;
+	}
+	const int nfixed = nvar + (int)m_const.size();
+
+	// Assign registers to intermediate results. A register is reused once the
+	// value it holds is no longer needed. 
+	std::vector<int> freeReg;
+	int ntemp = 0;
+	for (int i = 0; i < N; ++i)
+	{
+		const MExpressionGraph::Node& ni = node[i];
+		if ((lastUse[i] < 0) || (ni.op < 0)) continue;
+
+		// release the operands that are no longer needed
+		if ((reg[ni.a] >= nfixed) && (lastUse[ni.a] == i)) freeReg.push_back(reg[ni.a]);
+		if ((ni.b >= 0) && (ni.b != ni.a) && (reg[ni.b] >= nfixed) && (lastUse[ni.b] == i)) freeReg.push_back(reg[ni.b]);
+
+		// assign the result register
+		if (freeReg.empty()) reg[i] = nfixed + ntemp++;
+		else { reg[i] = freeReg.back(); freeReg.pop_back(); }
+
+		Instruction c;
+		c.op = ni.op;
+		c.r = reg[i];
+		c.a = reg[ni.a];
+		c.b = (ni.b >= 0 ? reg[ni.b] : 0);
+		c.f1 = ni.f1;
+		c.f2 = ni.f2;
+		m_code.push_back(c);
+	}
+
+	m_nvar = nvar;
+	m_nreg = nfixed + ntemp;
+	m_bound.assign(nvar, (const double*)0);
+	for (size_t i = 0; i < out.size(); ++i) m_out.push_back(reg[out[i]]);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void MCompiledExpression::value(const double* var, double* out) const
+{
+	if (m_nreg <= MAX_STACK_REGISTERS)
+	{
+		double reg[MAX_STACK_REGISTERS];
+		value(var, out, reg);
+	}
+	else
+	{
+		std::vector<double> reg(m_nreg);
+		value(var, out, &reg[0]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void MCompiledExpression::value(const double* var, double* out, double* reg) const
+{
+	// load the variables and constants
+	int k = 0;
+	for (int i = 0; i < m_nvar; ++i) reg[i] = (m_bound[i] ? *m_bound[i] : var[k++]);
+	const int nc = (int)m_const.size();
+	for (int i = 0; i < nc; ++i) reg[m_nvar + i] = m_const[i];
+
+	// run the program
+	const int ncode = (int)m_code.size();
+	for (int i = 0; i < ncode; ++i)
+	{
+		const Instruction& c = m_code[i];
+		reg[c.r] = apply(c.op, reg[c.a], reg[c.b], c.f1, c.f2);
+	}
+
+	// copy the results
+	const int nout = (int)m_out.size();
+	for (int i = 0; i < nout; ++i) out[i] = reg[m_out[i]];
+}
@@ -0,0 +1,111 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "MathObject.h"
+#include <vector>
+#include "fecore_api.h"
+
+//-----------------------------------------------------------------------------
+// This class compiles one or more simple expressions into a flat program that
+// operates on an array of registers. The expressions are compiled together, so
+// that subexpressions that appear in more than one expression (e.g. in the
+// derivatives of a strain energy function) are only evaluated once. Constant
+// subexpressions are evaluated when the program is compiled.
+// All expressions must be defined in terms of the same variables (i.e. the same 
+// variable names in the same order). Variables can be bound to an external value
+// (e.g. a material parameter), which is then read when the program is evaluated.
+class FECORE_API MCompiledExpression
+{
+public:
+	// programs that need no more than this number of registers are evaluated
+	// without allocating memory.
+	enum { MAX_STACK_REGISTERS = 256 };
+
+	enum OpCode {
+		OP_NEG,
+		OP_ADD,
+		OP_SUB,
+		OP_MUL,
+		OP_DIV,
+		OP_SQR,
+		OP_POW,
+		OP_F1D,
+		OP_F2D
+	};
+
+	struct Instruction
+	{
+		int			op;		// op code
+		int			r;		// result register
+		int			a, b;	// operand registers
+		FUNCPTR		f1;		// function for OP_F1D
+		FUNC2PTR	f2;		// function for OP_F2D
+	};
+
+public:
+	MCompiledExpression();
+
+	// compile the expressions. Returns false if an expression contains items that
+	// cannot be evaluated (e.g. matrices or equations).
+	bool Compile(const std::vector<const MSimpleExpression*>& expr);
+
+	// clear the program
+	void Clear();
+
+	// bind a variable to an external value
+	void BindVariable(int n, const double* pv);
+
+	// number of variables
+	int Variables() const { return m_nvar; }
+
+	// number of compiled expressions
+	int Outputs() const { return (int)m_out.size(); }
+
+	// number of registers needed to evaluate the program
+	int Registers() const { return m_nreg; }
+
+	// number of instructions
+	int Instructions() const { return (int)m_code.size(); }
+
+	// Evaluate all expressions. The var array contains the values of the variables
+	// that are not bound (in order), and out must have room for Outputs() values.
+	// This function is thread safe.
+	void value(const double* var, double* out) const;
+
+	// Same as above, but the registers are provided by the caller.
+	void value(const double* var, double* out, double* reg) const;
+
+private:
+	int		m_nvar;		// number of variables
+	int		m_nreg;		// number of registers
+
+	std::vector<const double*>	m_bound;	// bound variables
+	std::vector<double>			m_const;	// constants (stored after the variables in the registers)
+	std::vector<Instruction>	m_code;		// the program
+	std::vector<int>			m_out;		// registers of the outputs
+};
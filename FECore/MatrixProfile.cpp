@@ -152,6 +152,22 @@ void SparseMatrixProfile::ColumnProfile::insertRow(int row)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// find the row via bisection of the (ordered) row entries
+bool SparseMatrixProfile::ColumnProfile::hasRow(int row) const
+{
+	int N0 = 0, N1 = size() - 1;
+	while (N0 <= N1)
+	{
+		int n = (N0 + N1) / 2;
+		const RowEntry& rn = m_data[n];
+		if (row < rn.start) N1 = n - 1;
+		else if (row > rn.end) N0 = n + 1;
+		else return true;
+	}
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 //! MatrixProfile constructor. Takes the nr of equations as input argument.
 //! If n is larger than zero a default profile is constructor for a diagonal
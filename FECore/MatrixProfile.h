@@ -85,6 +85,9 @@ public:
 		// add row index to column profile
 		void insertRow(int row);
 
+		// see if the row index is in the column profile
+		bool hasRow(int row) const;
+
 	private:
 		vector<RowEntry>	m_data;	// the column profile data
 	};
@@ -114,6 +117,9 @@ public:
 	//! inserts an entry into the profile (This is an expensive operation!)
 	void Insert(int i, int j);
 
+	//! see if the entry (i,j) is in the profile
+	bool HasEntry(int i, int j) const { return m_prof[j].hasRow(i); }
+
 	//! returns the number of rows
 	int Rows() const { return m_nrow; }
 
@@ -35,6 +35,7 @@ SparseMatrix::SparseMatrix()
 {
 	m_nrow = m_ncol = 0;
 	m_nsize = 0;
+	m_batomic = true;
 }
 
 SparseMatrix::~SparseMatrix()
@@ -47,6 +48,33 @@ void SparseMatrix::Clear()
 	m_nsize = 0;
 }
 
+//! Assemble an element matrix using a scatter map. This is a straight scatter-add 
+//! since the locations in the values array were already found by ScatterMap.
+void SparseMatrix::ScatterAdd(const matrix& ke, const std::vector<int>& map)
+{
+	double* pv = Values();
+	const int N = ke.rows();
+	const int M = ke.columns();
+	assert((int)map.size() == N*M);
+	const int* pm = &map[0];
+	for (int i = 0; i < N; ++i)
+	{
+		for (int j = 0; j < M; ++j, ++pm)
+		{
+			int n = *pm;
+			if (n >= 0)
+			{
+				if (m_batomic)
+				{
+#pragma omp atomic
+					pv[n] += ke[i][j];
+				}
+				else pv[n] += ke[i][j];
+			}
+		}
+	}
+}
+
 //! scale matrix
 void SparseMatrix::scale(const vector<double>& L, const vector<double>& R)
 {
@@ -95,6 +95,23 @@ public: // functions to be overwritten in derived classes
 	//! scale matrix
 	virtual void scale(const vector<double>& L, const vector<double>& R);
 
+public:
+	//! Turn atomic updates in the assembly routines on or off.
+	//! Atomics may only be turned off when the caller guarantees that no two threads
+	//! write to the same matrix entry (e.g. during a colored element assembly).
+	void SetAtomicAssembly(bool b) { m_batomic = b; }
+
+	//! see if atomic updates are used during assembly
+	bool AtomicAssembly() const { return m_batomic; }
+
+	//! Find for each entry of an element matrix (with nr rows and nc columns) the location in the values array.
+	//! Entries that do not contribute to the matrix are set to -1. The map is stored row by row.
+	//! Returns false (and leaves map empty) if the matrix format does not support this.
+	virtual bool ScatterMap(const std::vector<int>& lmi, const std::vector<int>& lmj, int nr, int nc, std::vector<int>& map) { return false; }
+
+	//! Assemble an element matrix using a scatter map (see ScatterMap)
+	void ScatterAdd(const matrix& ke, const std::vector<int>& map);
+
 public:
 	//! multiply with vector
 	bool mult_vector(double* x, double* r) override { assert(false); return false; }
@@ -111,4 +128,5 @@ protected:
 	// NOTE: These values are set by derived classes
 	int	m_nrow, m_ncol;		//!< dimension of matrix
 	int	m_nsize;			//!< number of nonzeroes (i.e. matrix elements actually allocated)
+	bool	m_batomic;		//!< use atomic updates during assembly
 };
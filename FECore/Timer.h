@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "fecore_api.h"
 #include "FECoreKernel.h"
+#include "FEProfiler.h"
 #include <vector>
 #include <string>
 
@@ -94,4 +95,4 @@ private:
 	Timer*	m_timer;
 };
 
-#define TRACK_TIME(timerId) TimerTracker _trackTimer(GetFEModel()->GetTimer(timerId));
+#define TRACK_TIME(timerId) TimerTracker _trackTimer(GetFEModel()->GetTimer(timerId)); FEProfileScope _profileTimer(FEModel::GetTimerName(timerId));
@@ -49,6 +49,7 @@ SOFTWARE.*/
 #include "mkl_rci.h"
 #include "mkl_blas.h"
 #include "mkl_spblas.h"
+#endif // MKL_ISS
 
 // in SchurSolver.cpp
 bool BuildDiagonalMassMatrix(FEModel* fem, BlockMatrix* K, CompactSymmMatrix* M, double scale);
@@ -262,7 +263,8 @@ bool BIPNSolver::PreProcess()
 	default:
 		return false;
 	}
-		
+	if (PC) m_Asolver->SetLeftPreconditioner(PC);
+
 	m_Asolver->SetMaxIterations(m_gmres_maxiter);
 	m_Asolver->SetRelativeResidualTolerance(m_gmres_tol);
 	if (m_Asolver->SetSparseMatrix(A.Block(0, 0).pA) == false) return false;
@@ -313,10 +315,8 @@ bool BIPNSolver::Factor()
 {
 	// make sure we have a matrix
 	if (m_A == 0) return false;
-	BlockMatrix& A = *m_A;
 
 	// get the number of equations
-	int N = A.Rows();
 	int Nu = m_part[0];
 	int Np = m_part[1];
 
@@ -381,7 +381,6 @@ bool BIPNSolver::BackSolve(double* x, double* b)
 {
 	// make sure we have a matrix
 	if (m_A == 0) return false;
-	BlockMatrix& A = *m_A;
 
 	BlockMatrix::BLOCK& K = m_A->Block(0, 0);
 	BlockMatrix::BLOCK& G = m_A->Block(0, 1);
@@ -389,7 +388,6 @@ bool BIPNSolver::BackSolve(double* x, double* b)
 	BlockMatrix::BLOCK& L = m_A->Block(1, 1);
 
 	// number of equations
-	int N = A.Rows();
 	int Nu = m_part[0];
 	int Np = m_part[1];
 
@@ -591,20 +589,3 @@ int BIPNSolver::gmressolve(SparseMatrix* K, LinearSolver* PC, vector<double>& x,
 
 	return gmres.GetStats().iterations;
 }
-
-#else	// ifdef MKL_ISS
-
-BIPNSolver::BIPNSolver() : LinearSolver(fem), m_A(0) {}
-bool BIPNSolver::PreProcess() { return false; }
-bool BIPNSolver::Factor() { return false; }
-bool BIPNSolver::BackSolve(double* x, double* b) { return false; }
-SparseMatrix* BIPNSolver::CreateSparseMatrix(Matrix_Type ntype) { return 0; }
-void BIPNSolver::SetPrintLevel(int n) {}
-void BIPNSolver::SetMaxIterations(int n) {}
-void BIPNSolver::SetPartition(int n) {}
-void BIPNSolver::SetTolerance(double eps) {}
-void BIPNSolver::UseConjugateGradient(bool b) {}
-void BIPNSolver::SetCGParameters(int maxiter, double tolerance, bool doResidualStoppingTest) {}
-void BIPNSolver::SetGMRESParameters(int maxiter, double tolerance, bool doResidualStoppingTest, bool precondition) {}
-
-#endif
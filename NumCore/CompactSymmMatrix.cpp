@@ -28,67 +28,189 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "CompactSymmMatrix.h"
+#include <FECore/sys.h>
+#include <algorithm>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 //-----------------------------------------------------------------------------
 //! constructor
 CompactSymmMatrix::CompactSymmMatrix(int offset) : CompactMatrix(offset) 
 {
-	
+	m_mvPointers = nullptr;
+	m_mvNNZ = 0;
+	m_mvThreads = 0;
 }
 
 //-----------------------------------------------------------------------------
-bool CompactSymmMatrix::mult_vector(double* x, double* r)
+// Calculates the dot product of a (sparse) column with the vector x. This is the 
+// contribution of the upper triangular part to the matrix-vector product. 
+static inline double column_dot(const double* pv, const int* pi, int n, const double* x, int offset)
 {
-	// get row count
-	int N = Rows();
-	int M = Columns();
+	double s = 0.0;
+	int i = 0;
+#if defined(__AVX512F__)
+	__m512d acc = _mm512_setzero_pd();
+	__m256i off8 = _mm256_set1_epi32(offset);
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256i idx = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)(pi + i)), off8);
+		__m512d xv = _mm512_i32gather_pd(idx, x, 8);
+		acc = _mm512_fmadd_pd(_mm512_loadu_pd(pv + i), xv, acc);
+	}
+	s = _mm512_reduce_add_pd(acc);
+#elif defined(__AVX2__)
+	__m256d acc = _mm256_setzero_pd();
+	__m128i off4 = _mm_set1_epi32(offset);
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128i idx = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(pi + i)), off4);
+		__m256d xv = _mm256_i32gather_pd(x, idx, 8);
+		acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(pv + i), xv));
+	}
+	__m128d h = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+	s = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+#else
+	double s1 = 0.0, s2 = 0.0, s3 = 0.0;
+	for (; i + 4 <= n; i += 4)
+	{
+		s  += pv[i    ] * x[pi[i    ] - offset];
+		s1 += pv[i + 1] * x[pi[i + 1] - offset];
+		s2 += pv[i + 2] * x[pi[i + 2] - offset];
+		s3 += pv[i + 3] * x[pi[i + 3] - offset];
+	}
+	s += (s1 + s2) + s3;
+#endif
+	for (; i < n; ++i) s += pv[i] * x[pi[i] - offset];
+	return s;
+}
 
-	// zero result vector
-	for (int j = 0; j<N; ++j) r[j] = 0.0;
+//-----------------------------------------------------------------------------
+// Adds a (sparse) column times the scalar a to r, where r[k] corresponds to row k + row0.
+// This is the contribution of the lower triangular part. The row indices in a column are 
+// unique, so there are no conflicts between the updates.
+static inline void column_axpy(const double* pv, const int* pi, int n, double a, double* r, int row0)
+{
+	int i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		r[pi[i    ] - row0] += pv[i    ] * a;
+		r[pi[i + 1] - row0] += pv[i + 1] * a;
+		r[pi[i + 2] - row0] += pv[i + 2] * a;
+		r[pi[i + 3] - row0] += pv[i + 3] * a;
+	}
+	for (; i < n; ++i) r[pi[i] - row0] += pv[i] * a;
+}
 
-	// loop over all columns
-	for (int j = 0; j<M; ++j)
+//-----------------------------------------------------------------------------
+void CompactSymmMatrix::UpdateMultPartition(int nthreads)
+{
+	int N = Columns();
+	int nnz = NonZeroes();
+	m_mvThreads = nthreads;
+
+	// for small matrices, the threading overhead isn't worth it
+	if (nnz < 20000) nthreads = 1;
+	if (nthreads > N) nthreads = (N > 0 ? N : 1);
+
+	// split the columns in blocks with roughly equal number of nonzeroes
+	m_mvCol.assign(nthreads + 1, N);
+	m_mvCol[0] = 0;
+	int b = 1;
+	for (int j = 0; (j < N) && (b < nthreads); ++j)
 	{
-		double* pv = m_pd + m_ppointers[j] - m_offset;
-		int* pi = m_pindices + m_ppointers[j] - m_offset;
-		int n = m_ppointers[j + 1] - m_ppointers[j];
+		double f = (double)(m_ppointers[j] - m_offset) / (double)nnz;
+		if (f*nthreads >= b) m_mvCol[b++] = j;
+	}
 
-		// add off-diagonal elements
-		for (int i = 1; i<n - 7; i += 8)
+	// find the rows below each block that the block contributes to
+	m_mvRowMax.assign(nthreads, 0);
+	m_mvBuf0.assign(nthreads + 1, 0);
+	for (int t = 0; t < nthreads; ++t)
+	{
+		int c0 = m_mvCol[t], c1 = m_mvCol[t + 1];
+		int rmax = c1 - 1;
+		for (int j = c0; j < c1; ++j)
 		{
-			// add lower triangular element
-			r[pi[i    ] - m_offset] += pv[i    ] * x[j];
-			r[pi[i + 1] - m_offset] += pv[i + 1] * x[j];
-			r[pi[i + 2] - m_offset] += pv[i + 2] * x[j];
-			r[pi[i + 3] - m_offset] += pv[i + 3] * x[j];
-			r[pi[i + 4] - m_offset] += pv[i + 4] * x[j];
-			r[pi[i + 5] - m_offset] += pv[i + 5] * x[j];
-			r[pi[i + 6] - m_offset] += pv[i + 6] * x[j];
-			r[pi[i + 7] - m_offset] += pv[i + 7] * x[j];
+			int n = m_ppointers[j + 1] - m_ppointers[j];
+			if (n > 0)
+			{
+				int rj = m_pindices[m_ppointers[j + 1] - m_offset - 1] - m_offset;
+				if (rj > rmax) rmax = rj;
+			}
 		}
-		for (int i = 0; i<(n - 1) % 8; ++i)
-			r[pi[n - 1 - i] - m_offset] += pv[n - 1 - i] * x[j];
+		m_mvRowMax[t] = rmax;
+		m_mvBuf0[t + 1] = m_mvBuf0[t] + (rmax - c1 + 1);
+	}
+	m_mvBuf.assign(m_mvBuf0[nthreads], 0.0);
+
+	m_mvPointers = m_ppointers;
+	m_mvNNZ = nnz;
+}
+
+//-----------------------------------------------------------------------------
+bool CompactSymmMatrix::mult_vector(double* x, double* r)
+{
+	// get row count
+	int N = Rows();
 
-		// add diagonal element
-		double rj = pv[0] * x[j];
+	// make sure the partition is up to date
+	int nthreads = omp_get_max_threads();
+	if (m_mvCol.empty() || (m_mvPointers != m_ppointers) || (m_mvNNZ != NonZeroes()) || (m_mvThreads != nthreads) || (m_mvCol.back() != N))
+	{
+		UpdateMultPartition(nthreads);
+	}
+	int nblocks = (int)m_mvCol.size() - 1;
 
-		// add upper-triangular elements
-		for (int i = 1; i<n - 7; i += 8)
+	const int offset = m_offset;
+
+#pragma omp parallel num_threads(nblocks) if(nblocks > 1)
+	{
+#pragma omp for schedule(static, 1)
+		for (int t = 0; t < nblocks; ++t)
 		{
-			// add upper triangular element
-			rj += pv[i    ] * x[pi[i    ] - m_offset];
-			rj += pv[i + 1] * x[pi[i + 1] - m_offset];
-			rj += pv[i + 2] * x[pi[i + 2] - m_offset];
-			rj += pv[i + 3] * x[pi[i + 3] - m_offset];
-			rj += pv[i + 4] * x[pi[i + 4] - m_offset];
-			rj += pv[i + 5] * x[pi[i + 5] - m_offset];
-			rj += pv[i + 6] * x[pi[i + 6] - m_offset];
-			rj += pv[i + 7] * x[pi[i + 7] - m_offset];
+			int c0 = m_mvCol[t], c1 = m_mvCol[t + 1];
+			double* buf = m_mvBuf.data() + m_mvBuf0[t];
+
+			// zero this block's part of the result and its buffer
+			for (int j = c0; j < c1; ++j) r[j] = 0.0;
+			for (int k = m_mvBuf0[t]; k < m_mvBuf0[t + 1]; ++k) m_mvBuf[k] = 0.0;
+
+			for (int j = c0; j < c1; ++j)
+			{
+				const double* pv = m_pd + m_ppointers[j] - offset;
+				const int* pi = m_pindices + m_ppointers[j] - offset;
+				int n = m_ppointers[j + 1] - m_ppointers[j];
+				if (n == 0) continue;
+
+				double xj = x[j];
+
+				// diagonal and upper-triangular elements
+				r[j] += pv[0] * xj + column_dot(pv + 1, pi + 1, n - 1, x, offset);
+
+				// lower-triangular elements: the rows are sorted, so the rows in this block come first
+				int m = n;
+				if (pi[n - 1] - offset >= c1) m = (int)(std::lower_bound(pi + 1, pi + n, c1 + offset) - pi);
+				column_axpy(pv + 1, pi + 1, m - 1, xj, r, offset);
+				column_axpy(pv + m, pi + m, n - m, xj, buf, offset + c1);
+			}
 		}
-		for (int i = 0; i<(n - 1) % 8; ++i)
-			rj += pv[n - 1 - i] * x[pi[n - 1 - i] - m_offset];
 
-		r[j] += rj;
+		// add the contributions of the preceding blocks to each block's rows
+#pragma omp for schedule(static, 1)
+		for (int t = 1; t < nblocks; ++t)
+		{
+			int c0 = m_mvCol[t], c1 = m_mvCol[t + 1];
+			for (int s = 0; s < t; ++s)
+			{
+				int s1 = m_mvCol[s + 1];
+				int i0 = (c0 > s1 ? c0 : s1);
+				int i1 = (c1 - 1 < m_mvRowMax[s] ? c1 - 1 : m_mvRowMax[s]);
+				const double* bs = m_mvBuf.data() + m_mvBuf0[s];
+				for (int i = i0; i <= i1; ++i) r[i] += bs[i - s1];
+			}
+		}
 	}
 
 	return true;
@@ -97,6 +219,9 @@ bool CompactSymmMatrix::mult_vector(double* x, double* r)
 //-----------------------------------------------------------------------------
 void CompactSymmMatrix::Create(SparseMatrixProfile& mp)
 {
+	// the partition for the matrix-vector product must be recalculated
+	m_mvPointers = nullptr;
+
 	// TODO: we should probably enforce that the matrix is square
 	int nr = mp.Rows();
 	int nc = mp.Columns();
@@ -220,8 +345,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
-					#pragma omp atomic
-					pm[n] += ke[i][j];
+					if (m_batomic)
+					{
+						#pragma omp atomic
+						pm[n] += ke[i][j];
+					}
+					else pm[n] += ke[i][j];
 					break;
 				}
 		}
@@ -256,8 +385,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 				for (int n = 0; n<l; ++n) 
 					if (pi[n] - m_offset == I)
 					{
-						#pragma omp atomic
-						pv[n] += ke[i][j];
+						if (m_batomic)
+						{
+							#pragma omp atomic
+							pv[n] += ke[i][j];
+						}
+						else pv[n] += ke[i][j];
 						break;
 					}
 			}
@@ -265,6 +398,43 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Find the location in the values array of each entry of an element matrix.
+//! Only the lower-triangular entries are stored, so all other entries are set to -1.
+bool CompactSymmMatrix::ScatterMap(const vector<int>& lmi, const vector<int>& lmj, int nr, int nc, vector<int>& map)
+{
+	map.assign(nr*nc, -1);
+	for (int i = 0; i<nr; ++i)
+	{
+		int I = lmi[i];
+		for (int j = 0; j<nc; ++j)
+		{
+			int J = lmj[j];
+			if ((I >= J) && (J >= 0))
+			{
+				// do a binary search for the row index (row indices are ordered)
+				int* pi = m_pindices + (m_ppointers[J] - m_offset);
+				int n0 = 0;
+				int n1 = m_ppointers[J + 1] - m_ppointers[J] - 1;
+				while (n0 <= n1)
+				{
+					int n = (n0 + n1) >> 1;
+					int m = pi[n] - m_offset;
+					if (m == I)
+					{
+						map[i*nc + j] = m_ppointers[J] - m_offset + n;
+						break;
+					}
+					else if (m < I) n0 = n + 1;
+					else n1 = n - 1;
+				}
+				assert(map[i*nc + j] >= 0);
+			}
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! add a matrix item
 void CompactSymmMatrix::add(int i, int j, double v)
@@ -288,8 +458,12 @@ void CompactSymmMatrix::add(int i, int j, double v)
 			int m = pi[n];
 			if (m == i)
 			{
-				#pragma omp atomic
-				pd[n] += v;
+				if (m_batomic)
+				{
+					#pragma omp atomic
+					pd[n] += v;
+				}
+				else pd[n] += v;
 				return;
 			}
 			else if (m < i)
@@ -50,6 +50,9 @@ public:
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const vector<int>& lmi, const vector<int>& lmj) override;
 
+	//! find the locations of the element matrix entries in the values array
+	bool ScatterMap(const vector<int>& lmi, const vector<int>& lmj, int nr, int nc, vector<int>& map) override;
+
 	//! add a matrix item
 	void add(int i, int j, double v) override;
 
@@ -85,4 +88,19 @@ public:
 
 	//! do row (L) and column (R) scaling
 	void scale(const vector<double>& L, const vector<double>& R) override;
+
+private:
+	// partition the columns for the parallel matrix-vector product
+	void UpdateMultPartition(int nthreads);
+
+private:
+	// Data for the parallel matrix-vector product. Each thread processes a block of
+	// columns and stores the contributions to rows below its block in a buffer.
+	vector<int>		m_mvCol;		//!< first column of each block
+	vector<int>		m_mvRowMax;		//!< last row that each block contributes to
+	vector<int>		m_mvBuf0;		//!< offset of each block's buffer
+	vector<double>	m_mvBuf;		//!< buffers for contributions to rows outside the blocks
+	int*			m_mvPointers;	//!< pointers the partition was created for
+	int				m_mvNNZ;		//!< nr of nonzeroes the partition was created for
+	int				m_mvThreads;	//!< nr of threads the partition was created for
 };
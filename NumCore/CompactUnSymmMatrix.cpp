@@ -233,8 +233,12 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == J)
 				{
+					if (m_batomic)
+					{
 #pragma omp atomic
-					pm[n] += kij;
+						pm[n] += kij;
+					}
+					else pm[n] += kij;
 					break;
 				}
 		}
@@ -261,6 +265,46 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const v
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Find the location in the values array of each entry of an element matrix.
+//! Entries with a negative row or column index are set to -1.
+bool CRSSparseMatrix::ScatterMap(const vector<int>& lmi, const vector<int>& lmj, int nr, int nc, vector<int>& map)
+{
+	map.assign(nr*nc, -1);
+	for (int i = 0; i<nr; ++i)
+	{
+		int I = lmi[i];
+		if (I < 0) continue;
+
+		int* pi = m_pindices + (m_ppointers[I] - m_offset);
+		int l = m_ppointers[I + 1] - m_ppointers[I];
+		for (int j = 0; j<nc; ++j)
+		{
+			int J = lmj[j];
+			if (J >= 0)
+			{
+				// do a binary search for the column index (column indices are ordered)
+				int n0 = 0;
+				int n1 = l - 1;
+				while (n0 <= n1)
+				{
+					int n = (n0 + n1) >> 1;
+					int m = pi[n] - m_offset;
+					if (m == J)
+					{
+						map[i*nc + j] = m_ppointers[I] - m_offset + n;
+						break;
+					}
+					else if (m < J) n0 = n + 1;
+					else n1 = n - 1;
+				}
+				assert(map[i*nc + j] >= 0);
+			}
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 // This algorithm uses a binary search for locating the correct row index
 // This assumes that the indices are ordered!
@@ -280,8 +324,12 @@ void CRSSparseMatrix::add(int i, int j, double v)
 		int m = pi[n];
 		if (m == j)
 		{
+			if (m_batomic)
+			{
 #pragma omp atomic
-			pd[n] += v;
+				pd[n] += v;
+			}
+			else pd[n] += v;
 			return;
 		}
 		else if (m < j)
@@ -362,27 +410,28 @@ bool CRSSparseMatrix::mult_vector(double* x, double* r)
 	// get the matrix size
 	const int N = Rows();
 
+#ifdef MKL_ISS
 	if (Offset() == 1)
 	{
 		const char transa = 'N';
 		mkl_dcsrgemv(&transa, &N, m_pd, m_ppointers, m_pindices, x, r);
+		return true;
 	}
-	else
+#endif
+
+	// loop over all rows
+#pragma omp parallel for schedule(guided)
+	for (int i = 0; i < N; ++i)
 	{
-		assert(m_offset == 0);
-		// loop over all rows
-	#pragma omp parallel for schedule(guided)
-		for (int i = 0; i < N; ++i)
+		const double* pv = m_pd + (m_ppointers[i] - m_offset);
+		const int* pi = m_pindices + (m_ppointers[i] - m_offset);
+		const int n = m_ppointers[i + 1] - m_ppointers[i];
+		double ri = 0.0;
+		for (int j = 0; j < n; j ++)
 		{
-			const double* pv = m_pd + (m_ppointers[i] - m_offset);
-			const int* pi = m_pindices + (m_ppointers[i] - m_offset);
-			const int n = m_ppointers[i + 1] - m_ppointers[i];
-			r[i] = 0.0;
-			for (int j = 0; j < n; j ++)
-			{
-				r[i] += (*pv++) * x[*pi++ - m_offset];
-			}
+			ri += (*pv++) * x[*pi++ - m_offset];
 		}
+		r[i] = ri;
 	}
 
 	return true;
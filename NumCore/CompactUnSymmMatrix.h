@@ -72,6 +72,9 @@ public:
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const vector<int>& lmi, const vector<int>& lmj) override;
 
+	//! find the locations of the element matrix entries in the values array
+	bool ScatterMap(const vector<int>& lmi, const vector<int>& lmj, int nr, int nc, vector<int>& map) override;
+
 	//! add a value to the matrix item
 	void add(int i, int j, double v) override;
 
@@ -190,7 +190,6 @@ void FGMRESSolver::DoJacobiPreconditioning(bool b)
 //-----------------------------------------------------------------------------
 SparseMatrix* FGMRESSolver::CreateSparseMatrix(Matrix_Type ntype)
 {
-#ifdef MKL_ISS
 	// Cleanup if necessary
 	if (m_pA) delete m_pA; 
 	m_pA = nullptr;
@@ -224,9 +223,6 @@ SparseMatrix* FGMRESSolver::CreateSparseMatrix(Matrix_Type ntype)
 
 	// return the matrix (Can be null if matrix format not supported!)
 	return m_pA;
-#else
-	return 0;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -247,9 +243,8 @@ void FGMRESSolver::Destroy()
 //-----------------------------------------------------------------------------
 bool FGMRESSolver::PreProcess() 
 {
-#ifdef MKL_ISS
 	// number of equations
-	MKL_INT N = m_pA->Rows();
+	int N = m_pA->Rows();
 
 	int M = (N < 150 ? N : 150); // this is the default value of ipar[14]
 
@@ -264,9 +259,6 @@ bool FGMRESSolver::PreProcess()
 	m_W.resize(N, 1.0);
 
 	return true; 
-#else
-	return false;
-#endif
 }
 
 
@@ -443,7 +435,186 @@ bool FGMRESSolver::BackSolve(double* x, double* b)
 	return bconverged;
 
 #else
-	return false;
+	// make sure we have a matrix
+	if (m_pA == 0) return false;
+
+	// number of equations
+	int N = m_pA->Rows();
+
+	// data allocation (same defaults as MKL)
+	int M = (N < 150 ? N : 150);
+
+	int nrestart = M;
+	if (m_nrestart > 0) nrestart = m_nrestart;
+	else if (m_maxiter > 0) nrestart = m_maxiter;
+
+	int maxIter = M;
+	if (m_maxiter > 0) maxIter = m_maxiter;
+
+	double reltol = (m_reltol > 0 ? m_reltol : 1e-6);
+	double abstol = (m_abstol > 0 ? m_abstol : 0.0);
+
+	// The Krylov basis V and the preconditioned basis Z are stored in the temp buffer.
+	m_tmp.resize(N*(2 * nrestart + 1));
+	double* V = &m_tmp[0];
+	double* Z = V + N*(nrestart + 1);
+
+	vector<double> H((nrestart + 1)*nrestart, 0.0), cs(nrestart), sn(nrestart), g(nrestart + 1), y(nrestart);
+	vector<double> F(N), r(N);
+
+	// scale rhs
+	for (int i = 0; i < N; ++i) F[i] = m_W[i] * b[i];
+
+	// zero solution vector
+	for (int i = 0; i < N; ++i) x[i] = 0.0;
+
+	// the operator is A or A*R when a right preconditioner is used
+	auto op = [&](double* v, double* w) {
+		if (m_R)
+		{
+			m_R->mult_vector(v, &m_Rv[0]);
+			return m_pA->mult_vector(&m_Rv[0], w);
+		}
+		else return m_pA->mult_vector(v, w);
+	};
+
+	if (m_print_level > 0) feLog("FGMRES:\n");
+
+	double norm0 = sqrt(NumCore::dot(N, &F[0], &F[0]));
+	double tol = reltol*norm0 + abstol;
+	double res = norm0;
+
+	int niter = 0;
+	bool bconverged = false;
+	bool bdone = false;
+	while (!bdone)
+	{
+		// calculate the residual
+		if (niter == 0) r = F;
+		else
+		{
+			if (op(x, &r[0]) == false) break;
+			for (int i = 0; i < N; ++i) r[i] = F[i] - r[i];
+		}
+
+		double beta = sqrt(NumCore::dot(N, &r[0], &r[0]));
+		res = beta;
+		if (m_doResidualTest && (beta <= tol)) { bconverged = true; break; }
+		if (beta == 0.0) { bconverged = true; break; }
+
+		for (int i = 0; i < N; ++i) V[i] = r[i] / beta;
+		g.assign(nrestart + 1, 0.0);
+		g[0] = beta;
+
+		// Arnoldi process
+		int k = 0;
+		for (int j = 0; j < nrestart; ++j)
+		{
+			double* vj = V + j*N;
+			double* w = V + (j + 1)*N;
+
+			// apply the (flexible) preconditioner
+			double* zj = vj;
+			if (m_P)
+			{
+				zj = Z + j*N;
+				if (m_P->mult_vector(vj, zj) == false) { bdone = true; break; }
+			}
+
+			if (op(zj, w) == false) { bdone = true; break; }
+
+			// modified Gram-Schmidt
+			double* hj = &H[j*(nrestart + 1)];
+			for (int i = 0; i <= j; ++i)
+			{
+				double* vi = V + i*N;
+				double hij = NumCore::dot(N, w, vi);
+#pragma omp parallel for
+				for (int l = 0; l < N; ++l) w[l] -= hij*vi[l];
+				hj[i] = hij;
+			}
+			double hn = sqrt(NumCore::dot(N, w, w));
+			hj[j + 1] = hn;
+
+			// apply the previous Givens rotations
+			for (int i = 0; i < j; ++i)
+			{
+				double t = cs[i] * hj[i] + sn[i] * hj[i + 1];
+				hj[i + 1] = -sn[i] * hj[i] + cs[i] * hj[i + 1];
+				hj[i] = t;
+			}
+
+			// calculate the new rotation
+			double d = sqrt(hj[j] * hj[j] + hj[j + 1] * hj[j + 1]);
+			cs[j] = (d != 0.0 ? hj[j] / d : 1.0);
+			sn[j] = (d != 0.0 ? hj[j + 1] / d : 0.0);
+			hj[j] = d;
+			hj[j + 1] = 0.0;
+			g[j + 1] = -sn[j] * g[j];
+			g[j] = cs[j] * g[j];
+
+			k = j + 1;
+			niter++;
+			res = fabs(g[j + 1]);
+
+			if (m_print_level > 1)
+			{
+				feLog("%3d = %lg (%lg)\n", niter, res, tol);
+			}
+
+			if (m_doResidualTest && (res <= tol)) { bconverged = true; break; }
+
+			// the Krylov space is exhausted
+			if (m_doZeroNormTest && (hn <= 1e-12*norm0)) { bconverged = true; break; }
+
+			// A zero norm means that the Krylov space is invariant so the solution is exact
+			// (happy breakdown). We always stop here, since the next basis vector cannot be normalized.
+			if (hn == 0.0) { bconverged = true; break; }
+
+			if (niter >= maxIter) break;
+
+			for (int l = 0; l < N; ++l) w[l] /= hn;
+		}
+
+		// update the solution
+		for (int i = k - 1; i >= 0; --i)
+		{
+			double yi = g[i];
+			for (int l = i + 1; l < k; ++l) yi -= H[l*(nrestart + 1) + i] * y[l];
+			y[i] = yi / H[i*(nrestart + 1) + i];
+		}
+		for (int i = 0; i < k; ++i)
+		{
+			double* zi = (m_P ? Z : V) + i*N;
+#pragma omp parallel for
+			for (int l = 0; l < N; ++l) x[l] += y[i] * zi[l];
+		}
+
+		if (bconverged || (niter >= maxIter)) bdone = true;
+	}
+
+	if (bconverged == false) bconverged = !m_maxIterFail;
+
+	if (m_do_jacobi)
+	{
+		for (int i = 0; i < N; ++i) x[i] *= m_W[i];
+	}
+
+	if (m_R)
+	{
+		m_R->mult_vector(&x[0], &m_Rv[0]);
+		for (int i = 0; i < N; ++i) x[i] = m_Rv[i];
+	}
+
+	if (m_print_level > 0)
+	{
+		feLog("%3d = %lg (%lg)\n", niter, res, tol);
+	}
+
+	// update stats
+	UpdateStats(niter);
+
+	return bconverged;
 #endif // MKL_ISS
 }
 
@@ -29,6 +29,8 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "ILU0_Preconditioner.h"
 #include "CompactUnSymmMatrix.h"
+#include "MatrixTools.h"
+#include <FECore/log.h>
 
 // We must undef PARDISO since it is defined as a function in mkl_solver.h
 #ifdef MKL_ISS
@@ -76,6 +78,7 @@ bool ILU0_Preconditioner::Factor()
 	int* ia = m_K->Pointers();
 	int* ja = m_K->Indices();
 
+#ifdef MKL_ISS
 	MKL_INT ipar[128] = { 0 };
 	double dpar[128] = { 0.0 };
 
@@ -93,6 +96,54 @@ bool ILU0_Preconditioner::Factor()
 	int ierr = 0;
 	dcsrilu0(&N, pa, ia, ja, &m_bilu0[0], ipar, dpar, &ierr);
 	if (ierr != 0) return false;
+#else
+	m_tmp.resize(N, 0.0);
+	m_bilu0.assign(pa, pa + NNZ);
+	double* lu = &m_bilu0[0];
+
+	// find the diagonal entries
+	vector<int> diag(N, -1);
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = ia[i] - 1; k < ia[i + 1] - 1; ++k)
+			if (ja[k] - 1 == i) { diag[i] = k; break; }
+		if (diag[i] < 0)
+		{
+			feLogError("ILU0 preconditioner: missing diagonal in row %d.", i);
+			return false;
+		}
+	}
+
+	// incomplete factorization (ikj-variant), restricted to the sparsity pattern of the matrix
+	vector<int> iw(N, -1);
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = ia[i] - 1; k < ia[i + 1] - 1; ++k) iw[ja[k] - 1] = k;
+
+		for (int k = ia[i] - 1; k < diag[i]; ++k)
+		{
+			int j = ja[k] - 1;
+			double lij = lu[k] / lu[diag[j]];
+			lu[k] = lij;
+			for (int l = diag[j] + 1; l < ia[j + 1] - 1; ++l)
+			{
+				int m = iw[ja[l] - 1];
+				if (m >= 0) lu[m] -= lij*lu[l];
+			}
+		}
+
+		// check the diagonal
+		double& dii = lu[diag[i]];
+		if (m_checkZeroDiagonal && (fabs(dii) < m_zeroThreshold)) dii = m_zeroReplace;
+		if (dii == 0.0)
+		{
+			feLogError("ILU0 preconditioner: zero pivot in row %d.", i);
+			return false;
+		}
+
+		for (int k = ia[i] - 1; k < ia[i + 1] - 1; ++k) iw[ja[k] - 1] = -1;
+	}
+#endif // MKL_ISS
 
 	return true;
 }
@@ -103,6 +154,7 @@ bool ILU0_Preconditioner::BackSolve(double* x, double* y)
 	int* ia = m_K->Pointers();
 	int* ja = m_K->Indices();
 
+#ifdef MKL_ISS
 	char cvar1 = 'L';
 	char cvar = 'N';
 	char cvar2 = 'U';
@@ -111,6 +163,9 @@ bool ILU0_Preconditioner::BackSolve(double* x, double* y)
 	cvar = 'N';
 	cvar2 = 'N';
 	mkl_dcsrtrsv(&cvar1, &cvar, &cvar2, &ivar, &m_bilu0[0], ia, ja, &m_tmp[0], &x[0]);
+#else
+	NumCore::ilu_solve(ivar, &m_bilu0[0], ia, ja, 1, y, x);
+#endif
 
 	return true;
 }
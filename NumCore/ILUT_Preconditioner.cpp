@@ -29,6 +29,9 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "ILUT_Preconditioner.h"
 #include "CompactUnSymmMatrix.h"
+#include "MatrixTools.h"
+#include <FECore/log.h>
+#include <algorithm>
 
 // We must undef PARDISO since it is defined as a function in mkl_solver.h
 #ifdef MKL_ISS
@@ -58,6 +61,14 @@ ILUT_Preconditioner::ILUT_Preconditioner(FEModel* fem) : Preconditioner(fem)
 	m_zeroReplace = 1e-10;
 }
 
+SparseMatrix* ILUT_Preconditioner::CreateSparseMatrix(Matrix_Type ntype)
+{
+	if (ntype != REAL_UNSYMMETRIC) return nullptr;
+	m_K = new CRSSparseMatrix(1);
+	SetSparseMatrix(m_K);
+	return m_K;
+}
+
 bool ILUT_Preconditioner::Factor()
 {
 	m_K = dynamic_cast<CRSSparseMatrix*>(GetSparseMatrix());
@@ -65,12 +76,13 @@ bool ILUT_Preconditioner::Factor()
 	assert(m_K->Offset() == 1);
 
 	int N = m_K->Rows();
-	int ivar = N;
 
 	double* pa = m_K->Values();
 	int* ia = m_K->Pointers();
 	int* ja = m_K->Indices();
 
+#ifdef MKL_ISS
+	int ivar = N;
 	MKL_INT ipar[128] = { 0 };
 	double dpar[128] = { 0.0 };
 
@@ -95,6 +107,99 @@ bool ILUT_Preconditioner::Factor()
 	int ierr;
 	dcsrilut(&ivar, pa, ia, ja, &m_bilut[0], &m_ibilut[0], &m_jbilut[0], &m_fillTol, &m_maxfill, ipar, dpar, &ierr);
 	if (ierr != 0) return false;
+#else
+	m_tmp.resize(N, 0.0);
+	m_ibilut.assign(N + 1, 0);
+	m_bilut.clear();
+	m_jbilut.clear();
+	m_bilut.reserve((2 * m_maxfill + 1)*N);
+	m_jbilut.reserve((2 * m_maxfill + 1)*N);
+
+	// position of the diagonal of each row of the factor (zero-based)
+	vector<int> diag(N);
+
+	// work row
+	vector<double>& w = m_tmp;
+	vector<int> nzl, nzu, inrow(N, 0);
+	vector< pair<double, int> > keep;
+
+	m_ibilut[0] = 1;
+	for (int i = 0; i < N; ++i)
+	{
+		// load row i in the work row
+		double rownorm = 0.0;
+		double wii = 0.0;
+		nzl.clear(); nzu.clear();
+		for (int k = ia[i] - 1; k < ia[i + 1] - 1; ++k)
+		{
+			int j = ja[k] - 1;
+			rownorm += pa[k] * pa[k];
+			if (j == i) { wii = pa[k]; continue; }
+			w[j] = pa[k]; inrow[j] = 1;
+			if (j < i) nzl.push_back(j); else nzu.push_back(j);
+		}
+		double tau = m_fillTol*sqrt(rownorm);
+
+		// eliminate the lower part in increasing column order
+		for (size_t n = 0; n < nzl.size(); ++n)
+		{
+			// find the smallest remaining column
+			size_t m = n;
+			for (size_t l = n + 1; l < nzl.size(); ++l) if (nzl[l] < nzl[m]) m = l;
+			std::swap(nzl[n], nzl[m]);
+
+			int k = nzl[n];
+			double lik = w[k] / m_bilut[diag[k]];
+			if (fabs(lik) < tau) { w[k] = 0.0; continue; }
+			w[k] = lik;
+
+			// subtract the scaled upper part of row k
+			for (int l = diag[k] + 1; l < m_ibilut[k + 1] - 1; ++l)
+			{
+				int j = m_jbilut[l] - 1;
+				double v = lik*m_bilut[l];
+				if (j == i) wii -= v;
+				else if (inrow[j]) w[j] -= v;
+				else
+				{
+					w[j] = -v; inrow[j] = 1;
+					if (j < i) nzl.push_back(j); else nzu.push_back(j);
+				}
+			}
+		}
+
+		// store the largest entries of the lower part
+		keep.clear();
+		for (int j : nzl) if ((w[j] != 0.0) && (fabs(w[j]) >= tau)) keep.push_back(pair<double, int>(-fabs(w[j]), j));
+		if ((int)keep.size() > m_maxfill) { std::nth_element(keep.begin(), keep.begin() + m_maxfill, keep.end()); keep.resize(m_maxfill); }
+		std::sort(keep.begin(), keep.end(), [](const pair<double, int>& a, const pair<double, int>& b) { return a.second < b.second; });
+		for (auto& e : keep) { m_bilut.push_back(w[e.second]); m_jbilut.push_back(e.second + 1); }
+
+		// store the diagonal
+		if (m_checkZeroDiagonal && (fabs(wii) < m_zeroThreshold)) wii = m_zeroReplace;
+		if (wii == 0.0)
+		{
+			feLogError("ILUT preconditioner: zero pivot in row %d.", i);
+			return false;
+		}
+		diag[i] = (int)m_bilut.size();
+		m_bilut.push_back(wii);
+		m_jbilut.push_back(i + 1);
+
+		// store the largest entries of the upper part
+		keep.clear();
+		for (int j : nzu) if (fabs(w[j]) >= tau) keep.push_back(pair<double, int>(-fabs(w[j]), j));
+		if ((int)keep.size() > m_maxfill) { std::nth_element(keep.begin(), keep.begin() + m_maxfill, keep.end()); keep.resize(m_maxfill); }
+		std::sort(keep.begin(), keep.end(), [](const pair<double, int>& a, const pair<double, int>& b) { return a.second < b.second; });
+		for (auto& e : keep) { m_bilut.push_back(w[e.second]); m_jbilut.push_back(e.second + 1); }
+
+		m_ibilut[i + 1] = (int)m_bilut.size() + 1;
+
+		// clear the work row
+		for (int j : nzl) { w[j] = 0.0; inrow[j] = 0; }
+		for (int j : nzu) { w[j] = 0.0; inrow[j] = 0; }
+	}
+#endif // MKL_ISS
 
 	return true;
 }
@@ -102,6 +207,7 @@ bool ILUT_Preconditioner::Factor()
 bool ILUT_Preconditioner::BackSolve(double* x, double* y)
 {
 	int ivar = m_K->Rows();
+#ifdef MKL_ISS
 	char cvar1 = 'L';
 	char cvar = 'N';
 	char cvar2 = 'U';
@@ -110,6 +216,9 @@ bool ILUT_Preconditioner::BackSolve(double* x, double* y)
 	cvar = 'N';
 	cvar2 = 'N';
 	mkl_dcsrtrsv(&cvar1, &cvar, &cvar2, &ivar, &m_bilut[0], &m_ibilut[0], &m_jbilut[0], &m_tmp[0], x);
+#else
+	NumCore::ilu_solve(ivar, &m_bilut[0], &m_ibilut[0], &m_jbilut[0], 1, y, x);
+#endif
 
 	return true;
 }
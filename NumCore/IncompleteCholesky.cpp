@@ -43,7 +43,15 @@ SOFTWARE.*/
 
 IncompleteCholesky::IncompleteCholesky(FEModel* fem) : Preconditioner(fem)
 {
+	m_L = nullptr;
+}
 
+SparseMatrix* IncompleteCholesky::CreateSparseMatrix(Matrix_Type ntype)
+{
+	if (ntype != REAL_SYMMETRIC) return nullptr;
+	CompactSymmMatrix* K = new CompactSymmMatrix(1);
+	SetSparseMatrix(K);
+	return K;
 }
 
 CompactSymmMatrix* IncompleteCholesky::getMatrix()
@@ -66,6 +74,7 @@ bool IncompleteCholesky::Factor()
 	z.resize(N, 0.0);
 
 	// create the preconditioner
+	delete m_L;
 	m_L = new CompactSymmMatrix(K->Offset());
 	double* val = new double[nnz];
 	int* row = new int[nnz];
@@ -164,6 +173,7 @@ bool IncompleteCholesky::BackSolve(double* x, double* y)
 	int* ia = m_L->Pointers();
 	int* ja = m_L->Indices();
 
+#ifdef MKL_ISS
 	char cvar1 = 'U';
 	char cvar = 'T';
 	char cvar2 = 'N';
@@ -172,6 +182,31 @@ bool IncompleteCholesky::BackSolve(double* x, double* y)
 	cvar = 'N';
 	cvar2 = 'N';
 	mkl_dcsrtrsv(&cvar1, &cvar, &cvar2, &ivar, pa, ia, ja, &z[0], &x[0]);
+#else
+	// The factor is stored column-wise, so we solve L z = y by columns
+	int offset = m_L->Offset();
+	for (int i = 0; i < ivar; ++i) z[i] = y[i];
+	for (int k = 0; k < ivar; ++k)
+	{
+		const double* lk = pa + ia[k] - offset;
+		const int* rk = ja + ia[k] - offset;
+		int nk = ia[k + 1] - ia[k];
+		double zk = z[k] / lk[0];
+		z[k] = zk;
+		for (int j = 1; j < nk; ++j) z[rk[j] - offset] -= lk[j] * zk;
+	}
+
+	// and L^T x = z by rows
+	for (int k = ivar - 1; k >= 0; --k)
+	{
+		const double* lk = pa + ia[k] - offset;
+		const int* rk = ja + ia[k] - offset;
+		int nk = ia[k + 1] - ia[k];
+		double xk = z[k];
+		for (int j = 1; j < nk; ++j) xk -= lk[j] * x[rk[j] - offset];
+		x[k] = xk / lk[0];
+	}
+#endif
 
 	return true;
 }
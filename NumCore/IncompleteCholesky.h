@@ -42,6 +42,9 @@ public:
 	// apply to vector P x = y
 	bool BackSolve(double* x, double* y) override;
 
+	// create sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
 public:
 	CompactSymmMatrix* getMatrix();
 
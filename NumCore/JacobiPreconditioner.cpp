@@ -0,0 +1,167 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "JacobiPreconditioner.h"
+#include "CompactSymmMatrix.h"
+#include "CompactUnSymmMatrix.h"
+#include <FECore/log.h>
+
+BEGIN_FECORE_CLASS(JacobiPreconditioner, Preconditioner)
+	ADD_PARAMETER(m_blockSize, "block_size");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+// invert a dense n x n matrix in place using Gauss-Jordan elimination with 
+// partial pivoting. Returns false if the matrix is singular.
+static bool invert_block(double* a, int n)
+{
+	int piv[16];
+	for (int k = 0; k < n; ++k)
+	{
+		// find the pivot
+		int p = k;
+		for (int i = k + 1; i < n; ++i) if (fabs(a[i*n + k]) > fabs(a[p*n + k])) p = i;
+		if (a[p*n + k] == 0.0) return false;
+		piv[k] = p;
+		if (p != k) for (int j = 0; j < n; ++j) { double t = a[k*n + j]; a[k*n + j] = a[p*n + j]; a[p*n + j] = t; }
+
+		double d = 1.0 / a[k*n + k];
+		a[k*n + k] = 1.0;
+		for (int j = 0; j < n; ++j) a[k*n + j] *= d;
+
+		for (int i = 0; i < n; ++i)
+		{
+			if (i == k) continue;
+			double f = a[i*n + k];
+			a[i*n + k] = 0.0;
+			for (int j = 0; j < n; ++j) a[i*n + j] -= f*a[k*n + j];
+		}
+	}
+
+	// undo the row interchanges on the columns
+	for (int k = n - 1; k >= 0; --k)
+	{
+		int p = piv[k];
+		if (p != k) for (int i = 0; i < n; ++i) { double t = a[i*n + k]; a[i*n + k] = a[i*n + p]; a[i*n + p] = t; }
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+JacobiPreconditioner::JacobiPreconditioner(FEModel* fem) : Preconditioner(fem)
+{
+	m_blockSize = 1;
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* JacobiPreconditioner::CreateSparseMatrix(Matrix_Type ntype)
+{
+	SparseMatrix* A = nullptr;
+	switch (ntype)
+	{
+	case REAL_SYMMETRIC     : A = new CompactSymmMatrix(1); break;
+	case REAL_UNSYMMETRIC   : A = new CRSSparseMatrix(1); break;
+	case REAL_SYMM_STRUCTURE: A = new CRSSparseMatrix(1); break;
+	}
+	SetSparseMatrix(A);
+	return A;
+}
+
+//-----------------------------------------------------------------------------
+bool JacobiPreconditioner::Factor()
+{
+	SparseMatrix* A = GetSparseMatrix();
+	if (A == nullptr) return false;
+
+	int N = A->Rows();
+	if (A->Columns() != N) return false;
+
+	int bs = m_blockSize;
+	if ((bs < 1) || (bs > 16))
+	{
+		feLogError("Invalid block size for Jacobi preconditioner.");
+		return false;
+	}
+
+	// number of blocks (the last one can be smaller)
+	int nb = (N + bs - 1) / bs;
+	m_B.resize(nb*bs*bs);
+
+	bool bok = true;
+#pragma omp parallel for shared(bok)
+	for (int b = 0; b < nb; ++b)
+	{
+		int i0 = b*bs;
+		int n = (i0 + bs <= N ? bs : N - i0);
+		double* B = &m_B[b*bs*bs];
+		if (n == 1)
+		{
+			double d = A->diag(i0);
+			if (d == 0.0) bok = false; else B[0] = 1.0 / d;
+		}
+		else
+		{
+			for (int i = 0; i < n; ++i)
+				for (int j = 0; j < n; ++j) B[i*n + j] = (i == j ? A->diag(i0 + i) : A->get(i0 + i, i0 + j));
+			if (invert_block(B, n) == false) bok = false;
+		}
+	}
+
+	if (bok == false)
+	{
+		feLogError("Singular diagonal block in Jacobi preconditioner.");
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool JacobiPreconditioner::BackSolve(double* x, double* y)
+{
+	SparseMatrix* A = GetSparseMatrix();
+	int N = A->Rows();
+	int bs = m_blockSize;
+	int nb = (N + bs - 1) / bs;
+
+#pragma omp parallel for
+	for (int b = 0; b < nb; ++b)
+	{
+		int i0 = b*bs;
+		int n = (i0 + bs <= N ? bs : N - i0);
+		const double* B = &m_B[b*bs*bs];
+		for (int i = 0; i < n; ++i)
+		{
+			double xi = 0.0;
+			for (int j = 0; j < n; ++j) xi += B[i*n + j] * y[i0 + j];
+			x[i0 + i] = xi;
+		}
+	}
+
+	return true;
+}
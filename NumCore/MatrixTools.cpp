@@ -185,6 +185,48 @@ double NumCore::infNorm(const std::vector<double>& x)
 	return m;
 }
 
+// dot product of two vectors
+double NumCore::dot(int n, const double* x, const double* y)
+{
+	double sum = 0.0;
+#pragma omp parallel for reduction(+:sum) schedule(static)
+	for (int i = 0; i < n; ++i) sum += x[i] * y[i];
+	return sum;
+}
+
+// solve LU.x = y, where LU is an incomplete LU factorization in compact row format
+// with a unit lower triangle
+void NumCore::ilu_solve(int n, const double* lu, const int* ia, const int* ja, int offset, const double* y, double* x)
+{
+	// forward substitution with the unit lower triangle
+	for (int i = 0; i < n; ++i)
+	{
+		double xi = y[i];
+		for (int k = ia[i] - offset; k < ia[i + 1] - offset; ++k)
+		{
+			int j = ja[k] - offset;
+			if (j >= i) break;
+			xi -= lu[k] * x[j];
+		}
+		x[i] = xi;
+	}
+
+	// backward substitution with the upper triangle
+	for (int i = n - 1; i >= 0; --i)
+	{
+		double xi = x[i];
+		double dii = 1.0;
+		for (int k = ia[i + 1] - offset - 1; k >= ia[i] - offset; --k)
+		{
+			int j = ja[k] - offset;
+			if (j < i) break;
+			if (j == i) dii = lu[k];
+			else xi -= lu[k] * x[j];
+		}
+		x[i] = xi / dii;
+	}
+}
+
 // print compact matrix pattern to svn file
 void NumCore::print_svg(CompactMatrix* m, std::ostream &out, int i0, int j0, int i1, int j1)
 {
@@ -53,6 +53,12 @@ namespace NumCore
 	// inf-norm of a vector
 	double infNorm(const std::vector<double>& x);
 
+	// dot product of two vectors (parallel)
+	double dot(int n, const double* x, const double* y);
+
+	// solve (LU)x = y, where L (unit lower) and U are stored in a single CRS matrix with sorted column indices
+	void ilu_solve(int n, const double* lu, const int* ia, const int* ja, int offset, const double* y, double* x);
+
 	// print matrix sparsity pattern to svn file
 	void print_svg(CompactMatrix* m, std::ostream &out, int i0 = 0, int j0 = 0, int i1 = -1, int j1 = -1);
 
@@ -0,0 +1,513 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "NestedDissection.h"
+#include <queue>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+// A subgraph is defined by its vertices and the first position that 
+// its vertices will occupy in the final ordering.
+struct ND_SUBGRAPH
+{
+	std::vector<int>	v;	// vertices
+	int					lo;	// first position in ordering
+};
+
+//-----------------------------------------------------------------------------
+NestedDissection::NestedDissection()
+{
+	m_leafSize = 64;
+	m_seed = 1;
+}
+
+//-----------------------------------------------------------------------------
+int NestedDissection::Random(int n)
+{
+	m_seed = m_seed * 1103515245u + 12345u;
+	return (int)((m_seed >> 8) % (unsigned int)n);
+}
+
+//-----------------------------------------------------------------------------
+void NestedDissection::Apply(int n, const std::vector<int>& xadj, const std::vector<int>& adj, std::vector<int>& perm)
+{
+	perm.assign(n, -1);
+	if (n == 0) return;
+	m_seed = 1;
+
+	std::vector<int> local(n, -1);
+	std::vector<int> tag(n, -1);
+	std::vector<int> where;
+
+	// the initial graph contains all vertices
+	std::vector<ND_SUBGRAPH> stack(1);
+	stack[0].lo = 0;
+	stack[0].v.resize(n);
+	for (int i = 0; i < n; ++i) stack[0].v[i] = i;
+
+	int id = 0;
+	while (stack.empty() == false)
+	{
+		ND_SUBGRAPH sg;
+		sg.v.swap(stack.back().v);
+		sg.lo = stack.back().lo;
+		stack.pop_back();
+
+		int nv = (int)sg.v.size();
+		for (int i = 0; i < nv; ++i) local[sg.v[i]] = i;
+		id++;
+
+		// find the first connected component 
+		std::vector<int> comp;
+		comp.push_back(sg.v[0]);
+		tag[sg.v[0]] = id;
+		for (size_t i = 0; i < comp.size(); ++i)
+		{
+			int v = comp[i];
+			for (int k = xadj[v]; k < xadj[v + 1]; ++k)
+			{
+				int w = adj[k];
+				if ((local[w] >= 0) && (tag[w] != id)) { tag[w] = id; comp.push_back(w); }
+			}
+		}
+
+		int nc = (int)comp.size();
+		if (nc < nv)
+		{
+			// The graph is not connected, so we split off this component.
+			// The remaining vertices are processed as a separate subgraph.
+			ND_SUBGRAPH a, b;
+			b.lo = sg.lo + nc;
+			b.v.reserve(nv - nc);
+			for (int i = 0; i < nv; ++i) if (tag[sg.v[i]] != id) b.v.push_back(sg.v[i]);
+			for (int i = 0; i < nv; ++i) local[sg.v[i]] = -1;
+			a.lo = sg.lo;
+			a.v.swap(comp);
+			stack.push_back(b);
+			stack.push_back(a);
+			continue;
+		}
+
+		if (nv <= m_leafSize)
+		{
+			// Number the leaf in reverse breadth-first order.
+			for (int i = 0; i < nv; ++i)
+			{
+				perm[sg.lo + i] = comp[nv - 1 - i];
+				local[comp[i]] = -1;
+			}
+			continue;
+		}
+
+		// build the graph of this subgraph
+		Graph g;
+		g.n = nv;
+		g.xadj.resize(nv + 1);
+		g.xadj[0] = 0;
+		for (int i = 0; i < nv; ++i)
+		{
+			int v = sg.v[i];
+			for (int k = xadj[v]; k < xadj[v + 1]; ++k)
+			{
+				int w = local[adj[k]];
+				if (w >= 0) g.adj.push_back(w);
+			}
+			g.xadj[i + 1] = (int)g.adj.size();
+		}
+		g.ew.assign(g.adj.size(), 1);
+		g.vw.assign(nv, 1);
+
+		// find the separator
+		Bisect(g, where);
+
+		ND_SUBGRAPH a, b;
+		std::vector<int> sep;
+		for (int i = 0; i < nv; ++i)
+		{
+			int v = sg.v[i];
+			if      (where[i] == 0) a.v.push_back(v);
+			else if (where[i] == 1) b.v.push_back(v);
+			else sep.push_back(v);
+			local[v] = -1;
+		}
+
+		if (a.v.empty() || b.v.empty())
+		{
+			// we failed to split the graph, so we treat it as a leaf
+			for (int i = 0; i < nv; ++i) perm[sg.lo + i] = comp[nv - 1 - i];
+			continue;
+		}
+
+		// the separator is numbered last
+		int ns = (int)sep.size();
+		for (int i = 0; i < ns; ++i) perm[sg.lo + nv - ns + i] = sep[i];
+
+		a.lo = sg.lo;
+		b.lo = sg.lo + (int)a.v.size();
+		stack.push_back(b);
+		stack.push_back(a);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Multilevel bisection: coarsen the graph, find a separator on the coarsest graph 
+// and refine it on each level while projecting it back to the original graph. 
+void NestedDissection::Bisect(Graph& g, std::vector<int>& where)
+{
+	// coarsen the graph
+	std::vector<Graph*> levels;
+	levels.push_back(&g);
+	while (levels.back()->n > 100)
+	{
+		Graph* c = new Graph;
+		if (Coarsen(*levels.back(), *c) == false) { delete c; break; }
+		levels.push_back(c);
+	}
+
+	// partition the coarsest graph
+	std::vector<int> wc;
+	InitialSeparator(*levels.back(), wc);
+
+	// uncoarsen
+	for (int l = (int)levels.size() - 2; l >= 0; --l)
+	{
+		Graph& f = *levels[l];
+		std::vector<int> wf(f.n);
+		for (int i = 0; i < f.n; ++i) wf[i] = wc[f.cmap[i]];
+		wc.swap(wf);
+		Refine(f, wc, 3);
+		delete levels[l + 1];
+	}
+	where.swap(wc);
+}
+
+//-----------------------------------------------------------------------------
+// coarsen the graph using heavy-edge matching
+bool NestedDissection::Coarsen(Graph& g, Graph& c)
+{
+	int n = g.n;
+
+	// visit the vertices in random order
+	std::vector<int> order(n);
+	for (int i = 0; i < n; ++i) order[i] = i;
+	for (int i = n - 1; i > 0; --i) std::swap(order[i], order[Random(i + 1)]);
+
+	std::vector<int> match(n, -1);
+	for (int i = 0; i < n; ++i)
+	{
+		int v = order[i];
+		if (match[v] != -1) continue;
+
+		int best = -1, bw = 0;
+		for (int k = g.xadj[v]; k < g.xadj[v + 1]; ++k)
+		{
+			int u = g.adj[k];
+			if ((u != v) && (match[u] == -1) && (g.ew[k] > bw)) { best = u; bw = g.ew[k]; }
+		}
+
+		if (best >= 0) { match[v] = best; match[best] = v; }
+		else match[v] = v;
+	}
+
+	// create the coarse vertices
+	g.cmap.assign(n, -1);
+	int cn = 0;
+	for (int v = 0; v < n; ++v)
+	{
+		if (g.cmap[v] == -1)
+		{
+			g.cmap[v] = cn;
+			g.cmap[match[v]] = cn;
+			cn++;
+		}
+	}
+
+	// stop if the graph does not get much smaller
+	if (cn > 0.85*n) return false;
+
+	c.n = cn;
+	c.vw.assign(cn, 0);
+	c.xadj.assign(cn + 1, 0);
+	c.adj.clear();
+	c.ew.clear();
+
+	std::vector<int> mark(cn, -1), pos(cn, 0);
+	int ci = 0;
+	for (int v = 0; v < n; ++v)
+	{
+		if (g.cmap[v] != ci) continue;
+
+		// add the edges of v and its match
+		int u[2] = { v, match[v] };
+		int nu = (u[1] == v ? 1 : 2);
+		for (int j = 0; j < nu; ++j)
+		{
+			int w = u[j];
+			c.vw[ci] += g.vw[w];
+			for (int k = g.xadj[w]; k < g.xadj[w + 1]; ++k)
+			{
+				int cu = g.cmap[g.adj[k]];
+				if (cu == ci) continue;
+				if (mark[cu] != ci)
+				{
+					mark[cu] = ci;
+					pos[cu] = (int)c.adj.size();
+					c.adj.push_back(cu);
+					c.ew.push_back(g.ew[k]);
+				}
+				else c.ew[pos[cu]] += g.ew[k];
+			}
+		}
+		c.xadj[ci + 1] = (int)c.adj.size();
+		ci++;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Grow a region from several starting vertices until it contains half the weight. 
+// The boundary of the remaining part is used as separator, which is then refined.
+// The best of all trials is kept. 
+void NestedDissection::InitialSeparator(Graph& g, std::vector<int>& where)
+{
+	int n = g.n;
+	int total = 0;
+	for (int i = 0; i < n; ++i) total += g.vw[i];
+
+	const int ntrials = 5;
+	std::vector<int> w(n);
+	int bestSep = -1, bestImb = 0;
+	for (int trial = 0; trial < ntrials; ++trial)
+	{
+		// grow part 0
+		std::fill(w.begin(), w.end(), 1);
+		std::vector<int> queue;
+		int pw0 = 0;
+		int seed = Random(n);
+		size_t qi = 0;
+		while (2 * pw0 < total)
+		{
+			if (qi == queue.size())
+			{
+				// if the queue is empty, we start again from an unvisited vertex
+				if (w[seed] != 1) { seed = -1; for (int i = 0; i < n; ++i) if (w[i] == 1) { seed = i; break; } }
+				if (seed < 0) break;
+				w[seed] = 0; pw0 += g.vw[seed];
+				queue.push_back(seed);
+				continue;
+			}
+
+			int v = queue[qi++];
+			for (int k = g.xadj[v]; k < g.xadj[v + 1]; ++k)
+			{
+				int u = g.adj[k];
+				if (w[u] == 1)
+				{
+					w[u] = 0; pw0 += g.vw[u];
+					queue.push_back(u);
+					if (2 * pw0 >= total) break;
+				}
+			}
+		}
+
+		// the boundary of part 1 becomes the separator
+		for (int v = 0; v < n; ++v)
+		{
+			if (w[v] != 1) continue;
+			for (int k = g.xadj[v]; k < g.xadj[v + 1]; ++k)
+				if (w[g.adj[k]] == 0) { w[v] = 2; break; }
+		}
+
+		Refine(g, w, 5);
+
+		int pw[3] = { 0, 0, 0 };
+		for (int i = 0; i < n; ++i) pw[w[i]] += g.vw[i];
+		int imb = abs(pw[0] - pw[1]);
+		if ((pw[0] == 0) || (pw[1] == 0)) continue;
+		if ((bestSep < 0) || (pw[2] < bestSep) || ((pw[2] == bestSep) && (imb < bestImb)))
+		{
+			bestSep = pw[2];
+			bestImb = imb;
+			where = w;
+		}
+	}
+
+	if (bestSep < 0) where = w;
+}
+
+//-----------------------------------------------------------------------------
+// Fiduccia-Mattheyses refinement of a vertex separator. Separator vertices are
+// moved to one of the parts, which pulls their neighbors in the other part into 
+// the separator. The gain of a move is the decrease of the separator weight. 
+// Moves with negative gain are allowed to escape local minima, but at the end of 
+// each pass the best separator that was found is restored.
+void NestedDissection::Refine(Graph& g, std::vector<int>& where, int passes)
+{
+	int n = g.n;
+	int pw[3] = { 0, 0, 0 };
+	for (int i = 0; i < n; ++i) pw[where[i]] += g.vw[i];
+	int total = pw[0] + pw[1] + pw[2];
+	int maxw = (int)(0.6*total);
+
+	// gain of moving separator vertex v to part p
+	auto gain = [&](int v, int p) {
+		int q = 1 - p;
+		int gv = g.vw[v];
+		for (int k = g.xadj[v]; k < g.xadj[v + 1]; ++k)
+			if (where[g.adj[k]] == q) gv -= g.vw[g.adj[k]];
+		return gv;
+	};
+
+	std::vector<int> locked(n, 0), moves;
+	int pass_id = 0;
+	for (int pass = 0; pass < passes; ++pass)
+	{
+		pass_id++;
+		std::priority_queue< std::pair<int, int> > Q[2];
+		for (int v = 0; v < n; ++v)
+			if (where[v] == 2)
+			{
+				Q[0].push(std::pair<int, int>(gain(v, 0), v));
+				Q[1].push(std::pair<int, int>(gain(v, 1), v));
+			}
+
+		int bestSep = pw[2];
+		int bestImb = abs(pw[0] - pw[1]);
+		bool bestBal = (pw[0] <= maxw) && (pw[1] <= maxw);
+		size_t bestMove = 0;
+		moves.clear();
+
+		int limit = std::max(20, std::min(100, n / 20));
+		int nfail = 0;
+		while (nfail < limit)
+		{
+			// find the best valid move for each side
+			int cand[2] = { -1, -1 }, cg[2] = { 0, 0 };
+			for (int p = 0; p < 2; ++p)
+			{
+				while (Q[p].empty() == false)
+				{
+					std::pair<int, int> top = Q[p].top();
+					int v = top.second;
+					if ((where[v] != 2) || (locked[v] == pass_id)) { Q[p].pop(); continue; }
+					int gv = gain(v, p);
+					if (gv != top.first) { Q[p].pop(); Q[p].push(std::pair<int, int>(gv, v)); continue; }
+					if (pw[p] + g.vw[v] > maxw) { Q[p].pop(); break; }
+					cand[p] = v; cg[p] = gv;
+					break;
+				}
+			}
+			if ((cand[0] < 0) && (cand[1] < 0)) break;
+
+			// pick the side
+			int to;
+			if (cand[0] < 0) to = 1;
+			else if (cand[1] < 0) to = 0;
+			else if (cg[0] != cg[1]) to = (cg[0] > cg[1] ? 0 : 1);
+			else to = (pw[0] < pw[1] ? 0 : 1);
+			int other = 1 - to;
+
+			int v = cand[to];
+			Q[to].pop();
+
+			// move v and pull its neighbors from the other part into the separator
+			where[v] = to; locked[v] = pass_id;
+			pw[to] += g.vw[v]; pw[2] -= g.vw[v];
+			moves.push_back(v);
+			moves.push_back(to);
+			size_t ncount = moves.size();
+			moves.push_back(0);
+			for (int k = g.xadj[v]; k < g.xadj[v + 1]; ++k)
+			{
+				int u = g.adj[k];
+				if (where[u] == other)
+				{
+					where[u] = 2;
+					pw[other] -= g.vw[u]; pw[2] += g.vw[u];
+					moves.push_back(u);
+					moves[ncount]++;
+
+					// the gains of u and its separator neighbors change
+					Q[0].push(std::pair<int, int>(gain(u, 0), u));
+					Q[1].push(std::pair<int, int>(gain(u, 1), u));
+					for (int l = g.xadj[u]; l < g.xadj[u + 1]; ++l)
+					{
+						int x = g.adj[l];
+						if ((where[x] == 2) && (locked[x] != pass_id)) Q[to].push(std::pair<int, int>(gain(x, to), x));
+					}
+				}
+			}
+
+			// see if this is the best separator so far
+			int imb = abs(pw[0] - pw[1]);
+			bool bal = (pw[0] <= maxw) && (pw[1] <= maxw);
+			bool better = false;
+			if (bal && !bestBal) better = true;
+			else if (bal == bestBal)
+			{
+				if (pw[2] < bestSep) better = true;
+				else if ((pw[2] == bestSep) && (imb < bestImb)) better = true;
+			}
+
+			if (better)
+			{
+				bestSep = pw[2];
+				bestImb = imb;
+				bestBal = bal;
+				bestMove = moves.size();
+				nfail = 0;
+			}
+			else nfail++;
+		}
+
+		// undo all moves after the best separator
+		while (moves.size() > bestMove)
+		{
+			// find the start of the last move
+			size_t i = bestMove, last = bestMove;
+			while (i < moves.size()) { last = i; i += 3 + moves[i + 2]; }
+
+			int v = moves[last];
+			int to = moves[last + 1];
+			int nu = moves[last + 2];
+			int other = 1 - to;
+			for (int j = 0; j < nu; ++j)
+			{
+				int u = moves[last + 3 + j];
+				where[u] = other;
+				pw[other] += g.vw[u]; pw[2] -= g.vw[u];
+			}
+			where[v] = 2;
+			pw[to] -= g.vw[v]; pw[2] += g.vw[v];
+			moves.resize(last);
+		}
+
+		// stop if the pass did not improve the separator
+		if (bestMove == 0) break;
+	}
+}
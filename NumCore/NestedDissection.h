@@ -0,0 +1,81 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! This class calculates a fill-reducing ordering of a sparse symmetric matrix
+//! using multilevel nested dissection. Each subgraph is coarsened by heavy-edge 
+//! matching, a vertex separator is found on the coarsest graph, and the separator 
+//! is refined with a Fiduccia-Mattheyses type algorithm while the graph is 
+//! uncoarsened. The separators are numbered last, so that the elimination tree
+//! has independent subtrees that can be factored in parallel.
+class NestedDissection
+{
+public:
+	//! Graph used by the multilevel bisection
+	struct Graph
+	{
+		int		n;
+		std::vector<int>	xadj;	// adjacency pointers
+		std::vector<int>	adj;	// adjacency
+		std::vector<int>	ew;		// edge weights
+		std::vector<int>	vw;		// vertex weights
+		std::vector<int>	cmap;	// map to coarse graph
+	};
+
+public:
+	NestedDissection();
+
+	//! set the size of the subgraphs that are no longer split
+	void SetLeafSize(int n) { m_leafSize = n; }
+
+	//! Calculate the ordering of the graph given in compressed row format (excluding the diagonal).
+	//! On return, perm[k] is the vertex that is eliminated k-th.
+	void Apply(int n, const std::vector<int>& xadj, const std::vector<int>& adj, std::vector<int>& perm);
+
+private:
+	// split the graph in two parts (0, 1) and a separator (2)
+	void Bisect(Graph& g, std::vector<int>& where);
+
+	// coarsen a graph (returns false if the graph could not be coarsened further)
+	bool Coarsen(Graph& g, Graph& c);
+
+	// find an initial separator on the coarsest graph
+	void InitialSeparator(Graph& g, std::vector<int>& where);
+
+	// improve a separator
+	void Refine(Graph& g, std::vector<int>& where, int passes);
+
+	// random number generator (to make the ordering reproducible)
+	int Random(int n);
+
+private:
+	int		m_leafSize;
+	unsigned int	m_seed;
+};
@@ -44,6 +44,9 @@ SOFTWARE.*/
 #include "BlockSolver.h"
 #include "BiCGStabSolver.h"
 #include "StrategySolver.h"
+#include "SparseLDLTSolver.h"
+#include "MINRESSolver.h"
+#include "JacobiPreconditioner.h"
 #include <FECore/fecore_enum.h>
 #include <FECore/FECoreFactory.h>
 #include <FECore/FECoreKernel.h>
@@ -66,11 +69,14 @@ void NumCore::InitModule()
 	REGISTER_FECORE_CLASS(BIPNSolver          , "bipn");
 	REGISTER_FECORE_CLASS(BiCGStabSolver      , "bicgstab");
 	REGISTER_FECORE_CLASS(StrategySolver      , "strategy");
+	REGISTER_FECORE_CLASS(SparseLDLTSolver    , "ldlt");
+	REGISTER_FECORE_CLASS(MINRESSolver        , "minres");
 
 	// register preconditioners
 	REGISTER_FECORE_CLASS(ILU0_Preconditioner, "ilu0");
 	REGISTER_FECORE_CLASS(ILUT_Preconditioner, "ilut");
 	REGISTER_FECORE_CLASS(IncompleteCholesky , "ichol");
+	REGISTER_FECORE_CLASS(JacobiPreconditioner, "jacobi");
 
 	// set default linear solver
 	// (Set this before the configuration is read in because
@@ -90,6 +90,7 @@ void print_err(int nerror)
 BEGIN_FECORE_CLASS(PardisoSolver, LinearSolver)
 	ADD_PARAMETER(m_print_cn, "print_condition_number");
 	ADD_PARAMETER(m_iparm3  , "precondition");
+	ADD_PARAMETER(m_reuseSymbolic, "reuse_symbolic");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -99,6 +100,9 @@ PardisoSolver::PardisoSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
 	m_mtype = -2;
 	m_iparm3 = false;
 	m_isFactored = false;
+	m_reuseSymbolic = true;
+	m_isAnalyzed = false;
+	m_patternHash = 0;
 
 	/* If both PARDISO AND PARDISODL are defined, print a warning */
 #ifdef PARDISODL
@@ -110,7 +114,7 @@ PardisoSolver::PardisoSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
 //-----------------------------------------------------------------------------
 PardisoSolver::~PardisoSolver()
 {
-	Destroy();
+	Release();
 #ifdef PARDISO
 	MKL_Free_Buffers();
 #endif
@@ -158,11 +162,16 @@ bool PardisoSolver::SetSparseMatrix(SparseMatrix* pA)
 //-----------------------------------------------------------------------------
 bool PardisoSolver::PreProcess()
 {
-	m_iparm[0] = 0; /* Use default values for parameters */
-
 	//fprintf(stderr, "In PreProcess\n");
 	assert(m_isFactored == false);
-	pardisoinit(m_pt, &m_mtype, m_iparm);
+
+	// Initialize the solver, unless we're holding on to a previous symbolic factorization.
+	// (In that case, Factor will decide if it can be reused.)
+	if (m_isAnalyzed == false)
+	{
+		m_iparm[0] = 0; /* Use default values for parameters */
+		pardisoinit(m_pt, &m_mtype, m_iparm);
+	}
 
 	m_n = m_pA->Rows();
 	m_nnz = m_pA->NonZeroes();
@@ -188,20 +197,38 @@ bool PardisoSolver::Factor()
 
 // ------------------------------------------------------------------------------
 // Reordering and Symbolic Factorization.  This step also allocates all memory
-// that is necessary for the factorization.
+// that is necessary for the factorization. This only needs to be done when the
+// sparsity pattern changed since the last time. 
 // ------------------------------------------------------------------------------
 
-	int phase = 11;
+	unsigned long long hash = m_pA->PatternHash()*31ULL + (unsigned long long)(m_mtype + 16);
+	bool reuse = (m_reuseSymbolic && m_isAnalyzed && (hash == m_patternHash));
 
+	int phase;
 	int error = 0;
-	pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, m_pA->Values(), m_pA->Pointers(), m_pA->Indices(),
-		 NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
-
-	if (error)
+	if (reuse == false)
 	{
-		fprintf(stderr, "\nERROR during symbolic factorization: ");
-		print_err(error);
-		exit(2);
+		// release the old symbolic factorization
+		if (m_isAnalyzed)
+		{
+			Release();
+			m_iparm[0] = 0;
+			pardisoinit(m_pt, &m_mtype, m_iparm);
+		}
+
+		phase = 11;
+		pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, m_pA->Values(), m_pA->Pointers(), m_pA->Indices(),
+			 NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
+
+		if (error)
+		{
+			fprintf(stderr, "\nERROR during symbolic factorization: ");
+			print_err(error);
+			exit(2);
+		}
+
+		m_isAnalyzed = true;
+		m_patternHash = hash;
 	}
 
 // ------------------------------------------------------------------------------
@@ -231,6 +258,8 @@ bool PardisoSolver::Factor()
 
 	m_isFactored = true;
 
+	UpdateFactorStats(reuse);
+
 	return true;
 }
 
@@ -307,17 +336,47 @@ double PardisoSolver::condition_number()
 
 //-----------------------------------------------------------------------------
 void PardisoSolver::Destroy()
+{
+	// If we can reuse the symbolic factorization, we keep Pardiso's memory 
+	// until we know if the sparsity pattern changed.
+	if (m_reuseSymbolic == false) Release();
+	m_isFactored = false;
+}
+
+//-----------------------------------------------------------------------------
+void PardisoSolver::Release()
 {
 	int phase = -1;
 
 	int error = 0;
 
-	if (m_pA && m_pA->Pointers() && m_isFactored)
+	if (m_isAnalyzed || m_isFactored)
 	{
-		pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, NULL, m_pA->Pointers(), m_pA->Indices(),
+		int idum = 0;
+		pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, NULL, &idum, &idum,
 			NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
 	}
 	m_isFactored = false;
+	m_isAnalyzed = false;
 }
 
+#else	// ifdef PARDISO
+
+// Without MKL, the Pardiso solver is not available, but the class must still 
+// be defined since it is registered with the kernel.
+BEGIN_FECORE_CLASS(PardisoSolver, LinearSolver)
+END_FECORE_CLASS();
+
+PardisoSolver::PardisoSolver(FEModel* fem) : LinearSolver(fem), m_pA(0) { m_isFactored = false; m_isAnalyzed = false; }
+PardisoSolver::~PardisoSolver() {}
+void PardisoSolver::PrintConditionNumber(bool b) {}
+void PardisoSolver::UseIterativeFactorization(bool b) {}
+SparseMatrix* PardisoSolver::CreateSparseMatrix(Matrix_Type ntype) { return 0; }
+bool PardisoSolver::SetSparseMatrix(SparseMatrix* pA) { return false; }
+bool PardisoSolver::PreProcess() { return false; }
+bool PardisoSolver::Factor() { return false; }
+bool PardisoSolver::BackSolve(double* x, double* b) { return false; }
+double PardisoSolver::condition_number() { return 0.0; }
+void PardisoSolver::Destroy() {}
+
 #endif
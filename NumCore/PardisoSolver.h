@@ -55,6 +55,10 @@ public:
 
 	void UseIterativeFactorization(bool b);
 
+protected:
+	// release all internal Pardiso memory (including the symbolic factorization)
+	void Release();
+
 protected:
 
 	CompactMatrix*	m_pA;
@@ -74,6 +78,11 @@ protected:
 
 	bool	m_isFactored;
 
+	// The symbolic factorization (phase 11) is kept until the sparsity pattern changes
+	bool				m_reuseSymbolic;	// reuse the symbolic factorization if possible
+	bool				m_isAnalyzed;		// the symbolic factorization is available
+	unsigned long long	m_patternHash;		// hash of the sparsity pattern of the symbolic factorization
+
 	void* m_pt[64]; // Internal solver memory pointer
 
 	DECLARE_FECORE_CLASS();
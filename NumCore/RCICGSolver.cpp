@@ -29,6 +29,8 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "RCICGSolver.h"
 #include "IncompleteCholesky.h"
+#include "MatrixTools.h"
+#include <FECore/log.h>
 
 //-----------------------------------------------------------------------------
 // We must undef PARDISO since it is defined as a function in mkl_solver.h
@@ -62,13 +64,17 @@ RCICGSolver::RCICGSolver(FEModel* fem) : IterativeLinearSolver(fem), m_pA(0), m_
 //-----------------------------------------------------------------------------
 SparseMatrix* RCICGSolver::CreateSparseMatrix(Matrix_Type ntype)
 {
-#ifdef MKL_ISS
 	if (ntype != REAL_SYMMETRIC) return 0;
-	m_pA = new CompactSymmMatrix(1);
+
+	// let the preconditioner decide
+	m_pA = nullptr;
+	if (m_P)
+	{
+		m_P->SetPartitions(m_part);
+		m_pA = m_P->CreateSparseMatrix(ntype);
+	}
+	if (m_pA == nullptr) m_pA = new CompactSymmMatrix(1);
 	return m_pA;
-#else
-	return 0;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -106,6 +112,11 @@ bool RCICGSolver::PreProcess()
 bool RCICGSolver::Factor()
 {
 	if (m_pA == 0) return false;
+	if (m_P)
+	{
+		if (m_P->PreProcess() == false) return false;
+		if (m_P->Factor() == false) return false;
+	}
 	return true;
 }
 
@@ -208,7 +219,67 @@ bool RCICGSolver::BackSolve(double* x, double* b)
 
 	return (m_fail_max_iters ? bsuccess : true);
 #else
-	return false;
+	// make sure we have a matrix
+	if (m_pA == 0) return false;
+
+	int n = m_pA->Rows();
+
+	// zero solution vector
+	for (int i = 0; i < n; ++i) x[i] = 0.0;
+
+	// default max iterations (same as MKL)
+	int maxiter = (m_maxiter > 0 ? m_maxiter : (n < 150 ? n : 150));
+
+	vector<double> r(b, b + n), z(n), p(n), q(n);
+
+	// We use the same residual stopping test as MKL's dcg, 
+	// which compares the squared norms of the residuals.
+	double rr0 = NumCore::dot(n, &r[0], &r[0]);
+	double tol = m_tol*rr0;
+	double rr = rr0;
+
+	if (m_P) m_P->mult_vector(&r[0], &z[0]); else z = r;
+	p = z;
+	double rz = NumCore::dot(n, &r[0], &z[0]);
+
+	bool bsuccess = (rr0 == 0.0);
+	int niter = 0;
+	while (!bsuccess && (niter < maxiter))
+	{
+		if (m_pA->mult_vector(&p[0], &q[0]) == false) break;
+
+		double pq = NumCore::dot(n, &p[0], &q[0]);
+		if (pq == 0.0) break;
+		double alpha = rz / pq;
+
+#pragma omp parallel for
+		for (int i = 0; i < n; ++i)
+		{
+			x[i] += alpha*p[i];
+			r[i] -= alpha*q[i];
+		}
+		niter++;
+
+		rr = NumCore::dot(n, &r[0], &r[0]);
+		if (m_print_level > 1) feLog("%3d = %lg (%lg)\n", niter, rr, tol);
+		if (rr <= tol) { bsuccess = true; break; }
+
+		// apply the preconditioner
+		if (m_P) m_P->mult_vector(&r[0], &z[0]); else z = r;
+
+		double rz_new = NumCore::dot(n, &r[0], &z[0]);
+		double beta = rz_new / rz;
+		rz = rz_new;
+
+#pragma omp parallel for
+		for (int i = 0; i < n; ++i) p[i] = z[i] + beta*p[i];
+	}
+
+	if (m_print_level > 0) feLog("CG: %3d = %lg (%lg)\n", niter, rr, tol);
+
+	UpdateStats(niter);
+
+	return (m_fail_max_iters ? bsuccess : true);
 #endif // MKL_ISS
 }
 
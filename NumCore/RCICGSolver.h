@@ -28,6 +28,7 @@ SOFTWARE.*/
 #include "CompactSymmMatrix.h"
 
 // This class implements an interface to the RCI CG iterative solver from the MKL math library.
+// When FEBio is built without MKL, a native preconditioned CG implementation is used instead.
 class RCICGSolver : public IterativeLinearSolver
 {
 public:
@@ -0,0 +1,621 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "SparseLDLTSolver.h"
+#include "NestedDissection.h"
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <algorithm>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(SparseLDLTSolver, LinearSolver)
+	ADD_PARAMETER(m_printLevel, "print_level");
+	ADD_PARAMETER(m_pivotTol  , "pivot_tolerance");
+	ADD_PARAMETER(m_leafSize  , "leaf_size");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+SparseLDLTSolver::SparseLDLTSolver(FEModel* fem) : LinearSolver(fem), m_pA(nullptr)
+{
+	m_printLevel = 0;
+	m_pivotTol = 1e-13;
+	m_leafSize = 64;
+
+	m_n = 0;
+	m_nnz = 0;
+	m_patternHash = 0;
+	m_analyzed = false;
+	m_ns = 0;
+	m_tol = 0.0;
+	m_npert = 0;
+}
+
+//-----------------------------------------------------------------------------
+SparseLDLTSolver::~SparseLDLTSolver()
+{
+	Destroy();
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* SparseLDLTSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	// this solver only works with symmetric matrices
+	if (ntype != REAL_SYMMETRIC) return nullptr;
+	m_pA = new CompactSymmMatrix(0);
+	return m_pA;
+}
+
+//-----------------------------------------------------------------------------
+bool SparseLDLTSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	m_pA = dynamic_cast<CompactSymmMatrix*>(pA);
+	return (m_pA != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+bool SparseLDLTSolver::PreProcess()
+{
+	if (m_pA == nullptr) return false;
+
+	// the analysis can be reused if the sparsity pattern did not change
+	bool reuse = (m_n > 0) && (m_pA->Rows() == m_n) && (m_pA->NonZeroes() == m_nnz) && (m_pA->PatternHash() == m_patternHash);
+	if ((reuse == false) && (SymbolicFactor() == false)) return false;
+
+	return LinearSolver::PreProcess();
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the ordering, the elimination tree and the supernode structure.
+bool SparseLDLTSolver::SymbolicFactor()
+{
+	CompactSymmMatrix& A = *m_pA;
+	int n = A.Rows();
+	int off = A.Offset();
+	const int* pp = A.Pointers();
+	const int* pi = A.Indices();
+
+	m_n = n;
+	m_nnz = A.NonZeroes();
+	m_patternHash = A.PatternHash();
+	m_analyzed = true;
+	m_ns = 0;
+	if (n == 0) return true;
+
+	// build the adjacency graph of the matrix
+	std::vector<int> xadj(n + 1, 0), adj;
+	for (int j = 0; j < n; ++j)
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int i = pi[k] - off;
+			if (i != j) { xadj[i + 1]++; xadj[j + 1]++; }
+		}
+	for (int i = 0; i < n; ++i) xadj[i + 1] += xadj[i];
+	adj.resize(xadj[n]);
+	{
+		std::vector<int> tag(xadj.begin(), xadj.end() - 1);
+		for (int j = 0; j < n; ++j)
+			for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+			{
+				int i = pi[k] - off;
+				if (i != j) { adj[tag[i]++] = j; adj[tag[j]++] = i; }
+			}
+	}
+
+	// calculate the fill-reducing ordering
+	std::vector<int> perm;
+	NestedDissection nd;
+	nd.SetLeafSize(m_leafSize);
+	nd.Apply(n, xadj, adj, perm);
+	adj.clear();
+
+	// We calculate the elimination tree twice: once to find its postorder and then
+	// again for the postordered matrix. The postorder does not change the fill, but 
+	// it makes all subtrees contiguous.
+	std::vector<int> parent(n), rp(n + 1), rc;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		m_iperm.resize(n);
+		for (int k = 0; k < n; ++k) m_iperm[perm[k]] = k;
+
+		// strict lower triangle of the permuted matrix in row format
+		std::fill(rp.begin(), rp.end(), 0);
+		for (int j = 0; j < n; ++j)
+			for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+			{
+				int a = m_iperm[pi[k] - off], b = m_iperm[j];
+				if (a != b) rp[std::max(a, b) + 1]++;
+			}
+		for (int i = 0; i < n; ++i) rp[i + 1] += rp[i];
+		rc.resize(rp[n]);
+		{
+			std::vector<int> tag(rp.begin(), rp.end() - 1);
+			for (int j = 0; j < n; ++j)
+				for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+				{
+					int a = m_iperm[pi[k] - off], b = m_iperm[j];
+					if (a != b) rc[tag[std::max(a, b)]++] = std::min(a, b);
+				}
+		}
+
+		// elimination tree (Liu's algorithm with path compression)
+		std::vector<int> anc(n, -1);
+		for (int i = 0; i < n; ++i)
+		{
+			parent[i] = -1;
+			for (int k = rp[i]; k < rp[i + 1]; ++k)
+			{
+				int r = rc[k];
+				while ((r != -1) && (r < i))
+				{
+					int rnext = anc[r];
+					anc[r] = i;
+					if (rnext == -1) parent[r] = i;
+					r = rnext;
+				}
+			}
+		}
+
+		if (pass == 1) break;
+
+		// postorder the tree
+		std::vector<int> head(n, -1), next(n, -1), post(n), stack;
+		for (int j = n - 1; j >= 0; --j)
+		{
+			if (parent[j] != -1) { next[j] = head[parent[j]]; head[parent[j]] = j; }
+		}
+		int k = 0;
+		for (int j = 0; j < n; ++j)
+		{
+			if (parent[j] != -1) continue;
+			stack.push_back(j);
+			while (stack.empty() == false)
+			{
+				int p = stack.back();
+				int c = head[p];
+				if (c == -1) { stack.pop_back(); post[k++] = p; }
+				else { head[p] = next[c]; stack.push_back(c); }
+			}
+		}
+
+		std::vector<int> perm2(n);
+		for (int i = 0; i < n; ++i) perm2[i] = perm[post[i]];
+		perm.swap(perm2);
+	}
+	m_perm = perm;
+
+	// column counts of L from the row subtrees
+	std::vector<int> cc(n, 1), mark(n, -1), nchild(n, 0);
+	for (int i = 0; i < n; ++i)
+	{
+		mark[i] = i;
+		for (int k = rp[i]; k < rp[i + 1]; ++k)
+		{
+			for (int j = rc[k]; (j != -1) && (mark[j] != i); j = parent[j])
+			{
+				mark[j] = i;
+				cc[j]++;
+			}
+		}
+	}
+	for (int j = 0; j < n; ++j) if (parent[j] != -1) nchild[parent[j]]++;
+	rc.clear();
+
+	// permuted lower triangle in column format (including the diagonal)
+	m_Ap.assign(n + 1, 0);
+	for (int j = 0; j < n; ++j)
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int a = m_iperm[pi[k] - off], b = m_iperm[j];
+			m_Ap[std::min(a, b) + 1]++;
+		}
+	for (int i = 0; i < n; ++i) m_Ap[i + 1] += m_Ap[i];
+	m_Ai.resize(m_Ap[n]);
+	m_Asrc.resize(m_Ap[n]);
+	{
+		std::vector<int> tag(m_Ap.begin(), m_Ap.end() - 1);
+		for (int j = 0; j < n; ++j)
+			for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+			{
+				int a = m_iperm[pi[k] - off], b = m_iperm[j];
+				int c = std::min(a, b);
+				m_Ai[tag[c]] = std::max(a, b);
+				m_Asrc[tag[c]] = k;
+				tag[c]++;
+			}
+	}
+
+	// find the fundamental supernodes
+	m_sfirst.clear();
+	m_sfirst.push_back(0);
+	for (int j = 1; j < n; ++j)
+	{
+		bool bmerge = (parent[j - 1] == j) && (cc[j - 1] == cc[j] + 1) && (nchild[j] == 1);
+		if (bmerge == false) m_sfirst.push_back(j);
+	}
+	m_sfirst.push_back(n);
+	m_ns = (int)m_sfirst.size() - 1;
+
+	std::vector<int> snode(n);
+	for (int s = 0; s < m_ns; ++s)
+		for (int j = m_sfirst[s]; j < m_sfirst[s + 1]; ++j) snode[j] = s;
+
+	m_sparent.resize(m_ns);
+	m_schild.assign(m_ns, std::vector<int>());
+	for (int s = 0; s < m_ns; ++s)
+	{
+		int p = parent[m_sfirst[s + 1] - 1];
+		m_sparent[s] = (p == -1 ? -1 : snode[p]);
+		if (p != -1) m_schild[m_sparent[s]].push_back(s);
+	}
+
+	// row structures of the supernodes
+	m_srp.assign(m_ns + 1, 0);
+	m_srow.clear();
+	std::fill(mark.begin(), mark.end(), -1);
+	std::vector<int> extra;
+	for (int s = 0; s < m_ns; ++s)
+	{
+		int f = m_sfirst[s], l = m_sfirst[s + 1];
+		for (int j = f; j < l; ++j) { m_srow.push_back(j); mark[j] = s; }
+
+		extra.clear();
+		for (int j = f; j < l; ++j)
+			for (int k = m_Ap[j]; k < m_Ap[j + 1]; ++k)
+			{
+				int i = m_Ai[k];
+				if (mark[i] != s) { mark[i] = s; extra.push_back(i); }
+			}
+
+		for (size_t c = 0; c < m_schild[s].size(); ++c)
+		{
+			int sc = m_schild[s][c];
+			int kc = m_sfirst[sc + 1] - m_sfirst[sc];
+			for (int k = m_srp[sc] + kc; k < m_srp[sc + 1]; ++k)
+			{
+				int i = m_srow[k];
+				if (mark[i] != s) { mark[i] = s; extra.push_back(i); }
+			}
+		}
+
+		std::sort(extra.begin(), extra.end());
+		m_srow.insert(m_srow.end(), extra.begin(), extra.end());
+		m_srp[s + 1] = (int)m_srow.size();
+	}
+
+	// storage of the factor
+	m_slp.assign(m_ns + 1, 0);
+	double flops = 0.0;
+	for (int s = 0; s < m_ns; ++s)
+	{
+		size_t k = m_sfirst[s + 1] - m_sfirst[s];
+		size_t m = m_srp[s + 1] - m_srp[s];
+		m_slp[s + 1] = m_slp[s] + m*k;
+		flops += (double)k*(double)m*(double)m;
+	}
+
+	BuildSchedule(omp_get_max_threads());
+
+	if (m_printLevel > 0)
+	{
+		feLog("\tsparse LDLt: equations ...................... : %d\n", n);
+		feLog("\tsparse LDLt: supernodes ..................... : %d\n", m_ns);
+		feLog("\tsparse LDLt: nonzeroes in factor ............ : %.0lf\n", (double)m_slp[m_ns]);
+		feLog("\tsparse LDLt: estimated flops ................ : %lg\n", flops);
+		feLog("\tsparse LDLt: parallel subtrees .............. : %d\n", (int)m_task0.size());
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// The supernodes are divided into subtrees that are factored in parallel, and
+// top-level supernodes that are factored afterwards (using multithreaded dense updates).
+// The tree is split from the roots until no subtree has more than a fraction of the total work.
+void SparseLDLTSolver::BuildSchedule(int nthreads)
+{
+	m_task0.clear();
+	m_task1.clear();
+	m_top.clear();
+	if (m_ns == 0) return;
+
+	// work of each subtree and first supernode of each subtree
+	std::vector<double> W(m_ns, 0.0);
+	std::vector<int> first(m_ns);
+	for (int s = 0; s < m_ns; ++s) first[s] = s;
+	for (int s = 0; s < m_ns; ++s)
+	{
+		double k = m_sfirst[s + 1] - m_sfirst[s];
+		double m = m_srp[s + 1] - m_srp[s];
+		W[s] += k*m*m + m*m;
+		int p = m_sparent[s];
+		if (p != -1)
+		{
+			W[p] += W[s];
+			if (first[s] < first[p]) first[p] = first[s];
+		}
+	}
+
+	std::vector<int> cand;
+	double total = 0.0;
+	for (int s = 0; s < m_ns; ++s) if (m_sparent[s] == -1) { cand.push_back(s); total += W[s]; }
+
+	if (nthreads > 1)
+	{
+		double wmax = total / (4.0*nthreads);
+		while (true)
+		{
+			// find the largest subtree
+			int imax = 0;
+			for (int i = 1; i < (int)cand.size(); ++i) if (W[cand[i]] > W[cand[imax]]) imax = i;
+			int s = cand[imax];
+			if ((W[s] <= wmax) || m_schild[s].empty()) break;
+
+			// replace it by its children
+			m_top.push_back(s);
+			cand.erase(cand.begin() + imax);
+			cand.insert(cand.end(), m_schild[s].begin(), m_schild[s].end());
+		}
+	}
+
+	// largest subtrees go first
+	std::sort(cand.begin(), cand.end(), [&](int a, int b) { return W[a] > W[b]; });
+	for (size_t i = 0; i < cand.size(); ++i)
+	{
+		m_task0.push_back(first[cand[i]]);
+		m_task1.push_back(cand[i]);
+	}
+
+	// the top supernodes must be processed in order
+	std::sort(m_top.begin(), m_top.end());
+}
+
+//-----------------------------------------------------------------------------
+bool SparseLDLTSolver::Factor()
+{
+	if (m_pA == nullptr) return false;
+
+	// redo the analysis if the matrix structure changed
+	if ((m_pA->Rows() != m_n) || (m_pA->NonZeroes() != m_nnz))
+	{
+		if (SymbolicFactor() == false) return false;
+	}
+	if (m_n == 0) return true;
+
+	// absolute pivot tolerance
+	double dmax = 0.0;
+	for (int i = 0; i < m_n; ++i)
+	{
+		double di = fabs(m_pA->diag(i));
+		if (di > dmax) dmax = di;
+	}
+	m_tol = m_pivotTol*(dmax > 0.0 ? dmax : 1.0);
+	m_npert = 0;
+
+	m_L.resize(m_slp[m_ns]);
+	m_D.resize(m_n);
+	m_U.assign(m_ns, std::vector<double>());
+
+	// each thread needs its own position array
+	int nthreads = omp_get_max_threads();
+	std::vector< std::vector<int> > pos(nthreads, std::vector<int>(m_n, 0));
+
+	// factor the independent subtrees
+	int ntasks = (int)m_task0.size();
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int t = 0; t < ntasks; ++t)
+	{
+		int tid = omp_get_thread_num();
+		for (int s = m_task0[t]; s <= m_task1[t]; ++s) FactorSupernode(s, pos[tid]);
+	}
+
+	// factor the top of the tree
+	for (size_t i = 0; i < m_top.size(); ++i) FactorSupernode(m_top[i], pos[0]);
+
+	m_U.clear();
+
+	if ((m_npert > 0) && (m_printLevel > 0))
+	{
+		feLogWarning("sparse LDLt: %d pivots were perturbed", m_npert);
+	}
+
+	UpdateFactorStats(m_analyzed == false);
+	m_analyzed = false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Factor a supernode with the multifrontal method: The frontal matrix is assembled 
+// from the matrix entries and the update matrices of the children, and then its 
+// pivot columns are eliminated. The remaining Schur complement is the update matrix
+// that is passed on to the parent.
+void SparseLDLTSolver::FactorSupernode(int s, std::vector<int>& pos)
+{
+	const int f = m_sfirst[s];
+	const int k = m_sfirst[s + 1] - f;
+	const int m = m_srp[s + 1] - m_srp[s];
+	const int* rows = &m_srow[m_srp[s]];
+	for (int i = 0; i < m; ++i) pos[rows[i]] = i;
+
+	// frontal matrix (column major, only the lower triangle is used)
+	std::vector<double> F((size_t)m*m, 0.0);
+
+	// assemble the matrix entries
+	const double* val = m_pA->Values();
+	for (int j = 0; j < k; ++j)
+	{
+		double* Fj = &F[(size_t)j*m];
+		for (int p = m_Ap[f + j]; p < m_Ap[f + j + 1]; ++p) Fj[pos[m_Ai[p]]] += val[m_Asrc[p]];
+	}
+
+	// extend-add the update matrices of the children
+	for (size_t c = 0; c < m_schild[s].size(); ++c)
+	{
+		int sc = m_schild[s][c];
+		int kc = m_sfirst[sc + 1] - m_sfirst[sc];
+		int mu = m_srp[sc + 1] - m_srp[sc] - kc;
+		if (mu == 0) continue;
+		const int* rc = &m_srow[m_srp[sc] + kc];
+		const double* U = &(m_U[sc][0]);
+		for (int b = 0; b < mu; ++b)
+		{
+			double* Fb = &F[(size_t)pos[rc[b]] * m];
+			const double* Ub = U + (size_t)b*mu;
+			for (int a = b; a < mu; ++a) Fb[pos[rc[a]]] += Ub[a];
+		}
+		std::vector<double>().swap(m_U[sc]);
+	}
+
+	// eliminate the pivot columns in blocks
+	double* D = &m_D[f];
+	const int nb = 32;
+	for (int j0 = 0; j0 < k; j0 += nb)
+	{
+		int j1 = std::min(j0 + nb, k);
+
+		// factor the block columns (left-looking within the block)
+		for (int j = j0; j < j1; ++j)
+		{
+			double* Fj = &F[(size_t)j*m];
+			for (int p = j0; p < j; ++p)
+			{
+				const double* Fp = &F[(size_t)p*m];
+				double w = Fp[j] * D[p];
+				if (w != 0.0) for (int i = j; i < m; ++i) Fj[i] -= Fp[i] * w;
+			}
+
+			double d = Fj[j];
+			if (fabs(d) < m_tol)
+			{
+				d = (d < 0.0 ? -m_tol : m_tol);
+				#pragma omp atomic
+				m_npert++;
+			}
+			D[j] = d;
+			Fj[j] = 1.0;
+			double di = 1.0 / d;
+			for (int i = j + 1; i < m; ++i) Fj[i] *= di;
+		}
+
+		// update the remaining columns of the front
+		int nc = m - j1;
+		#pragma omp parallel for schedule(dynamic, 16) if ((double)nc*nc*(j1 - j0) > 1e6)
+		for (int c = j1; c < m; ++c)
+		{
+			double* Fc = &F[(size_t)c*m];
+			for (int p = j0; p < j1; ++p)
+			{
+				const double* Fp = &F[(size_t)p*m];
+				double w = Fp[c] * D[p];
+				if (w != 0.0) for (int i = c; i < m; ++i) Fc[i] -= Fp[i] * w;
+			}
+		}
+	}
+
+	// store the factor columns
+	std::copy(F.begin(), F.begin() + (size_t)m*k, m_L.begin() + m_slp[s]);
+
+	// store the update matrix
+	int mu = m - k;
+	if ((mu > 0) && (m_sparent[s] != -1))
+	{
+		std::vector<double>& U = m_U[s];
+		U.resize((size_t)mu*mu);
+		for (int b = 0; b < mu; ++b)
+		{
+			const double* Fb = &F[(size_t)(k + b)*m + k];
+			double* Ub = &U[(size_t)b*mu];
+			for (int a = b; a < mu; ++a) Ub[a] = Fb[a];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool SparseLDLTSolver::BackSolve(double* x, double* b)
+{
+	int n = m_n;
+	if (n == 0) return true;
+
+	// permute the right-hand side
+	std::vector<double> y(n);
+	for (int i = 0; i < n; ++i) y[i] = b[m_perm[i]];
+
+	// forward substitution
+	for (int s = 0; s < m_ns; ++s)
+	{
+		int f = m_sfirst[s];
+		int k = m_sfirst[s + 1] - f;
+		int m = m_srp[s + 1] - m_srp[s];
+		const int* rows = &m_srow[m_srp[s]];
+		const double* L = &m_L[m_slp[s]];
+		for (int j = 0; j < k; ++j)
+		{
+			const double* Lj = L + (size_t)j*m;
+			double yj = y[f + j];
+			if (yj != 0.0) for (int i = j + 1; i < m; ++i) y[rows[i]] -= Lj[i] * yj;
+		}
+	}
+
+	// diagonal
+	for (int i = 0; i < n; ++i) y[i] /= m_D[i];
+
+	// backward substitution
+	for (int s = m_ns - 1; s >= 0; --s)
+	{
+		int f = m_sfirst[s];
+		int k = m_sfirst[s + 1] - f;
+		int m = m_srp[s + 1] - m_srp[s];
+		const int* rows = &m_srow[m_srp[s]];
+		const double* L = &m_L[m_slp[s]];
+		for (int j = k - 1; j >= 0; --j)
+		{
+			const double* Lj = L + (size_t)j*m;
+			double sum = y[f + j];
+			for (int i = j + 1; i < m; ++i) sum -= Lj[i] * y[rows[i]];
+			y[f + j] = sum;
+		}
+	}
+
+	// undo the permutation
+	for (int i = 0; i < n; ++i) x[m_perm[i]] = y[i];
+
+	// update stats
+	UpdateStats(1);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SparseLDLTSolver::Destroy()
+{
+	m_L.clear();
+	m_D.clear();
+	m_U.clear();
+	LinearSolver::Destroy();
+}
@@ -0,0 +1,117 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include "CompactSymmMatrix.h"
+
+//-----------------------------------------------------------------------------
+//! Sparse direct solver for symmetric matrices that does not require any 
+//! external libraries. 
+
+//! The matrix is reordered with nested dissection and factored as L*D*L^T 
+//! with a supernodal multifrontal method. Independent subtrees of the elimination 
+//! tree are factored in parallel and the dense updates of the large fronts 
+//! near the root are multithreaded. Small pivots are replaced by a perturbed 
+//! value (similar to Pardiso's pivot perturbation). 
+class SparseLDLTSolver : public LinearSolver
+{
+public:
+	SparseLDLTSolver(FEModel* fem);
+	~SparseLDLTSolver();
+
+	//! create a sparse matrix that can be used with this solver
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	//! set the sparse matrix
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+	//! do the ordering and symbolic factorization
+	bool PreProcess() override;
+
+	//! numerical factorization
+	bool Factor() override;
+
+	//! solve for a right-hand side
+	bool BackSolve(double* x, double* b) override;
+
+	//! clean up
+	void Destroy() override;
+
+	void SetPrintLevel(int n) override { m_printLevel = n; }
+
+private:
+	// calculate the ordering and the supernode structure
+	bool SymbolicFactor();
+
+	// factor a supernode
+	void FactorSupernode(int s, std::vector<int>& pos);
+
+	// divide the supernode tree into subtrees that can be processed in parallel
+	void BuildSchedule(int nthreads);
+
+private:
+	CompactSymmMatrix*	m_pA;
+
+	int		m_printLevel;	//!< print level
+	double	m_pivotTol;		//!< relative pivot tolerance
+	int		m_leafSize;		//!< size of leaves in nested dissection
+
+	// matrix structure
+	int		m_n;			//!< number of equations
+	int		m_nnz;			//!< number of nonzeroes of matrix at analysis
+	unsigned long long	m_patternHash;	//!< hash of the sparsity pattern at analysis
+	bool	m_analyzed;		//!< the analysis was done since the last factorization
+	std::vector<int>	m_perm;		//!< m_perm[k] = original index of k-th equation
+	std::vector<int>	m_iperm;	//!< inverse permutation
+	std::vector<int>	m_Ap;		//!< column pointers of permuted lower triangle
+	std::vector<int>	m_Ai;		//!< row indices of permuted lower triangle
+	std::vector<int>	m_Asrc;		//!< location of each entry in the matrix' value array
+
+	// supernodes
+	int		m_ns;		//!< number of supernodes
+	std::vector<int>		m_sfirst;	//!< first column of each supernode (size m_ns + 1)
+	std::vector<int>		m_sparent;	//!< parent supernode (-1 for roots)
+	std::vector<int>		m_srp;		//!< pointers into row structure array (size m_ns + 1)
+	std::vector<int>		m_srow;		//!< row structures
+	std::vector<size_t>		m_slp;		//!< pointers into factor storage (size m_ns + 1)
+	std::vector< std::vector<int> >	m_schild;	//!< children of supernodes
+
+	// parallel schedule
+	std::vector<int>	m_task0;	//!< first supernode of each parallel subtree
+	std::vector<int>	m_task1;	//!< last supernode of each parallel subtree
+	std::vector<int>	m_top;		//!< supernodes that are processed after the subtrees
+
+	// numerical factor
+	std::vector<double>	m_L;		//!< supernode blocks of L (column major)
+	std::vector<double>	m_D;		//!< diagonal
+	std::vector< std::vector<double> >	m_U;	//!< update matrices
+	double	m_tol;					//!< absolute pivot tolerance
+	int		m_npert;				//!< number of perturbed pivots
+
+	DECLARE_FECORE_CLASS();
+};